@@ -34,18 +34,21 @@ namespace libp {
 
 #define MAX_PROCESSOR_NAME MPI_MAX_PROCESSOR_NAME
 
+class comm_t;
+
+namespace Comm {
+  /*Committed MPI_Type_contiguous of a given byte size. Types are
+    created once per size and freed in Comm::Finalize*/
+  MPI_Datatype ContiguousType(const size_t bytes);
+} //namespace Comm
+
 /*Generic data type*/
 template<typename T>
 struct mpiType {
   static MPI_Datatype getMpiType() {
-    MPI_Datatype type;
-    MPI_Type_contiguous(sizeof(T), MPI_CHAR, &type);
-    MPI_Type_commit(&type);
+    static const MPI_Datatype type = Comm::ContiguousType(sizeof(T));
     return type;
   }
-  static void freeMpiType(MPI_Datatype type) {
-    MPI_Type_free(&type);
-  }
   static constexpr bool isMpiType() { return false; }
 };
 
@@ -53,7 +56,6 @@ struct mpiType {
 #define TYPE(T, MPI_T)                               \
 template<> struct mpiType<T> {                       \
   static MPI_Datatype getMpiType() { return MPI_T; } \
-  static void freeMpiType(MPI_Datatype type) { }     \
   static constexpr bool isMpiType() { return true; } \
 }
 
@@ -64,11 +66,11 @@ TYPE(float,  MPI_FLOAT);
 TYPE(double, MPI_DOUBLE);
 #undef TYPE
 
-class comm_t;
-
 namespace Comm {
 
   using request_t = MPI_Request;
+  using win_t = MPI_Win;
+  inline static const win_t WinNull = MPI_WIN_NULL;
 
   /*Predefined ops*/
   using op_t = MPI_Op;
@@ -84,6 +86,12 @@ namespace Comm {
   void Init(int &argc, char** &argv);
   void Finalize();
 
+  /*true if LIBP_COMM_PROGRESS_THREAD is TRUE in the environment*/
+  bool ProgressThreadRequested();
+
+  /*true if MPI may be called concurrently from several threads*/
+  bool ThreadMultiple();
+
   /*handle to MPI_COMM_WORLD*/
   comm_t World();
 
@@ -107,6 +115,13 @@ class comm_t {
   /*MPI_Comm_dup and MPI_Comm_delete*/
   comm_t Dup() const;
   comm_t Split(const int color, const int key) const;
+  /*MPI_Comm_split_type with MPI_COMM_TYPE_SHARED*/
+  comm_t SplitShared(const int key) const;
+  /*MPI_Dist_graph_create_adjacent*/
+  comm_t DistGraphCreateAdjacent(const int Nsources,
+                                 const memory<int> sources,
+                                 const int Ndestinations,
+                                 const memory<int> destinations) const;
   void Free();
 
   /*Rank and size getters*/
@@ -125,7 +140,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
     MPI_Send(m.ptr(), cnt, type, dest, tag, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory recv*/
@@ -137,7 +151,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
     MPI_Recv(m.ptr(), cnt, type, source, tag, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar send*/
@@ -147,7 +160,6 @@ class comm_t {
             const int tag=0) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Send(&val, 1, type, dest, tag, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar recv*/
@@ -157,7 +169,6 @@ class comm_t {
             const int tag=0) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Recv(&val, 1, type, source, tag, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory non-blocking send*/
@@ -169,7 +180,6 @@ class comm_t {
              Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Isend(m.ptr(), count, type, dest, tag, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory non-blocking recv*/
@@ -181,7 +191,28 @@ class comm_t {
              Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Irecv(m.ptr(), count, type, source, tag, comm(), &request);
-    mpiType<T>::freeMpiType(type);
+  }
+
+  /*libp::memory persistent send*/
+  template <template<typename> class mem, typename T>
+  void SendInit(mem<T> m,
+                const int dest,
+                const int count,
+                const int tag,
+                Comm::request_t &request) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Send_init(m.ptr(), count, type, dest, tag, comm(), &request);
+  }
+
+  /*libp::memory persistent recv*/
+  template <template<typename> class mem, typename T>
+  void RecvInit(mem<T> m,
+                const int source,
+                const int count,
+                const int tag,
+                Comm::request_t &request) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Recv_init(m.ptr(), count, type, source, tag, comm(), &request);
   }
 
   /*scalar non-blocking send*/
@@ -192,7 +223,6 @@ class comm_t {
              Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Isend(&val, 1, type, dest, tag, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar non-blocking recv*/
@@ -203,7 +233,6 @@ class comm_t {
              Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Irecv(&val, 1, type, source, tag, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory broadcast*/
@@ -214,7 +243,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
     MPI_Bcast(m.ptr(), cnt, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar broadcast*/
@@ -223,7 +251,6 @@ class comm_t {
              const int root) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Bcast(&val, 1, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory reduce*/
@@ -236,7 +263,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(snd.length()) : count;
     MPI_Reduce(snd.ptr(), rcv.ptr(), cnt, type, op, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory in-place reduce*/
@@ -252,7 +278,6 @@ class comm_t {
     } else {
       MPI_Reduce(m.ptr(), nullptr, cnt, type, op, root, comm());
     }
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar reduce*/
@@ -263,7 +288,6 @@ class comm_t {
               const Comm::op_t op = Comm::Sum) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Reduce(&snd, &rcv, 1, type, op, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
   template <typename T>
   void Reduce(T& val,
@@ -283,7 +307,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(snd.length()) : count;
     MPI_Allreduce(snd.ptr(), rcv.ptr(), cnt, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory in-place allreduce*/
@@ -294,7 +317,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
     MPI_Allreduce(MPI_IN_PLACE, m.ptr(), cnt, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar allreduce*/
@@ -304,7 +326,6 @@ class comm_t {
                  const Comm::op_t op = Comm::Sum) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Allreduce(&snd, &rcv, 1, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
   template <typename T>
   void Allreduce(T& val,
@@ -323,7 +344,6 @@ class comm_t {
                   Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Iallreduce(snd.ptr(), rcv.ptr(), count, type, op, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory non-blocking in-place allreduce*/
@@ -334,7 +354,6 @@ class comm_t {
                   Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Iallreduce(MPI_IN_PLACE, m.ptr(), count, type, op, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar non-blocking allreduce*/
@@ -345,7 +364,6 @@ class comm_t {
                   Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Iallreduce(&snd, &rcv, 1, type, op, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
   /*scalar non-blocking in-place allreduce*/
   template <template<typename> class mem, typename T>
@@ -354,7 +372,6 @@ class comm_t {
                   Comm::request_t &request) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Iallreduce(MPI_IN_PLACE, &val, 1, type, op, comm(), &request);
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory scan*/
@@ -366,7 +383,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(snd.length()) : count;
     MPI_Scan(snd.ptr(), rcv.ptr(), cnt, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory in-place scan*/
@@ -377,7 +393,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     const int cnt = (count==-1) ? static_cast<int>(m.length()) : count;
     MPI_Scan(MPI_IN_PLACE, m.ptr(), cnt, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar scan*/
@@ -387,7 +402,6 @@ class comm_t {
             const Comm::op_t op = Comm::Sum) const {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Scan(&snd, &rcv, 1, type, op, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory gather*/
@@ -400,7 +414,6 @@ class comm_t {
     const int cnt = (sendCount==-1) ? static_cast<int>(snd.length()) : sendCount;
     MPI_Gather(snd.ptr(), cnt, type,
                rcv.ptr(), cnt, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory gatherv*/
@@ -415,7 +428,6 @@ class comm_t {
     MPI_Gatherv(snd.ptr(), sendcount, type,
                 rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
                 root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar gather*/
@@ -426,7 +438,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Gather(&snd,      1, type,
                rcv.ptr(), 1, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory scatter*/
@@ -439,7 +450,6 @@ class comm_t {
     const int cnt = (count==-1) ? static_cast<int>(rcv.length()) : count;
     MPI_Scatter(snd.ptr(), cnt, type,
                 rcv.ptr(), cnt, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory scatterv*/
@@ -454,7 +464,6 @@ class comm_t {
     MPI_Scatterv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
                  rcv.ptr(), recvcount, type,
                  root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar scatter*/
@@ -465,7 +474,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Scatter(snd.ptr,   1, type,
                 &rcv,      1, type, root, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory allgather*/
@@ -477,7 +485,6 @@ class comm_t {
     const int cnt = (sendCount==-1) ? static_cast<int>(snd.length()) : sendCount;
     MPI_Allgather(snd.ptr(), cnt, type,
                   rcv.ptr(), cnt, type, comm());
-    mpiType<T>::freeMpiType(type);
   }
   template <template<typename> class mem, typename T>
   void Allgather(mem<T> m,
@@ -485,7 +492,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Allgather(MPI_IN_PLACE, cnt, type,
                   m.ptr(),      cnt, type, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory allgatherv*/
@@ -499,7 +505,6 @@ class comm_t {
     MPI_Allgatherv(snd.ptr(), sendcount, type,
                    rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
                    comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*scalar allgather*/
@@ -509,7 +514,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Allgather(&snd,      1, type,
                   rcv.ptr(), 1, type, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory alltoall*/
@@ -520,7 +524,6 @@ class comm_t {
     MPI_Datatype type = mpiType<T>::getMpiType();
     MPI_Alltoall(snd.ptr(), cnt, type,
                  rcv.ptr(), cnt, type, comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   /*libp::memory alltoallv*/
@@ -535,7 +538,6 @@ class comm_t {
     MPI_Alltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
                   rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
                   comm());
-    mpiType<T>::freeMpiType(type);
   }
 
   template <template<typename> class mem, typename T>
@@ -550,13 +552,114 @@ class comm_t {
     MPI_Ialltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
                   rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
                   comm(), &request);
-    mpiType<T>::freeMpiType(type);
+  }
+
+  /*libp::memory neighborhood alltoallv*/
+  template <template<typename> class mem, typename T>
+  void NeighborAlltoallv(const mem<T> snd,
+                         const memory<int> sendCounts,
+                         const memory<int> sendOffsets,
+                               mem<T> rcv,
+                         const memory<int> recvCounts,
+                         const memory<int> recvOffsets) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Neighbor_alltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
+                           rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
+                           comm());
+  }
+
+  template <template<typename> class mem, typename T>
+  void INeighborAlltoallv(const mem<T> snd,
+                          const memory<int> sendCounts,
+                          const memory<int> sendOffsets,
+                                mem<T> rcv,
+                          const memory<int> recvCounts,
+                          const memory<int> recvOffsets,
+                          Comm::request_t &request) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Ineighbor_alltoallv(snd.ptr(), sendCounts.ptr(), sendOffsets.ptr(), type,
+                            rcv.ptr(), recvCounts.ptr(), recvOffsets.ptr(), type,
+                            comm(), &request);
+  }
+
+  /*libp::memory alltoallv from per-rank send counts. Exchanges the
+    counts, builds the offsets, and sizes rcv to hold the result*/
+  template <typename T>
+  void Alltoallv(const memory<T> snd,
+                 const memory<int> sendCounts,
+                       memory<T> &rcv) const {
+    const int Nranks = size();
+    memory<int> recvCounts(Nranks);
+    memory<int> sendOffsets(Nranks+1);
+    memory<int> recvOffsets(Nranks+1);
+
+    Alltoall(sendCounts, recvCounts);
+
+    sendOffsets[0] = 0;
+    recvOffsets[0] = 0;
+    for (int r=0;r<Nranks;r++) {
+      sendOffsets[r+1] = sendOffsets[r]+sendCounts[r];
+      recvOffsets[r+1] = recvOffsets[r]+recvCounts[r];
+    }
+
+    rcv.malloc(recvOffsets[Nranks]);
+    Alltoallv(snd, sendCounts, sendOffsets,
+              rcv, recvCounts, recvOffsets);
+  }
+
+  /*libp::memory neighborhood alltoall*/
+  template <template<typename> class mem, typename T>
+  void NeighborAlltoall(const mem<T> snd,
+                              mem<T> rcv,
+                        const int cnt=1) const {
+    MPI_Datatype type = mpiType<T>::getMpiType();
+    MPI_Neighbor_alltoall(snd.ptr(), cnt, type,
+                          rcv.ptr(), cnt, type, comm());
+  }
+
+  /*libp::memory neighborhood alltoallv from per-neighbor send counts.
+    Must be called on a comm from DistGraphCreateAdjacent*/
+  template <typename T>
+  void NeighborAlltoallv(const memory<T> snd,
+                         const memory<int> sendCounts,
+                               memory<T> &rcv) const {
+    int Nsources=0, Ndestinations=0, weighted=0;
+    MPI_Dist_graph_neighbors_count(comm(), &Nsources, &Ndestinations, &weighted);
+
+    memory<int> recvCounts(Nsources);
+    memory<int> sendOffsets(Ndestinations+1);
+    memory<int> recvOffsets(Nsources+1);
+
+    NeighborAlltoall(sendCounts, recvCounts);
+
+    sendOffsets[0] = 0;
+    for (int r=0;r<Ndestinations;r++) {
+      sendOffsets[r+1] = sendOffsets[r]+sendCounts[r];
+    }
+    recvOffsets[0] = 0;
+    for (int r=0;r<Nsources;r++) {
+      recvOffsets[r+1] = recvOffsets[r]+recvCounts[r];
+    }
+
+    rcv.malloc(recvOffsets[Nsources]);
+    NeighborAlltoallv(snd, sendCounts, sendOffsets,
+                      rcv, recvCounts, recvOffsets);
   }
 
   void Wait(Comm::request_t &request) const;
   void Waitall(const int count, memory<Comm::request_t> &requests) const;
+  bool Testall(const int count, memory<Comm::request_t> &requests) const;
+  void Startall(const int count, memory<Comm::request_t> &requests) const;
+  void RequestFree(Comm::request_t &request) const;
   void Barrier() const;
 
+  /*MPI-3 shared memory windows. Windows are allocated in a
+    passive-target epoch, synchronized with WinSync*/
+  void WinAllocateShared(const size_t Nbytes, Comm::win_t &win, void* &base) const;
+  void WinSharedQuery(Comm::win_t win, const int rank, void* &base) const;
+  void WinSync(Comm::win_t win) const;
+  void WinFree(Comm::win_t &win) const;
+
   friend comm_t Comm::World();
 };
 
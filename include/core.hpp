@@ -30,6 +30,7 @@ SOFTWARE.
 #include "utils.hpp"
 #include "memory.hpp"
 #include "comm.hpp"
+#include "kernel.hpp"
 
 namespace libp {
 
@@ -0,0 +1,159 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef LIBP_KERNEL_HPP
+#define LIBP_KERNEL_HPP
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <type_traits>
+#include <occa.hpp>
+#include "types.h"
+
+namespace libp {
+
+namespace internal {
+
+/*Launch counters shared by every kernel with the same name. Device times
+  come from stream tags placed around each launch. Tags are resolved in
+  batches, since reading a time waits for the tagged launch to finish.*/
+class kernelStats_t {
+ public:
+  std::string name;
+  occa::device device;
+
+  hlong launches=0;
+  double time=0.0;  //seconds
+  double bytes=0.0; //from the kernels' models
+  double flops=0.0;
+
+  kernelStats_t(const std::string _name, occa::device _device):
+    name(_name), device(_device) {}
+
+  void Record(const occa::streamTag &start, const occa::streamTag &end,
+              const double Nbytes, const double Nflops) {
+    launches++;
+    bytes += Nbytes;
+    flops += Nflops;
+    pending.push_back({start, end});
+    if (pending.size() >= maxPending) Flush();
+  }
+
+  /*Resolve the times of the launches still in flight*/
+  void Flush();
+
+  /*Counters of kernel 'name', created on first use*/
+  static std::shared_ptr<kernelStats_t> Get(const std::string _name, occa::device _device);
+
+  /*All counters, in name order*/
+  static std::vector<std::shared_ptr<kernelStats_t>> All();
+
+ private:
+  static constexpr size_t maxPending = 256;
+  std::vector<std::pair<occa::streamTag, occa::streamTag>> pending;
+};
+
+} //namespace internal
+
+/*Kernel handle. Launches go straight to OCCA unless the platform enabled
+  "KERNEL STATS" when the kernel was built, in which case each launch is
+  counted, timed on the device, and charged the bytes and flops of the
+  kernel's model.*/
+class kernel_t {
+ private:
+  occa::kernel kernel;
+  std::shared_ptr<internal::kernelStats_t> stats;
+
+  //model, per item
+  double itemBytes=0.0;
+  double itemFlops=0.0;
+
+  /*Work items of a launch: by convention the first argument of a
+    libParanumal kernel is the number of elements, nodes, or entries it
+    processes*/
+  template<typename T, typename... Rest>
+  static double Items(const T& first, const Rest&...) {
+    if constexpr (std::is_integral<typename std::decay<T>::type>::value) {
+      return static_cast<double>(first);
+    } else {
+      return 1.0;
+    }
+  }
+  static double Items() { return 1.0; }
+
+ public:
+  kernel_t()=default;
+  kernel_t(const occa::kernel &_kernel): kernel(_kernel) {}
+
+  bool isInitialized() const {
+    return kernel.isInitialized();
+  }
+
+  void free() {
+    kernel.free();
+    stats=nullptr;
+  }
+
+  std::string name() const {
+    return kernel.name();
+  }
+
+  /*Count, time, and model the launches of this kernel under 'name'*/
+  void enableStats(const std::string _name, occa::device device) {
+    stats = internal::kernelStats_t::Get(_name, device);
+  }
+
+  /*Launch straight to OCCA again, e.g. for throwaway tuning candidates*/
+  void disableStats() {
+    stats=nullptr;
+  }
+
+  /*Bytes moved and flops done per work item, where a launch's work items
+    are its first argument (or one, if that is not an integer)*/
+  void setModel(const double bytesPerItem, const double flopsPerItem) {
+    itemBytes = bytesPerItem;
+    itemFlops = flopsPerItem;
+  }
+
+  template<typename... Args>
+  void operator()(Args&&... args) const {
+    if (!stats) {
+      kernel(std::forward<Args>(args)...);
+      return;
+    }
+
+    const double Nitems = Items(args...);
+    occa::streamTag start = stats->device.tagStream();
+    kernel(std::forward<Args>(args)...);
+    occa::streamTag end = stats->device.tagStream();
+    stats->Record(start, end, Nitems*itemBytes, Nitems*itemFlops);
+  }
+};
+
+} //namespace libp
+
+#endif
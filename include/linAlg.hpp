@@ -34,7 +34,41 @@ namespace libp {
 
 class platform_t;
 
-//launcher for basic linear algebra OCCA kernels
+/*Handle of a global reduction started by one of linAlg_t's Async
+  routines. The device reduction has finished and the Allreduce is in
+  flight when the handle is returned, so independent work can run before
+  Wait completes it. Handles are move-only, and an unfinished reduction
+  is completed on destruction.*/
+class linAlgReduction_t {
+  friend class linAlg_t;
+
+ public:
+  linAlgReduction_t() = default;
+  linAlgReduction_t(const linAlgReduction_t&) = delete;
+  linAlgReduction_t& operator=(const linAlgReduction_t&) = delete;
+  linAlgReduction_t(linAlgReduction_t&& other);
+  linAlgReduction_t& operator=(linAlgReduction_t&& other);
+  ~linAlgReduction_t();
+
+  // global value of a single reduction
+  dfloat Wait();
+
+  // global values of a batched reduction
+  void Wait(memory<dfloat> dots);
+
+  bool isPending() const { return pending; }
+
+ private:
+  comm_t comm;
+  Comm::request_t request;
+  memory<dfloat> values;
+  bool pending=false;
+  bool norm=false; //Wait returns the square root
+};
+
+/*Launcher for basic linear algebra OCCA kernels. In Serial and OpenMP
+  modes device memory is host-resident, and the routines run as native
+  loops on the raw pointers instead of launching kernels*/
 class linAlg_t {
  public:
   linAlg_t();
@@ -119,6 +153,37 @@ class linAlg_t {
   dfloat weightedInnerProd(const dlong N, deviceMemory<dfloat> o_w, deviceMemory<dfloat> o_x,
                             deviceMemory<dfloat> o_y, comm_t comm);
 
+  /*Batched reductions. Every pair's product is computed in one pass over
+    the vectors, with one copy to the host and one Allreduce for the batch*/
+  using innerProdPair_t = std::pair<deviceMemory<dfloat>, deviceMemory<dfloat>>;
+
+  // dots[i] = pairs[i].first.pairs[i].second
+  void innerProds(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                  memory<dfloat> dots, comm_t comm);
+
+  // dots[i] = o_w.pairs[i].first.pairs[i].second
+  void weightedInnerProds(const dlong N, deviceMemory<dfloat> o_w,
+                          const std::vector<innerProdPair_t>& pairs,
+                          memory<dfloat> dots, comm_t comm);
+
+  /*Non-blocking reductions, completed by Wait on the returned handle*/
+
+  // o_x.o_y
+  linAlgReduction_t innerProdAsync(const dlong N, deviceMemory<dfloat> o_x,
+                                   deviceMemory<dfloat> o_y, comm_t comm);
+
+  // ||o_a||_2
+  linAlgReduction_t norm2Async(const dlong N, deviceMemory<dfloat> o_a, comm_t comm);
+
+  // o_w.o_x.o_y
+  linAlgReduction_t weightedInnerProdAsync(const dlong N, deviceMemory<dfloat> o_w,
+                                           deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
+                                           comm_t comm);
+
+  // pairs[i].first.pairs[i].second
+  linAlgReduction_t innerProdsAsync(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                                    comm_t comm);
+
   static void matrixRightSolve(const int NrowsA, const int NcolsA, const memory<double> A,
                                const int NrowsB, const int NcolsB, const memory<double> B,
                                memory<double> C);
@@ -176,12 +241,36 @@ class linAlg_t {
   platform_t *platform;
   properties_t kernelInfo;
 
+  //run on the host, threaded in OpenMP mode
+  bool hostMode=false;
+  bool hostThreads=false;
+
   static constexpr int blocksize = 256;
 
   //scratch space for reductions
   deviceMemory<dfloat> o_scratch;
   pinnedMemory<dfloat> h_scratch;
 
+  //pairs reduced per pass of the batched kernels
+  static constexpr int maxProds = 4;
+
+  //scratch space for batched reductions, grown on demand
+  deviceMemory<dfloat> o_dots;
+  pinnedMemory<dfloat> h_dots;
+
+  void ReserveDots(const int Ndots);
+  void LaunchInnerProds(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                        const int Nblock);
+  void ReduceDots(const int Ndots, const int Nblock,
+                  memory<dfloat> dots, comm_t comm);
+
+  linAlgReduction_t StartReduction(deviceMemory<dfloat> o_result, const int Nvalues,
+                                   const bool norm, comm_t comm);
+  linAlgReduction_t StartReduction(memory<dfloat> values, const bool norm, comm_t comm);
+
+  void HostInnerProds(const dlong N, const dfloat* w,
+                      const std::vector<innerProdPair_t>& pairs, dfloat* dots);
+
   kernel_t setKernel;
   kernel_t addKernel;
   kernel_t scaleKernel;
@@ -207,6 +296,9 @@ class linAlg_t {
   kernel_t innerProdKernel2;
   kernel_t weightedInnerProdKernel1;
   kernel_t weightedInnerProdKernel2;
+  kernel_t innerProdsKernel1[maxProds];
+  kernel_t weightedInnerProdsKernel1[maxProds];
+  kernel_t innerProdsKernel2;
 };
 
 } //namespace libp
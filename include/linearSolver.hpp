@@ -126,7 +126,7 @@ private:
 
   int restart;
 
-  memory<dfloat> H, sn, cs, s, y;
+  memory<dfloat> H, sn, cs, s, y, h;
 
   void UpdateGMRES(deviceMemory<dfloat>& o_x, const int I);
 
@@ -213,6 +213,73 @@ public:
             const dfloat tol, const int MAXIT, const int verbose);
 };
 
+//Pipelined Preconditioned Conjugate Gradient (Ghysels-Vanroose)
+class pipepcg: public linearSolverBase_t {
+private:
+  deviceMemory<dfloat> o_u, o_w, o_m, o_n, o_z, o_q, o_s, o_p, o_b;
+
+  pinnedMemory<dfloat> dots;
+  deviceMemory<dfloat> o_dots;
+
+  int replacement; //iterations between residual replacements, 0 for none
+
+  kernel_t updatePIPEPCGKernel;
+
+  Comm::request_t request;
+
+  void UpdatePIPEPCG(const dfloat alpha, const dfloat beta,
+                     deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r);
+  void ReplaceResidual(operator_t& linearOperator, operator_t& precon,
+                       deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r);
+
+public:
+  pipepcg(dlong _N, dlong _Nhalo,
+       platform_t& _platform, settings_t& _settings, comm_t _comm);
+
+  int Solve(operator_t& linearOperator, operator_t& precon,
+            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
+//Communication-Avoiding (s-step) Preconditioned Conjugate Gradient
+class sstepcg: public linearSolverBase_t {
+private:
+  int s;         //CG iterations per outer step
+  int Ncols;     //basis size, 2s+1
+  bool chebyshev;
+
+  //Krylov basis Y = [p, B*p, .., B^s*p, z, B*z, .., B^{s-1}*z] with
+  // B = M*A, and W = A*Y. Columns are stored Ntotal apart
+  deviceMemory<dfloat> o_Y, o_W;
+  deviceMemory<dfloat> o_Ax, o_t;
+
+  memory<dfloat> coeffs;
+  deviceMemory<dfloat> o_coeffs;
+
+  dfloat lambdaMax=0; //estimate of the largest eigenvalue of M*A
+
+  //basis recurrence B*y_i = gamma_i*y_{i+1} + alpha_i*y_i + beta_i*y_{i-1}
+  memory<dfloat> basisAlpha, basisBeta, basisGamma;
+
+  //Gram matrix Y^T*W, Y^T*r, change of basis T with B*Y = Y*T, and the
+  // coordinates of x, z and p in Y
+  memory<dfloat> G, g, T, a, c, d, Gv, Td;
+
+  kernel_t updateSSTEPCGKernel;
+
+  void EstimateSpectrum(operator_t& linearOperator, operator_t& precon);
+  void SetupBasis();
+  void BuildBasis(operator_t& linearOperator, operator_t& precon);
+
+public:
+  sstepcg(dlong _N, dlong _Nhalo,
+       platform_t& _platform, settings_t& _settings, comm_t _comm);
+
+  int Solve(operator_t& linearOperator, operator_t& precon,
+            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_rhs,
+            const dfloat tol, const int MAXIT, const int verbose);
+};
+
 } //namespace LinearSolver
 
 } //namespace libp
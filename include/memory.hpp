@@ -27,10 +27,23 @@ SOFTWARE.
 #ifndef LIBP_MEMORY_HPP
 #define LIBP_MEMORY_HPP
 
+#include <new>
 #include "utils.hpp"
 
 namespace libp {
 
+namespace Memory {
+  /*Host allocations are aligned to this many bytes*/
+  constexpr std::size_t alignment = 64;
+
+  /*Placement policies for host allocations*/
+  enum Policy {
+    Default,            /*pages are placed by whichever thread writes them first*/
+    ParallelFirstTouch  /*entries are value-initialized in a static OpenMP loop,
+                          placing pages near the threads which sweep them*/
+  };
+} //namespace Memory
+
 template<typename T>
 class memory {
   template <typename U> friend class memory;
@@ -43,22 +56,46 @@ class memory {
   size_t lngth;
   size_t offset;
 
+  /*Aligned allocation of lngth_ entries*/
+  static std::shared_ptr<T[]> allocate(const size_t lngth_,
+                                       const Memory::Policy policy) {
+    constexpr std::align_val_t align{std::max(Memory::alignment, alignof(T))};
+
+    T* p = static_cast<T*>(::operator new[](lngth_*sizeof(T), align));
+
+    if (policy==Memory::ParallelFirstTouch) {
+      #pragma omp parallel for schedule(static)
+      for (size_t i=0;i<lngth_;++i) {
+        new (p+i) T();
+      }
+    } else {
+      std::uninitialized_default_construct_n(p, lngth_);
+    }
+
+    return std::shared_ptr<T[]>(p, [lngth_, align](T* q) {
+                                  std::destroy_n(q, lngth_);
+                                  ::operator delete[](q, align);
+                                });
+  }
+
  public:
   memory() :
     lngth{0},
     offset{0} {}
 
-  memory(const size_t lngth_) :
-    shrdPtr(new T[lngth_]),
+  memory(const size_t lngth_,
+         const Memory::Policy policy=Memory::Default) :
+    shrdPtr(allocate(lngth_, policy)),
     lngth{lngth_},
     offset{0} {}
 
+  /*The fill is a static OpenMP loop, so it also places pages in parallel*/
   memory(const size_t lngth_,
          const T val) :
-    shrdPtr(new T[lngth_]),
+    shrdPtr(allocate(lngth_, Memory::Default)),
     lngth{lngth_},
     offset{0} {
-    #pragma omp parallel for
+    #pragma omp parallel for schedule(static)
     for (size_t i=0;i<lngth;++i) {
       shrdPtr[i] = val;
     }
@@ -86,8 +123,9 @@ class memory {
   memory& operator = (const memory<T> &m)=default;
   ~memory()=default;
 
-  void malloc(const size_t lngth_) {
-    *this = memory<T>(lngth_);
+  void malloc(const size_t lngth_,
+              const Memory::Policy policy=Memory::Default) {
+    *this = memory<T>(lngth_, policy);
   }
 
   void malloc(const size_t lngth_, const T val) {
@@ -284,9 +322,20 @@ extern template class memory<long long int>;
 extern template class memory<float>;
 extern template class memory<double>;
 
-/*libp::deviceMemory is a wrapper around occa::memory*/
+namespace internal {
+  class memoryBlock_t;
+}
+
+/*libp::deviceMemory is a wrapper around occa::memory. Memory handed out by
+  a platform memory pool also holds a reference to its pool block, which
+  returns to the pool once the last deviceMemory referencing it is gone*/
 template<typename T>
 class deviceMemory: public occa::memory {
+  template <typename U> friend class deviceMemory;
+
+ private:
+  std::shared_ptr<internal::memoryBlock_t> block;
+
  public:
   deviceMemory() = default;
   deviceMemory(const deviceMemory<T> &m)=default;
@@ -302,10 +351,18 @@ class deviceMemory: public occa::memory {
     }
   }
 
+  /*Memory from a pool block*/
+  deviceMemory(occa::memory m, std::shared_ptr<internal::memoryBlock_t> _block):
+    deviceMemory(m)
+  {
+    block = _block;
+  }
+
   /*Conversion constructor*/
   template<typename U>
   deviceMemory(const deviceMemory<U> &m):
-    occa::memory(m)
+    occa::memory(m),
+    block(m.block)
   {
     if (isInitialized()) {
       if (occa::dtype::get<T>() == occa::dtype::none) {
@@ -336,16 +393,30 @@ class deviceMemory: public occa::memory {
 
   deviceMemory<T> operator + (const ptrdiff_t offset) const {
     if (isInitialized())
-      return deviceMemory<T>(occa::memory::operator+(offset));
+      return deviceMemory<T>(occa::memory::operator+(offset), block);
     else
       return deviceMemory<T>();
   }
 
   deviceMemory<T>& operator += (const ptrdiff_t offset) {
-    *this = deviceMemory<T>(occa::memory::slice(offset));
+    *this = deviceMemory<T>(occa::memory::slice(offset), block);
     return *this;
   }
 
+  /*Pool blocks are released by dropping this reference, the pool keeps
+    the allocation for reuse*/
+  void free() {
+    if (block) {
+      *this = deviceMemory<T>();
+    } else {
+      occa::memory::free();
+    }
+  }
+
+  bool isPooled() const {
+    return block!=nullptr;
+  }
+
   /*Copy from libp::memory*/
   void copyFrom(const libp::memory<T> src,
                 const ptrdiff_t count = -1,
@@ -481,6 +552,11 @@ extern template class deviceMemory<double>;
   but is allocated slightly differently*/
 template<typename T>
 class pinnedMemory: public occa::memory {
+  template <typename U> friend class pinnedMemory;
+
+ private:
+  std::shared_ptr<internal::memoryBlock_t> block;
+
  public:
   pinnedMemory() = default;
   pinnedMemory(const pinnedMemory<T> &m)=default;
@@ -496,10 +572,18 @@ class pinnedMemory: public occa::memory {
     }
   };
 
+  /*Memory from a pool block*/
+  pinnedMemory(occa::memory m, std::shared_ptr<internal::memoryBlock_t> _block):
+    pinnedMemory(m)
+  {
+    block = _block;
+  }
+
   /*Conversion constructor*/
   template<typename U>
   pinnedMemory(const pinnedMemory<U> &m):
-    occa::memory(m)
+    occa::memory(m),
+    block(m.block)
   {
     if (isInitialized()) {
       if (occa::dtype::get<T>() == occa::dtype::none) {
@@ -530,16 +614,30 @@ class pinnedMemory: public occa::memory {
 
   pinnedMemory<T> operator + (const ptrdiff_t offset) const {
     if (isInitialized())
-      return pinnedMemory<T>(occa::memory::operator+(offset));
+      return pinnedMemory<T>(occa::memory::operator+(offset), block);
     else
       return pinnedMemory<T>();
   }
 
   pinnedMemory<T>& operator += (const ptrdiff_t offset) {
-    *this = pinnedMemory<T>(occa::memory::slice(offset));
+    *this = pinnedMemory<T>(occa::memory::slice(offset), block);
     return *this;
   }
 
+  /*Pool blocks are released by dropping this reference, the pool keeps
+    the allocation for reuse*/
+  void free() {
+    if (block) {
+      *this = pinnedMemory<T>();
+    } else {
+      occa::memory::free();
+    }
+  }
+
+  bool isPooled() const {
+    return block!=nullptr;
+  }
+
   /*Copy from raw pointer*/
   void copyFrom(const T* src,
                 const ptrdiff_t count = -1,
@@ -0,0 +1,107 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef LIBP_MEMORYPOOL_HPP
+#define LIBP_MEMORYPOOL_HPP
+
+#include <map>
+#include <vector>
+#include <mutex>
+#include "core.hpp"
+
+namespace libp {
+
+class memoryPool_t;
+
+namespace internal {
+
+/*A block of pooled memory. Every deviceMemory/pinnedMemory handed out for
+  this block holds a reference to it, and the block returns its allocation
+  to the pool when the last reference is dropped.*/
+class memoryBlock_t {
+ public:
+  std::weak_ptr<memoryPool_t> pool;
+  occa::memory mem;
+  size_t Nbytes;
+
+  memoryBlock_t(std::weak_ptr<memoryPool_t> _pool,
+                occa::memory _mem, const size_t _Nbytes):
+    pool(_pool), mem(_mem), Nbytes(_Nbytes) {}
+
+  ~memoryBlock_t();
+};
+
+} //namespace internal
+
+/*Pooling allocator for device or pinned host memory. Requests are rounded
+  up to size classes, four per power of two, and freed blocks are kept in
+  per-class bins for reuse instead of being returned to the device.*/
+class memoryPool_t: public std::enable_shared_from_this<memoryPool_t> {
+ private:
+  device_t device;
+  properties_t props;
+
+  std::mutex mtx;
+  std::map<size_t, std::vector<occa::memory>> freeBlocks;
+
+  hlong Nrequests=0;
+  hlong Nreused=0;
+  hlong Nallocs=0;
+  size_t bytesInUse=0;
+  size_t bytesReserved=0;
+  size_t maxBytesInUse=0;
+  size_t maxBytesReserved=0;
+
+  friend class internal::memoryBlock_t;
+  void Release(occa::memory mem, const size_t Nbytes);
+
+ public:
+  static constexpr size_t minBlockSize = 256;
+
+  memoryPool_t(device_t _device, properties_t _props):
+    device(_device), props(_props) {}
+
+  static size_t SizeClass(const size_t Nbytes);
+
+  /*Reserve a block of at least Nbytes. Returns a view of exactly Nbytes
+    and the block it belongs to.*/
+  occa::memory Reserve(const size_t Nbytes,
+                       std::shared_ptr<internal::memoryBlock_t> &block);
+
+  /*Return all free blocks to the device*/
+  void Trim();
+
+  size_t BytesInUse() const { return bytesInUse; }
+  size_t BytesReserved() const { return bytesReserved; }
+  size_t MaxBytesInUse() const { return maxBytesInUse; }
+  size_t MaxBytesReserved() const { return maxBytesReserved; }
+
+  void Report(comm_t comm, const std::string name);
+};
+
+} //namespace libp
+
+#endif
@@ -304,8 +304,10 @@ class mesh_t {
   // setup trace halo
   void HaloRingSetup();
 
-  // setup trace halo
-  ogs::halo_t HaloTraceSetup(int Nfields);
+  // setup trace halo. When the k values to be exchanged are given,
+  //  the exchange method is autotuned for them
+  ogs::halo_t HaloTraceSetup(int Nfields,
+                             const std::vector<int> autoTuneSizes={});
 
   //Setup PML elements
   void PmlSetup();
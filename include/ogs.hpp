@@ -139,6 +139,22 @@ SOFTWARE.
   calling GatherScatterFinish. The MPI communication will then take place while the
   user's local kernels execute to maximize the amount of communication hiding.
 
+  Most MPI libraries only advance messages from inside MPI calls. Enabling a
+  progress thread, e.g.,
+
+    ogs.SetProgressThread(true);
+
+  (or setting "COMM PROGRESS THREAD" to TRUE in the platform settings) starts
+  host-staged exchanges in GatherScatterStart and polls them from a helper
+  thread, shared by all handles, until GatherScatterFinish. This needs
+  MPI_THREAD_MULTIPLE, which Comm::Init only requests when the environment
+  sets LIBP_COMM_PROGRESS_THREAD=TRUE (this also turns the setting on).
+  Alternatively, the caller can poll with
+
+    ogs.Progress();
+
+  between their own kernels.
+
   Finally, a specialized communcation object, named halo_t is provided. This
   object is analogous to an ogs_t object, where each group S_j has a sole
   "unflagged" (p,i) pair, as discussed above regarding the 'unique' parameter,
@@ -163,6 +179,41 @@ SOFTWARE.
   which has the effect of summing the entries in S_j and writing the result to
   the sole "unflagged" pair in S_j.
 
+  The MPI payloads of double precision exchanges can be sent in single
+  precision, e.g.,
+
+    halo.SetPrecision(ogs::Single);
+
+  which roughly halves the message volume. With ogs::SingleCompensated the
+  local contribution to each received entry is restored to full precision,
+  so only the remote contributions are rounded (for ogs::Add, Max and Min).
+
+  With ogs::Auto, Setup benchmarks the available exchange methods and keeps
+  the fastest. By default only k=1 is timed. The k values a handle will use
+  can be declared before Setup, e.g.,
+
+    halo.SetAutoTuneSizes({1, mesh.Np});
+    halo.Setup(N, ids, comm, ogs::Auto, verbose);
+
+  in which case a method is chosen for each k, and each exchange is routed to
+  the method tuned for the largest declared payload not exceeding its own.
+  With "OGS TUNING DATABASE" set to TRUE, the selections are recorded in
+  <cache dir>/ogs/tuning, keyed on the host, comm size and halo shape, so
+  later setups of the same halo skip the benchmark.
+
+  Setting "OGS STATS" to TRUE in the platform settings gives each handle set
+  up afterwards a set of communication counters: calls per operation, bytes
+  sent to and received from each neighbour, and the time spent packing,
+  waiting on MPI, unpacking and staging through the host. These are read
+  with ogs.GetStats(), summarized across ranks (min/avg/max) with
+
+    ogs.ReportStats("name");
+
+  or for all handles at once with ogs::ReportStats(comm), which
+  platform.Report() also calls. Timing the phases
+  synchronizes the device, so the counters are meant for profiling runs.
+  Without the setting each operation only pays a null pointer check.
+
 */
 
 #ifndef OGS_HPP
@@ -194,11 +245,14 @@ typedef enum { Add, Mul, Max, Min} Op;
 typedef enum { Sym, NoTrans, Trans } Transpose;
 
 /* method switch */
-typedef enum { Auto, Pairwise, CrystalRouter, AllToAll} Method;
+typedef enum { Auto, Pairwise, CrystalRouter, AllToAll, Persistent, Neighborhood, Hierarchical} Method;
 
 /* kind enum */
 typedef enum { Unsigned, Signed, Halo} Kind;
 
+/* halo payload precision switch */
+typedef enum { Full, Single, SingleCompensated} Precision;
+
 } //namespace ogs
 
 } //namespace libp
@@ -212,6 +266,9 @@ namespace ogs {
 //pre-build kernels
 void InitializeKernels(platform_t& platform, const Type type, const Op op);
 
+//report the communication counters of every live handle (collective)
+void ReportStats(comm_t comm);
+
 // OCCA Gather Scatter
 class ogs_t : public ogsBase_t {
 public:
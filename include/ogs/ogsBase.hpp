@@ -37,9 +37,17 @@ namespace ogs {
 class ogsOperator_t;
 class ogsFusedOperator_t;
 class ogsExchange_t;
+class ogsStats_t;
 
 struct parallelNode_t;
 
+//exchange method selected by Auto for one payload size
+struct tuningEntry_t {
+  size_t Nbytes;   //bytes per halo entry
+  Method method;
+  bool gpu_aware;
+};
+
 class halo_t;
 
 class ogsBase_t {
@@ -76,10 +84,31 @@ public:
                       platform_t& _platform);
   void Free();
 
+  //select the precision of double halo payloads
+  void SetPrecision(const Precision precision);
+
+  //progress outstanding MPI messages between Start and Finish, either
+  // from a helper thread or by polling from the caller
+  void SetProgressThread(const bool enable);
+  void Progress();
+
+  //declare the k values the caller will exchange, so ogs::Auto can
+  // select an exchange method for each message size (call before Setup)
+  void SetAutoTuneSizes(const std::vector<int> k);
+
+  //communication counters, present when "OGS STATS" is TRUE at Setup
+  std::shared_ptr<const ogsStats_t> GetStats() const { return stats; }
+  void ResetStats();
+  void ReportStats(const std::string name) const;
+
 protected:
   std::shared_ptr<ogsOperator_t> gatherLocal;
   std::shared_ptr<ogsOperator_t> gatherHalo;
+  std::shared_ptr<ogsFusedOperator_t> gatherFused;
   std::shared_ptr<ogsExchange_t> exchange;
+  std::shared_ptr<ogsStats_t> stats;
+
+  std::vector<int> autoTuneSizes{1};
 
   void AssertGatherDefined();
 
@@ -102,7 +131,47 @@ private:
                            ogsOperator_t& gatherHalo,
                            comm_t _comm,
                            platform_t &_platform,
-                           const int verbose);
+                           const int verbose,
+                           Method &method);
+
+  ogsExchange_t* AutoBenchmark(dlong Nshared,
+                               memory<parallelNode_t> &sharedNodes,
+                               ogsOperator_t& gatherHalo,
+                               const int k,
+                               const int verbose,
+                               Method &method);
+
+  //persistent record of the methods Auto selected, keyed on the machine,
+  // comm size and the shape of the halo
+  std::string TuningDatabaseFile(dlong Nshared,
+                                 memory<parallelNode_t> &sharedNodes);
+
+  void LoadTuningDatabase(const std::string fileName,
+                          std::vector<tuningEntry_t> &entries);
+
+  void SaveTuningDatabase(const std::string fileName,
+                          const std::vector<tuningEntry_t> &entries);
+
+  //on-disk cache of the setup plan, keyed on the ids and comm size
+  std::string SetupCacheFile(const dlong Nids,
+                             memory<hlong> ids,
+                             const Method method);
+
+  bool LoadSetupCache(const std::string fileName,
+                      const dlong Nids,
+                      memory<parallelNode_t> &nodes,
+                      dlong &Nshared,
+                      memory<parallelNode_t> &sharedNodes,
+                      Method &method,
+                      double &setupTime);
+
+  void SaveSetupCache(const std::string fileName,
+                      const dlong Nids,
+                      memory<parallelNode_t> &nodes,
+                      const dlong Nshared,
+                      memory<parallelNode_t> &sharedNodes,
+                      const Method method,
+                      const double setupTime);
 };
 
 } //namespace ogs
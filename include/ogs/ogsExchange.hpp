@@ -27,6 +27,10 @@ SOFTWARE.
 #ifndef OGS_EXCHANGE_HPP
 #define OGS_EXCHANGE_HPP
 
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "ogs.hpp"
 #include "ogs/ogsOperator.hpp"
 
@@ -63,7 +67,11 @@ public:
     rank = comm.rank();
     size = comm.size();
   }
-  virtual ~ogsExchange_t() {}
+  virtual ~ogsExchange_t();
+
+  //the progress thread keeps a pointer to the exchange
+  ogsExchange_t(const ogsExchange_t&)=delete;
+  ogsExchange_t& operator=(const ogsExchange_t&)=delete;
 
   virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans)=0;
   virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans)=0;
@@ -85,7 +93,36 @@ public:
 
   virtual void AllocBuffer(size_t Nbytes)=0;
 
+  //drive the MPI requests posted by Start from the progress thread
+  virtual void SetProgressThread(const bool enable);
+  virtual bool ProgressThreadActive() const { return progressEnabled; }
+
+  //poll the MPI requests posted by Start once
+  virtual void Progress();
+
   friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
+
+protected:
+  //register the requests posted by Start, and release them before Finish waits
+  void ProgressStart(const int count, memory<Comm::request_t> &requests);
+  void ProgressStop();
+
+private:
+  //this exchange's requests, guarded by progressMutex while enabled
+  bool progressEnabled=false;
+  bool progressPolling=false;
+  int NprogressRequests=0;
+  memory<Comm::request_t> progressRequests;
+
+  //a single progress thread polls every exchange which enables it
+  static std::vector<ogsExchange_t*> progressExchanges;
+  static std::thread progressThread;
+  static std::mutex progressMutex;
+  static std::condition_variable progressCond;
+  static bool progressExit;
+  static int NprogressPolling;
+
+  static void ProgressLoop();
 };
 
 //MPI communcation via single MPI_Alltoallv call
@@ -112,7 +149,7 @@ private:
   memory<int> sendOffsets;
   memory<int> recvOffsets;
 
-  Comm::request_t request;
+  memory<Comm::request_t> request;
 
 public:
   ogsAllToAll_t(dlong Nshared,
@@ -170,7 +207,7 @@ public:
 
 //MPI communcation via pairwise send/recvs
 class ogsPairwise_t: public ogsExchange_t {
-private:
+protected:
 
   dlong NsendN=0, NsendT=0;
   memory<dlong> sendIdsN, sendIdsT;
@@ -247,6 +284,245 @@ public:
   virtual void AllocBuffer(size_t Nbytes);
 };
 
+//MPI communcation via persistent pairwise send/recvs
+class ogsPersistent_t: public ogsPairwise_t {
+private:
+
+  //persistent requests are bound to the buffers, message
+  // sizes, and direction they were initialized with
+  struct persistentRequests_t {
+    Transpose trans;
+    size_t Nbytes;
+    bool device;
+    const void *recvBuf=nullptr;
+    const void *sendBuf=nullptr;
+    memory<Comm::request_t> requests;
+  };
+
+  std::vector<persistentRequests_t> persistent;
+  size_t active=0;
+
+  template<template<typename> class mem>
+  persistentRequests_t& GetRequests(mem<char> buf,
+                                    mem<char> sendBuf,
+                                    const size_t Nbytes,
+                                    const Transpose trans);
+
+  void FreeRequests(persistentRequests_t &p);
+
+public:
+  ogsPersistent_t(dlong Nshared,
+                  memory<parallelNode_t> &sharedNodes,
+                  ogsOperator_t &gatherHalo,
+                  stream_t _dataStream,
+                  comm_t _comm,
+                  platform_t &_platform);
+
+  ~ogsPersistent_t();
+
+  template<typename T>
+  void Start(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  template<typename T>
+  void Start(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+};
+
+//MPI communcation via neighborhood collective on a graph topology
+class ogsNeighborhood_t: public ogsPairwise_t {
+private:
+
+  comm_t graphComm;
+
+  //per-neighbor counts and offsets, in the order of the graph's
+  // sources and destinations
+  memory<int> nbrSendCountsN;
+  memory<int> nbrRecvCountsN;
+  memory<int> nbrSendOffsetsN;
+  memory<int> nbrRecvOffsetsN;
+
+  memory<int> sendCounts;
+  memory<int> recvCounts;
+  memory<int> sendOffsets;
+  memory<int> recvOffsets;
+
+  memory<Comm::request_t> request;
+
+  void SetCounts(const int k, const Transpose trans);
+
+public:
+  ogsNeighborhood_t(dlong Nshared,
+                    memory<parallelNode_t> &sharedNodes,
+                    ogsOperator_t &gatherHalo,
+                    stream_t _dataStream,
+                    comm_t _comm,
+                    platform_t &_platform);
+
+  template<typename T>
+  void Start(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  template<typename T>
+  void Start(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+};
+
+//Node-aware exchange. Contributions from ranks on the same node are
+// combined in a shared memory window and node leaders exchange a
+// single aggregated message per pair of nodes
+class ogsHierarchical_t: public ogsExchange_t {
+private:
+
+  comm_t nodeComm;
+  int nodeRank=0, nodeSize=1;
+
+  //shared memory window, laid out in words of windowBytes bytes
+  Comm::win_t window=Comm::WinNull;
+  void *windowBase=nullptr;
+  size_t windowBytes=0;
+  dlong segOffset=0, segWords=0;
+
+  //leader's aggregated exchange with other nodes
+  int NnbrNodes=0;
+  memory<int> nbrNodes;
+  memory<int> nbrCounts;
+  memory<int> nbrOffsets;
+  dlong Nslots=0;
+  dlong recvOffset=0;
+  memory<dlong> sendStartsN, sendStartsT;
+  memory<dlong> sendIdsN, sendIdsT;
+  memory<Comm::request_t> requests;
+
+  //gather of the final halo values from the window
+  memory<dlong> rowStartsN, rowStartsT;
+  memory<dlong> colIdsN, colIdsT;
+
+  void NodeSync();
+
+public:
+  ogsHierarchical_t(dlong Nshared,
+                    memory<parallelNode_t> &sharedNodes,
+                    ogsOperator_t &gatherHalo,
+                    stream_t _dataStream,
+                    comm_t _comm,
+                    platform_t &_platform);
+
+  ~ogsHierarchical_t();
+
+  template<typename T>
+  void Start(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(pinnedMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  template<typename T>
+  void Start(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  template<typename T>
+  void Finish(deviceMemory<T> &buf,
+                const int k,
+                const Op op,
+                const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void AllocBuffer(size_t Nbytes);
+};
+
 //MPI communcation via Crystal Router
 class ogsCrystalRouter_t: public ogsExchange_t {
 private:
@@ -329,6 +605,102 @@ public:
   virtual void AllocBuffer(size_t Nbytes);
 };
 
+
+//Wraps another exchange and sends double payloads in single precision.
+// Halo values are narrowed to float in the workspace before the wrapped
+// exchange starts and widened again when it finishes. With compensation,
+// entries to which this rank contributed have the rounding error of the
+// local contribution restored after the exchange (for Add, Max and Min).
+class ogsReducedPrecision_t: public ogsExchange_t {
+public:
+  std::shared_ptr<ogsExchange_t> base;
+  bool compensate=false;
+
+private:
+  pinnedMemory<char> h_ownspace, h_recvspace;
+  deviceMemory<char> o_ownspace, o_recvspace;
+
+  static kernel_t packKernel;
+  static kernel_t unpackKernel;
+
+public:
+  ogsReducedPrecision_t(std::shared_ptr<ogsExchange_t> _base,
+                        const bool _compensate);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void AllocBuffer(size_t Nbytes);
+
+  virtual void SetProgressThread(const bool enable);
+  virtual bool ProgressThreadActive() const;
+  virtual void Progress();
+
+private:
+  void SyncBuffers();
+
+  friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
+};
+
+//Holds one exchange per tuned payload size and routes each exchange to
+// the one tuned for the largest size not exceeding its payload. Callers
+// size the buffer with AllocBuffer before every Start, which is where
+// the selection is made.
+class ogsSizeDispatch_t: public ogsExchange_t {
+public:
+  std::vector<size_t> sizes; //bytes per halo entry, ascending
+  std::vector<std::shared_ptr<ogsExchange_t>> exchanges;
+
+private:
+  std::shared_ptr<ogsExchange_t> selected;
+
+public:
+  ogsSizeDispatch_t(std::vector<size_t> &_sizes,
+                    std::vector<std::shared_ptr<ogsExchange_t>> &_exchanges);
+
+  virtual void Start(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(pinnedMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void Start(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Start(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<float> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<double> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<int> &buf,const int k,const Op op,const Transpose trans);
+  virtual void Finish(deviceMemory<long long int> &buf,const int k,const Op op,const Transpose trans);
+
+  virtual void AllocBuffer(size_t Nbytes);
+
+  virtual void SetProgressThread(const bool enable);
+  virtual bool ProgressThreadActive() const;
+  virtual void Progress();
+
+private:
+  void SyncBuffers();
+};
+
 } //namespace ogs
 
 } //namespace libp
@@ -118,19 +118,141 @@ private:
   void GatherScatter(U<T> v, const int K,
                      const Transpose trans);
 
-  //NC: Hard code these for now. Should be sufficient for GPU devices, but needs attention for CPU
+  //NC: Hard code these for now. Should be sufficient for GPU devices
   static constexpr int blockSize = 256;
   static constexpr int gatherNodesPerBlock = 512; //should be a multiple of blockSize for good unrolling
 
+  //Host row blocks. Each block holds roughly hostGatherNodesPerBlock
+  // nonzeros so that its ids and gathered values stay resident in L1/L2,
+  // and blocks are always handed to threads with the same static schedule
+  // so each thread works on (and first-touches) the same rows every call.
+  static constexpr int hostGatherNodesPerBlock = 2048;
+  static constexpr int simdWidth = 8; //k-chunk width for K>1 host gathers
+
+  dlong NrowBlocksHost=0;
+  memory<dlong> blockRowStartsHost;
+
+  void setupHostRowBlocks();
+
   //4 types - Float, Double, Int32, Int64
   //4 ops - Add, Mul, Max, Min
   static kernel_t gatherScatterKernel[4][4];
   static kernel_t gatherKernel[4][4];
   static kernel_t scatterKernel[4];
 
+  friend class ogsFusedOperator_t;
+  friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
+  friend void setupHostRowBlocks(const dlong Nrows,
+                                 const memory<dlong> rowStarts,
+                                 dlong &NrowBlocks,
+                                 memory<dlong> &blockRowStarts);
+};
+
+// The fused operator concatenates the local and halo Z operators
+// into a single set of rows, [local rows | halo rows]. Local rows
+// are gathered from (and scattered back to) the vector as usual,
+// while halo rows take their value from the exchanged halo buffer.
+// The row blocks never straddle the local/halo boundary, so the
+// local rows can be applied while the halo exchange is in flight
+// and the halo rows once the exchanged buffer has arrived.
+class ogsFusedOperator_t {
+public:
+  platform_t platform;
+
+  //row ranges of the fused operator
+  enum Rows {LocalRows, HaloRows};
+
+  dlong NlocalRows=0; //number of local rows (all local rows come first)
+  dlong NhaloRows=0;  //number of halo rows
+  dlong NhaloRowsP=0; //number of positive halo rows
+  dlong Nrows=0;
+
+  memory<dlong> rowStartsN;
+  memory<dlong> rowStartsT;
+  memory<dlong> colIdsN;
+  memory<dlong> colIdsT;
+
+  deviceMemory<dlong> o_rowStartsN;
+  deviceMemory<dlong> o_rowStartsT;
+  deviceMemory<dlong> o_colIdsN;
+  deviceMemory<dlong> o_colIdsT;
+
+  dlong NrowBlocks=0;
+  dlong NlocalRowBlocks=0; //leading row blocks holding only local rows
+  memory<dlong> blockRowStarts;
+  deviceMemory<dlong> o_blockRowStarts;
+
+  dlong NrowBlocksHost=0;
+  dlong NlocalRowBlocksHost=0;
+  memory<dlong> blockRowStartsHost;
+
+  ogsFusedOperator_t()=default;
+  ogsFusedOperator_t(platform_t& _platform,
+                     const ogsOperator_t& gatherLocal,
+                     const ogsOperator_t& gatherHalo);
+
+  void Free();
+
+  //Apply local Z^T*Z operator (LocalRows) or scatter the exchanged
+  // halo buffer (HaloRows)
+  template<template<typename> class U,
+           template<typename> class V,
+           typename T>
+  void GatherScatter(U<T> v, const V<T> haloBuf,
+                     const int k, const Op op, const Transpose trans,
+                     const Rows rows);
+
+  template<typename T>
+  void GatherScatter(deviceMemory<T> o_v, const deviceMemory<T> o_haloBuf,
+                     const int k, const Op op, const Transpose trans,
+                     const Rows rows);
+
+  //Apply local Z^T operator (LocalRows) or append the exchanged
+  // halo buffer (HaloRows)
+  template<template<typename> class U,
+           template<typename> class V,
+           typename T>
+  void Gather(U<T> gv, const U<T> v, const V<T> haloBuf,
+              const int k, const Op op, const Transpose trans,
+              const Rows rows);
+
+  template<typename T>
+  void Gather(deviceMemory<T> o_gv, const deviceMemory<T> o_v,
+              const deviceMemory<T> o_haloBuf,
+              const int k, const Op op, const Transpose trans,
+              const Rows rows);
+
+private:
+  template <template<typename> class U,
+            template<typename> class V,
+            template<typename> class Op,
+            typename T>
+  void GatherScatter(U<T> v, const V<T> haloBuf,
+                     const int K, const Transpose trans,
+                     const dlong blockStart, const dlong blockEnd);
+  template <template<typename> class U,
+            template<typename> class V,
+            template<typename> class Op,
+            typename T>
+  void Gather(U<T> gv, const U<T> v, const V<T> haloBuf,
+              const int K, const Transpose trans,
+              const dlong blockStart, const dlong blockEnd);
+
+  void setupRowBlocks();
+
+  //4 types - Float, Double, Int32, Int64
+  //4 ops - Add, Mul, Max, Min
+  static kernel_t gatherScatterKernel[4][4];
+  static kernel_t gatherKernel[4][4];
+
   friend void InitializeKernels(platform_t& platform, const Type type, const Op op);
 };
 
+void setupHostRowBlocks(const dlong Nrows,
+                        const memory<dlong> rowStarts,
+                        dlong &NrowBlocks,
+                        memory<dlong> &blockRowStarts);
+
 template <template<typename> class U,
           template<typename> class V,
           typename T>
@@ -0,0 +1,108 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#ifndef OGS_STATS_HPP
+#define OGS_STATS_HPP
+
+#include "ogs.hpp"
+#include "timer.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+struct parallelNode_t;
+
+//Communication counters of a single ogs_t/halo_t handle. Each handle
+// only owns one when "OGS STATS" is TRUE at Setup, so the instrumented
+// paths cost a null check otherwise. Phase timings synchronize the
+// device, and so remove any overlap of the exchange with the caller's
+// kernels.
+class ogsStats_t {
+public:
+  typedef enum {GatherScatter, Gather, Scatter, Exchange, Combine} Operation;
+  static constexpr int Noperations = 5;
+
+  typedef enum {Pack, Wait, Unpack, Staging} Phase;
+  static constexpr int Nphases = 4;
+
+  platform_t platform;
+  comm_t comm;
+  Kind kind;
+
+  hlong calls[Noperations];
+  double time[Nphases]; //seconds
+
+  //halo entries exchanged with each neighbour, for NoTrans and Trans/Sym
+  int Nneighbours=0;
+  memory<int> neighbours;
+  memory<int> sendCountsN, sendCountsT;
+  memory<int> recvCountsN, recvCountsT;
+
+  //bytes exchanged with each neighbour so far
+  memory<hlong> bytesSent, bytesRecv;
+
+  ogsStats_t(platform_t &_platform, comm_t _comm, const Kind _kind,
+             const dlong Nshared, memory<parallelNode_t> &sharedNodes);
+
+  //make and register the counters of a new handle
+  static std::shared_ptr<ogsStats_t> Create(platform_t &_platform, comm_t _comm,
+                                            const Kind _kind, const dlong Nshared,
+                                            memory<parallelNode_t> &sharedNodes);
+
+  //a fresh set of counters on the same neighbours
+  std::shared_ptr<ogsStats_t> Clone(const Kind _kind) const;
+
+  void Call(const Operation op) { calls[op]++; }
+
+  void Message(const size_t Nbytes, const Transpose trans);
+
+  void Begin(const Phase phase) { phaseStart[phase] = PlatformTime(platform); }
+  void End(const Phase phase) {
+    time[phase] += ElapsedTime(phaseStart[phase], PlatformTime(platform));
+  }
+
+  void Reset();
+
+  //collective over comm: min/avg/max across ranks, printed by rank 0
+  void Report(const std::string name) const;
+
+  //report every live handle set up with stats enabled, in setup
+  // order. Collective over comm
+  static void ReportAll(comm_t comm);
+
+private:
+  timePoint_t phaseStart[Nphases];
+
+  //handles still alive at report time
+  static std::vector<std::weak_ptr<ogsStats_t>> registry;
+};
+
+} //namespace ogs
+
+} //namespace libp
+
+#endif
@@ -27,6 +27,7 @@ SOFTWARE.
 #ifndef OGS_UTILS_HPP
 #define OGS_UTILS_HPP
 
+#include <limits>
 #include "ogs.hpp"
 
 namespace libp {
@@ -64,6 +65,28 @@ template<> struct ogsType<long long int> {
   static constexpr Type get() { return Int64; }
 };
 
+//host reduction operations
+template<typename T>
+struct Op_Add {
+  inline const T init() const { return T{0}; }
+  inline void operator()(T& gv, const T v) const { gv += v; }
+};
+template<typename T>
+struct Op_Mul {
+  inline const T init() const { return T{1}; }
+  inline void operator()(T& gv, const T v) const { gv *= v; }
+};
+template<typename T>
+struct Op_Max {
+  inline const T init() const { return -std::numeric_limits<T>::max(); }
+  inline void operator()(T& gv, const T v) const { gv = (v>gv) ? v : gv; }
+};
+template<typename T>
+struct Op_Min {
+  inline const T init() const {return  std::numeric_limits<T>::max(); }
+  inline void operator()(T& gv, const T v) const { gv = (v<gv) ? v : gv; }
+};
+
 //permute an array A, according to the ordering returned by P
 // i.e. for all n, A[P(n)] <- A[n]
 template<typename T, class Order>
@@ -80,6 +103,18 @@ void permute(const dlong N, memory<T> A, Order P) {
   }
 }
 
+//64-bit FNV-1a, used to key the on-disk caches
+constexpr uint64_t hashSeed = 0xcbf29ce484222325ULL;
+
+inline uint64_t hashBytes(const void* data, const size_t Nbytes, uint64_t h) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t n=0;n<Nbytes;n++) {
+    h ^= bytes[n];
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
 } //namespace ogs
 
 } //namespace libp
@@ -134,10 +134,8 @@ public:
   deviceMemory<dfloat> o_vk[PARALMOND_MAX_LEVELS];
   deviceMemory<dfloat> o_wk[PARALMOND_MAX_LEVELS];
 
-  //scratch space
-  size_t NreductionScratch=0;
-  pinnedMemory<dfloat> reductionScratch;
-  deviceMemory<dfloat> o_reductionScratch;
+  //host results of the kcycle's batched reductions
+  memory<dfloat> reductionScratch;
 
   multigrid_t() = default;
   multigrid_t(platform_t& _platform, settings_t& _settings,
@@ -172,25 +170,6 @@ private:
                 deviceMemory<dfloat>& o_X,  deviceMemory<dfloat>& o_RHS,
                 deviceMemory<dfloat>& o_CK, deviceMemory<dfloat>& o_VK, deviceMemory<dfloat>& o_WK,
                 const dfloat alpha1, const dfloat rho1);
-
-  void kcycleCombinedOp1(multigridLevel& level,
-                        deviceMemory<dfloat>& o_a,
-                        deviceMemory<dfloat>& o_b,
-                        deviceMemory<dfloat>& o_c,
-                        dfloat& aDotb,
-                        dfloat& aDotc,
-                        dfloat& bDotb);
-  void kcycleCombinedOp2(multigridLevel& level,
-                        deviceMemory<dfloat>& o_a,
-                        deviceMemory<dfloat>& o_b,
-                        deviceMemory<dfloat>& o_c,
-                        deviceMemory<dfloat>& o_d,
-                        dfloat& aDotb,
-                        dfloat& aDotc,
-                        dfloat& aDotd);
-  dfloat vectorAddInnerProd(multigridLevel& level,
-                          const dfloat alpha, deviceMemory<dfloat>& o_x,
-                          const dfloat beta,  deviceMemory<dfloat>& o_y);
 };
 
 class parAlmond_t: public operator_t {
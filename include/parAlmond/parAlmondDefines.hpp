@@ -31,7 +31,6 @@ namespace libp {
 
 namespace parAlmond {
 
-constexpr int PARALMOND_NBLOCKS=128;
 constexpr int NUMKCYCLES=3;
 constexpr dfloat KCYCLETOL=0.2;
 
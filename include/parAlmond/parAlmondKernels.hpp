@@ -51,13 +51,6 @@ namespace parAlmond {
   extern kernel_t SmoothChebyshevMCSRKernel;
   extern kernel_t SmoothChebyshevUpdateKernel;
 
-  extern kernel_t vectorAddInnerProdKernel;
-  extern kernel_t vectorAddWeightedInnerProdKernel;
-  extern kernel_t kcycleCombinedOp1Kernel;
-  extern kernel_t kcycleCombinedOp2Kernel;
-  extern kernel_t kcycleWeightedCombinedOp1Kernel;
-  extern kernel_t kcycleWeightedCombinedOp2Kernel;
-
   extern kernel_t dGEMVKernel;
 
 } //namespace parAlmond
@@ -37,7 +37,10 @@ SOFTWARE.
 #include "memory.hpp"
 #include "comm.hpp"
 #include "settings.hpp"
+#include "memoryPool.hpp"
 #include "linAlg.hpp"
+#include <map>
+#include <functional>
 
 namespace libp {
 
@@ -47,6 +50,47 @@ public:
   void report();
 };
 
+/*A kernel to be compiled as part of a batch by platform_t::buildKernels.
+  The built kernel is written to *kernel once the whole batch is done.*/
+struct kernelBuild_t {
+  std::string fileName;
+  std::string kernelName;
+  properties_t kernelInfo;
+  kernel_t* kernel;
+};
+
+/*Compile-time defines searched by platform_t::tuneKernel, each with its
+  candidate values. The first value of each define is its default, normally
+  the setup's heuristic, which is used when tuning is disabled.*/
+class tuningSpace_t {
+ public:
+  using point_t = std::map<std::string, int>;
+
+  void addDefine(const std::string name, const std::vector<int> values);
+
+  /*Items per thread block: the default, then powers of two while a block
+    of 'threadsPerItem' threads per item fits in 'maxThreads'*/
+  void addBlockDefine(const std::string name, const int defaultValue,
+                      const int threadsPerItem, const int maxThreads=1024);
+
+  /*Skip the points 'valid' rejects, e.g. blocks too large for the device*/
+  void addConstraint(std::function<bool(const point_t&)> valid);
+
+  /*The default point, then every other valid point*/
+  std::vector<point_t> points() const;
+
+  /*This space without the defines 'source' never mentions*/
+  tuningSpace_t usedIn(const std::string& source) const;
+
+  /*Name of a point in the tuning database*/
+  static std::string label(const point_t& point);
+
+ private:
+  std::vector<std::pair<std::string, std::vector<int>>> defines;
+  std::vector<std::function<bool(const point_t&)>> constraints;
+  point_t fixed; //defines dropped by usedIn, at their defaults
+};
+
 namespace internal {
 
 class iplatform_t {
@@ -54,6 +98,23 @@ public:
   platformSettings_t settings;
   properties_t props;
 
+  //ranks which share the work of compiling kernels
+  comm_t buildComm;
+  bool distributedBuilds=false;
+
+  //count and time the launches of the kernels we build
+  bool kernelStats=false;
+
+  //search the tuning spaces given to tuneKernel
+  bool kernelTuning=false;
+
+  //pooling allocators for device and pinned memory, if enabled
+  std::shared_ptr<memoryPool_t> devicePool;
+  std::shared_ptr<memoryPool_t> pinnedPool;
+
+  //reports added by the libraries built on the platform, by name
+  std::map<std::string, std::function<void(comm_t)>> reports;
+
   iplatform_t(platformSettings_t& _settings):
     settings(_settings) {
   }
@@ -97,6 +158,9 @@ public:
 
     DeviceConfig();
     DeviceProperties();
+    BuildConfig();
+    MemoryPoolConfig();
+    ProfilerConfig();
 
     ilinAlg = std::make_shared<linAlg_t>(this);
   }
@@ -116,11 +180,25 @@ public:
   kernel_t buildKernel(std::string fileName, std::string kernelName,
                        properties_t& kernelInfo);
 
+  void buildKernels(std::vector<kernelBuild_t>& kernels);
+
+  /*Build the fastest variant of a kernel over the defines in 'space'.
+    'launch' runs a candidate as the solver would, on representative data,
+    writing to 'o_result'. Candidates whose result differs from the
+    default's are rejected. The selection is kept in the cache dir, so
+    later runs only build the selected variant. Collective*/
+  kernel_t tuneKernel(std::string fileName, std::string kernelName,
+                      properties_t& kernelInfo, const tuningSpace_t& space,
+                      std::function<void(kernel_t&)> launch,
+                      deviceMemory<dfloat> o_result);
+
   template <typename T>
   deviceMemory<T> malloc(const size_t count,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
-    if (occa::dtype::get<T>() == occa::dtype::none) {
+    if (usePool(iplatform->devicePool, count, prop)) {
+      return poolMalloc<T>(count);
+    } else if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, prop));
     } else {
       return deviceMemory<T>(device.malloc<T>(count, prop));
@@ -132,7 +210,11 @@ public:
                          const memory<T> src,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
-    if (occa::dtype::get<T>() == occa::dtype::none) {
+    if (usePool(iplatform->devicePool, count, prop)) {
+      deviceMemory<T> mem = poolMalloc<T>(count);
+      mem.copyFrom(src);
+      return mem;
+    } else if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, src.ptr(), prop));
     } else {
       return deviceMemory<T>(device.malloc<T>(count, src.ptr(), prop));
@@ -143,7 +225,11 @@ public:
   deviceMemory<T> malloc(const memory<T> src,
                          const properties_t &prop = properties_t()) {
     assertInitialized();
-    if (occa::dtype::get<T>() == occa::dtype::none) {
+    if (usePool(iplatform->devicePool, src.length(), prop)) {
+      deviceMemory<T> mem = poolMalloc<T>(src.length());
+      mem.copyFrom(src);
+      return mem;
+    } else if (occa::dtype::get<T>() == occa::dtype::none) {
       return deviceMemory<T>(device.malloc(src.size(), occa::dtype::byte, src.ptr(), prop));
     } else {
       return deviceMemory<T>(device.malloc<T>(src.length(), src.ptr(), prop));
@@ -153,6 +239,9 @@ public:
   template <typename T>
   pinnedMemory<T> hostMalloc(const size_t count){
     assertInitialized();
+    if (usePool(iplatform->pinnedPool, count)) {
+      return poolHostMalloc<T>(count);
+    }
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, nullptr, hostProp));
@@ -165,6 +254,11 @@ public:
   pinnedMemory<T> hostMalloc(const size_t count,
                              const memory<T> src){
     assertInitialized();
+    if (usePool(iplatform->pinnedPool, count)) {
+      pinnedMemory<T> mem = poolHostMalloc<T>(count);
+      mem.copyFrom(src);
+      return mem;
+    }
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(count*sizeof(T), occa::dtype::byte, src.ptr(), hostProp));
@@ -176,6 +270,11 @@ public:
   template <typename T>
   pinnedMemory<T> hostMalloc(const memory<T> src){
     assertInitialized();
+    if (usePool(iplatform->pinnedPool, src.length())) {
+      pinnedMemory<T> mem = poolHostMalloc<T>(src.length());
+      mem.copyFrom(src);
+      return mem;
+    }
     properties_t hostProp("host", true);
     if (occa::dtype::get<T>() == occa::dtype::none) {
       return pinnedMemory<T>(device.malloc(src.size(), occa::dtype::byte, src.ptr(), hostProp));
@@ -184,6 +283,24 @@ public:
     }
   }
 
+  /*Print the usage and high-water marks of the memory pools, if enabled*/
+  void reportMemoryPool();
+
+  /*Return the free blocks held by the memory pools to the device*/
+  void trimMemoryPool();
+
+  /*Print the launch counts, device times, and modelled throughput of
+    every kernel, if enabled. Collective*/
+  void reportKernelStats();
+
+  /*Add a report for Report() to run, e.g. a library's counters. Adding
+    a second report with the same name replaces the first*/
+  void addReport(const std::string name, std::function<void(comm_t)> report);
+
+  /*Print every enabled report: the added ones, the memory pools, the
+    kernel stats, and the profiled regions. Collective*/
+  void Report();
+
   linAlg_t& linAlg() {
     assertInitialized();
     return *ilinAlg;
@@ -227,9 +344,37 @@ public:
     occa::env::setOccaCacheDir(cacheDir);
   }
 
+  std::string getCacheDir() const {
+    return occa::env::OCCA_CACHE_DIR;
+  }
+
  private:
   void DeviceConfig();
   void DeviceProperties();
+  void BuildConfig();
+  void MemoryPoolConfig();
+  void ProfilerConfig();
+
+  /*Allocations with extra properties bypass the pools*/
+  bool usePool(const std::shared_ptr<memoryPool_t>& pool,
+               const size_t count,
+               const properties_t &prop = properties_t()) const {
+    return pool!=nullptr && count>0 && !prop.isInitialized();
+  }
+
+  template <typename T>
+  deviceMemory<T> poolMalloc(const size_t count) {
+    std::shared_ptr<internal::memoryBlock_t> block;
+    occa::memory mem = iplatform->devicePool->Reserve(count*sizeof(T), block);
+    return deviceMemory<T>(mem, block);
+  }
+
+  template <typename T>
+  pinnedMemory<T> poolHostMalloc(const size_t count) {
+    std::shared_ptr<internal::memoryBlock_t> block;
+    occa::memory mem = iplatform->pinnedPool->Reserve(count*sizeof(T), block);
+    return pinnedMemory<T>(mem, block);
+  }
 };
 
 } //namespace libp
@@ -30,6 +30,7 @@ SOFTWARE.
 #include "settings.hpp"
 #include "platform.hpp"
 #include "operator.hpp"
+#include "timer.hpp"
 
 namespace libp {
 
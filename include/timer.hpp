@@ -54,6 +54,52 @@ timePoint_t GlobalPlatformTime(platform_t &platform, comm_t comm);
 /*Time between time points, in seconds*/
 double ElapsedTime(const timePoint_t start, const timePoint_t end);
 
+/*Hierarchical profiling of named code regions. A region opened while
+  another is active becomes its child, so the same name can appear
+  under several parents. Regions must be opened and closed by the host
+  thread, in nested order. Everything is a no-op unless "PROFILE" is
+  TRUE or SYNC.*/
+namespace Profiler {
+
+/*Called by platform_t at setup. With sync, the device is finished at
+  region entry and exit, so times include the kernels queued inside*/
+void Setup(platform_t &platform, const bool enabled, const bool sync,
+           const std::string fileName);
+
+bool Enabled();
+
+void Begin(const char* name);
+void Begin(const std::string &name);
+void End();
+
+/*Drop all regions recorded so far*/
+void Reset();
+
+/*Collective over comm. Rank 0 prints the cross-rank
+  min/avg/max of calls, inclusive and exclusive time for every region
+  and, if "PROFILE FILE" is set, writes the same data as JSON*/
+void Report(comm_t comm);
+
+} //namespace Profiler
+
+/*Scope guard for a profiled region*/
+class profileRegion_t {
+ public:
+  profileRegion_t(const char* name) { Profiler::Begin(name); }
+  profileRegion_t(const std::string &name) { Profiler::Begin(name); }
+  ~profileRegion_t() { Profiler::End(); }
+
+  profileRegion_t(const profileRegion_t&)=delete;
+  profileRegion_t& operator=(const profileRegion_t&)=delete;
+};
+
+#define LIBP_PROFILE_CONCAT_(a,b) a##b
+#define LIBP_PROFILE_CONCAT(a,b) LIBP_PROFILE_CONCAT_(a,b)
+
+/*Profile the rest of the enclosing scope as region 'name'*/
+#define LIBP_PROFILE(name) \
+  libp::profileRegion_t LIBP_PROFILE_CONCAT(profileRegion, __LINE__)(name)
+
 } //namespace libp
 
 #endif
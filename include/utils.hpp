@@ -43,7 +43,6 @@ namespace libp {
 
 using properties_t = occa::json;
 using device_t = occa::device;
-using kernel_t = occa::kernel;
 using stream_t = occa::stream;
 
 //error codes
@@ -25,14 +25,63 @@ SOFTWARE.
 */
 
 #include "comm.hpp"
+#include <map>
+#include <mutex>
+#include <cstdlib>
 
 namespace libp {
 
 namespace Comm {
 
-/*Static MPI_Init and MPI_Finalize*/
-void Init(int &argc, char** &argv) { MPI_Init(&argc, &argv); }
-void Finalize() { MPI_Finalize(); }
+/*Registry of committed derived datatypes, keyed by byte size*/
+static std::map<size_t, MPI_Datatype> contiguousTypes;
+static std::mutex contiguousTypesMutex;
+
+MPI_Datatype ContiguousType(const size_t bytes) {
+  std::lock_guard<std::mutex> lock(contiguousTypesMutex);
+  auto it = contiguousTypes.find(bytes);
+  if (it != contiguousTypes.end()) return it->second;
+
+  MPI_Datatype type;
+  MPI_Type_contiguous(static_cast<int>(bytes), MPI_CHAR, &type);
+  MPI_Type_commit(&type);
+  contiguousTypes[bytes] = type;
+  return type;
+}
+
+/*Static MPI_Init and MPI_Finalize. Full thread support, which the ogs
+  progress thread needs, can slow down every MPI call, so it is only
+  requested when LIBP_COMM_PROGRESS_THREAD is TRUE. Settings files are
+  read after MPI_Init, hence the environment variable*/
+void Init(int &argc, char** &argv) {
+  if (ProgressThreadRequested()) {
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+  } else {
+    MPI_Init(&argc, &argv);
+  }
+}
+void Finalize() {
+  {
+    std::lock_guard<std::mutex> lock(contiguousTypesMutex);
+    for (auto& entry : contiguousTypes) {
+      MPI_Type_free(&(entry.second));
+    }
+    contiguousTypes.clear();
+  }
+  MPI_Finalize();
+}
+
+bool ProgressThreadRequested() {
+  const char* progressEnvVar = std::getenv("LIBP_COMM_PROGRESS_THREAD");
+  return progressEnvVar != nullptr && std::string(progressEnvVar) == "TRUE";
+}
+
+bool ThreadMultiple() {
+  int provided;
+  MPI_Query_thread(&provided);
+  return provided == MPI_THREAD_MULTIPLE;
+}
 
 /*Static handle to MPI_COMM_WORLD*/
 comm_t World() {
@@ -87,6 +136,49 @@ comm_t comm_t::Split(const int color, const int key) const {
   return c;
 }
 
+/*Split into shared memory (i.e. node-local) comms*/
+comm_t comm_t::SplitShared(const int key) const {
+  comm_t c;
+  /*Make a new comm shared_ptr, which will call MPI_Comm_free when destroyed*/
+  c.comm_ptr = std::shared_ptr<MPI_Comm>(new MPI_Comm,
+                                        [](MPI_Comm *comm) {
+                                          if (*comm != MPI_COMM_NULL)
+                                            MPI_Comm_free(comm);
+                                          delete comm;
+                                        });
+
+  MPI_Comm_split_type(comm(), MPI_COMM_TYPE_SHARED, key,
+                      MPI_INFO_NULL, c.comm_ptr.get());
+  MPI_Comm_rank(c.comm(), &(c._rank));
+  MPI_Comm_size(c.comm(), &(c._size));
+  return c;
+}
+
+/*Distributed graph topology with only local adjacency*/
+comm_t comm_t::DistGraphCreateAdjacent(const int Nsources,
+                                       const memory<int> sources,
+                                       const int Ndestinations,
+                                       const memory<int> destinations) const {
+  comm_t c;
+  /*Make a new comm shared_ptr, which will call MPI_Comm_free when destroyed*/
+  c.comm_ptr = std::shared_ptr<MPI_Comm>(new MPI_Comm,
+                                        [](MPI_Comm *comm) {
+                                          if (*comm != MPI_COMM_NULL)
+                                            MPI_Comm_free(comm);
+                                          delete comm;
+                                        });
+
+  /*Keep the rank ordering so neighbor lists stay valid in the new comm*/
+  MPI_Dist_graph_create_adjacent(comm(),
+                                 Nsources, sources.ptr(), MPI_UNWEIGHTED,
+                                 Ndestinations, destinations.ptr(), MPI_UNWEIGHTED,
+                                 MPI_INFO_NULL, /*reorder*/0,
+                                 c.comm_ptr.get());
+  MPI_Comm_rank(c.comm(), &(c._rank));
+  MPI_Comm_size(c.comm(), &(c._size));
+  return c;
+}
+
 /*Rank and size getters*/
 const int comm_t::rank() const {
   return _rank;
@@ -111,8 +203,45 @@ void comm_t::Waitall(const int count, memory<Comm::request_t> &requests) const {
   MPI_Waitall(count, requests.ptr(), MPI_STATUSES_IGNORE);
 }
 
+bool comm_t::Testall(const int count, memory<Comm::request_t> &requests) const {
+  int flag;
+  MPI_Testall(count, requests.ptr(), &flag, MPI_STATUSES_IGNORE);
+  return flag;
+}
+
+void comm_t::Startall(const int count, memory<Comm::request_t> &requests) const {
+  MPI_Startall(count, requests.ptr());
+}
+
+void comm_t::RequestFree(Comm::request_t &request) const {
+  if (request != MPI_REQUEST_NULL) MPI_Request_free(&request);
+}
+
 void comm_t::Barrier() const {
   MPI_Barrier(comm());
 }
 
+void comm_t::WinAllocateShared(const size_t Nbytes, Comm::win_t &win, void* &base) const {
+  MPI_Win_allocate_shared(static_cast<MPI_Aint>(Nbytes), 1, MPI_INFO_NULL,
+                          comm(), &base, &win);
+  MPI_Win_lock_all(MPI_MODE_NOCHECK, win);
+}
+
+void comm_t::WinSharedQuery(Comm::win_t win, const int rank, void* &base) const {
+  MPI_Aint Nbytes;
+  int dispUnit;
+  MPI_Win_shared_query(win, rank, &Nbytes, &dispUnit, &base);
+}
+
+void comm_t::WinSync(Comm::win_t win) const {
+  MPI_Win_sync(win);
+}
+
+void comm_t::WinFree(Comm::win_t &win) const {
+  if (win != Comm::WinNull) {
+    MPI_Win_unlock_all(win);
+    MPI_Win_free(&win);
+  }
+}
+
 } //namespace libp
@@ -0,0 +1,62 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "core.hpp"
+#include <map>
+#include <mutex>
+
+namespace libp {
+
+namespace internal {
+
+static std::map<std::string, std::shared_ptr<kernelStats_t>> kernelStatsRegistry;
+static std::mutex kernelStatsMutex;
+
+void kernelStats_t::Flush() {
+  for (auto &tags : pending) {
+    time += device.timeBetween(tags.first, tags.second);
+  }
+  pending.clear();
+}
+
+std::shared_ptr<kernelStats_t> kernelStats_t::Get(const std::string _name,
+                                                  occa::device _device) {
+  std::lock_guard<std::mutex> lock(kernelStatsMutex);
+  std::shared_ptr<kernelStats_t> &stats = kernelStatsRegistry[_name];
+  if (!stats) stats = std::make_shared<kernelStats_t>(_name, _device);
+  return stats;
+}
+
+std::vector<std::shared_ptr<kernelStats_t>> kernelStats_t::All() {
+  std::lock_guard<std::mutex> lock(kernelStatsMutex);
+  std::vector<std::shared_ptr<kernelStats_t>> all;
+  for (auto &entry : kernelStatsRegistry) all.push_back(entry.second);
+  return all;
+}
+
+} //namespace internal
+
+} //namespace libp
@@ -0,0 +1,144 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "memoryPool.hpp"
+
+namespace libp {
+
+namespace internal {
+
+memoryBlock_t::~memoryBlock_t() {
+  //give the allocation back to the pool, if it still exists
+  std::shared_ptr<memoryPool_t> p = pool.lock();
+  if (p) p->Release(mem, Nbytes);
+}
+
+} //namespace internal
+
+size_t memoryPool_t::SizeClass(const size_t Nbytes) {
+  if (Nbytes<=minBlockSize) return minBlockSize;
+
+  //largest power of two below Nbytes
+  size_t base = minBlockSize;
+  while (2*base < Nbytes) base *= 2;
+
+  //round up to a quarter of that power of two
+  const size_t step = base/4;
+  return ((Nbytes+step-1)/step)*step;
+}
+
+occa::memory memoryPool_t::Reserve(const size_t Nbytes,
+                                   std::shared_ptr<internal::memoryBlock_t> &block) {
+
+  const size_t Nclass = SizeClass(Nbytes);
+
+  occa::memory mem;
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    Nrequests++;
+
+    auto bin = freeBlocks.find(Nclass);
+    if (bin!=freeBlocks.end() && bin->second.size()>0) {
+      //recycle a freed block
+      mem = bin->second.back();
+      bin->second.pop_back();
+      Nreused++;
+    } else {
+      mem = device.malloc(Nclass, occa::dtype::byte, nullptr, props);
+      Nallocs++;
+      bytesReserved += Nclass;
+      maxBytesReserved = std::max(maxBytesReserved, bytesReserved);
+    }
+
+    bytesInUse += Nclass;
+    maxBytesInUse = std::max(maxBytesInUse, bytesInUse);
+  }
+
+  block = std::make_shared<internal::memoryBlock_t>(weak_from_this(), mem, Nclass);
+
+  return mem.slice(0, Nbytes);
+}
+
+void memoryPool_t::Release(occa::memory mem, const size_t Nbytes) {
+  //kernels and async copies queued before the last reference was dropped
+  // may still use the block, so let them finish before it can be handed
+  // out again. Freeing the memory outright would synchronize as well
+  device.finish();
+
+  std::lock_guard<std::mutex> lock(mtx);
+  bytesInUse -= Nbytes;
+  freeBlocks[Nbytes].push_back(mem);
+}
+
+void memoryPool_t::Trim() {
+  std::lock_guard<std::mutex> lock(mtx);
+  for (auto &bin : freeBlocks) {
+    bytesReserved -= bin.first*bin.second.size();
+  }
+  freeBlocks.clear();
+}
+
+void memoryPool_t::Report(comm_t comm, const std::string name) {
+
+  int rank = comm.rank();
+  int size = comm.size();
+
+  //per-rank quantities to aggregate
+  constexpr int Nvals = 7;
+  memory<double> vals(Nvals);
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+    vals[0] = Nrequests;
+    vals[1] = Nreused;
+    vals[2] = Nallocs;
+    vals[3] = bytesInUse;
+    vals[4] = maxBytesInUse;
+    vals[5] = bytesReserved;
+    vals[6] = maxBytesReserved;
+  }
+
+  memory<double> minVals(Nvals), maxVals(Nvals), sumVals(Nvals);
+  comm.Allreduce(vals, minVals, Comm::Min);
+  comm.Allreduce(vals, maxVals, Comm::Max);
+  comm.Allreduce(vals, sumVals, Comm::Sum);
+
+  if (rank==0) {
+    const char* valNames[Nvals] = {"requests", "reused blocks",
+                                   "allocations", "bytes in use",
+                                   "max bytes in use", "bytes reserved",
+                                   "max bytes reserved"};
+
+    printf("memory pool: %s (%d ranks)\n", name.c_str(), size);
+    printf("                          min          avg          max\n");
+    for (int n=0;n<Nvals;n++) {
+      printf("   %-18s %5.3e    %5.3e    %5.3e\n", valNames[n],
+             minVals[n], sumVals[n]/size, maxVals[n]);
+    }
+  }
+}
+
+} //namespace libp
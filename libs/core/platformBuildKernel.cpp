@@ -25,9 +25,28 @@ SOFTWARE.
 */
 
 #include "platform.hpp"
+#include <set>
 
 namespace libp {
 
+void platform_t::BuildConfig(){
+
+  settings_t& Settings = settings();
+
+  //node-local caches need every node to build its own kernels
+  if (Settings.compareSetting("KERNEL BUILD RANKS", "NODE")) {
+    iplatform->buildComm = comm.SplitShared(rank());
+  } else {
+    iplatform->buildComm = comm;
+  }
+
+  iplatform->distributedBuilds = !Settings.compareSetting("KERNEL BUILD RANKS", "ROOT");
+
+  iplatform->kernelStats = Settings.compareSetting("KERNEL STATS", "TRUE");
+
+  iplatform->kernelTuning = Settings.compareSetting("KERNEL TUNING", "TRUE");
+}
+
 kernel_t platform_t::buildKernel(std::string fileName,
                                  std::string kernelName,
                                  properties_t& kernelInfo){
@@ -36,19 +55,71 @@ kernel_t platform_t::buildKernel(std::string fileName,
 
   kernel_t kernel;
 
+  comm_t& buildComm = iplatform->buildComm;
+
   //build on root first
-  if (!rank())
+  if (!buildComm.rank())
     kernel = device.buildKernel(fileName, kernelName, kernelInfo);
 
-  comm.Barrier();
+  buildComm.Barrier();
 
   //remaining ranks find the cached version (ideally)
-  if (rank())
+  if (buildComm.rank())
     kernel = device.buildKernel(fileName, kernelName, kernelInfo);
 
-  comm.Barrier();
+  buildComm.Barrier();
+
+  if (iplatform->kernelStats)
+    kernel.enableStats(kernelName, device);
 
   return kernel;
 }
 
+/*Build a batch of kernels. The distinct kernels in the batch are dealt
+  out round-robin to the ranks of the build comm, which compile their
+  share concurrently. After a barrier every rank loads the whole batch,
+  which (ideally) finds each kernel in the cache.*/
+void platform_t::buildKernels(std::vector<kernelBuild_t>& kernels){
+
+  assertInitialized();
+
+  comm_t& buildComm = iplatform->buildComm;
+
+  const int buildRank = buildComm.rank();
+  const int buildSize = iplatform->distributedBuilds ? buildComm.size() : 1;
+
+  const size_t Nkernels = kernels.size();
+  std::vector<bool> built(Nkernels, false);
+
+  //find the distinct kernels in the batch and compile our share
+  std::set<std::string> distinct;
+  for (size_t n=0;n<Nkernels;++n) {
+    kernelBuild_t& k = kernels[n];
+    const std::string key = k.fileName + "|" + k.kernelName + "|" + k.kernelInfo.dump();
+
+    if (distinct.find(key) != distinct.end()) continue;
+
+    const int owner = distinct.size() % buildSize;
+    distinct.insert(key);
+
+    if (owner==buildRank) {
+      *(k.kernel) = device.buildKernel(k.fileName, k.kernelName, k.kernelInfo);
+      built[n] = true;
+    }
+  }
+
+  buildComm.Barrier();
+
+  //pick up the rest from the cache
+  for (size_t n=0;n<Nkernels;++n) {
+    kernelBuild_t& k = kernels[n];
+    if (!built[n])
+      *(k.kernel) = device.buildKernel(k.fileName, k.kernelName, k.kernelInfo);
+    if (iplatform->kernelStats)
+      k.kernel->enableStats(k.kernelName, device);
+  }
+
+  buildComm.Barrier();
+}
+
 } //namespace libp
@@ -0,0 +1,122 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "platform.hpp"
+
+namespace libp {
+
+void platform_t::reportKernelStats() {
+  assertInitialized();
+  if (!iplatform->kernelStats) return;
+
+  std::vector<std::shared_ptr<internal::kernelStats_t>> all = internal::kernelStats_t::All();
+
+  //rows are reduced across ranks by position, so order them by name
+  std::sort(all.begin(), all.end(),
+            [](const std::shared_ptr<internal::kernelStats_t>& a,
+               const std::shared_ptr<internal::kernelStats_t>& b) {
+              return a->name < b->name;
+            });
+
+  //every rank builds the same kernels, so the registries should match.
+  // Compare their sizes and a hash (FNV-1a) of the kernel names
+  int Nkernels = static_cast<int>(all.size());
+  uint64_t namesHash = 0xcbf29ce484222325ULL;
+  for (const auto& stats : all) {
+    for (const char c : stats->name + "\n") {
+      namesHash ^= static_cast<unsigned char>(c);
+      namesHash *= 0x100000001b3ULL;
+    }
+  }
+
+  memory<long long int> ids(2), minIds(2), maxIds(2);
+  ids[0] = Nkernels;
+  ids[1] = static_cast<long long int>(namesHash);
+  comm.Allreduce(ids, minIds, Comm::Min);
+  comm.Allreduce(ids, maxIds, Comm::Max);
+  if (minIds[0] != maxIds[0] || minIds[1] != maxIds[1]) {
+    LIBP_FORCE_WARNING("Ranks built different kernels, not reporting kernel stats");
+    return;
+  }
+
+  //per-rank quantities to aggregate
+  constexpr int Nvals = 4;
+  memory<double> vals(Nvals*Nkernels);
+  for (int n=0;n<Nkernels;n++) {
+    internal::kernelStats_t &stats = *all[n];
+    stats.Flush();
+    vals[Nvals*n+0] = static_cast<double>(stats.launches);
+    vals[Nvals*n+1] = stats.time;
+    vals[Nvals*n+2] = stats.bytes;
+    vals[Nvals*n+3] = stats.flops;
+  }
+
+  memory<double> maxVals(Nvals*Nkernels), sumVals(Nvals*Nkernels);
+  comm.Allreduce(vals, maxVals, Comm::Max);
+  comm.Allreduce(vals, sumVals, Comm::Sum);
+
+  if (rank()!=0) return;
+
+  //most expensive first
+  std::vector<int> order;
+  double totalTime=0.0;
+  for (int n=0;n<Nkernels;n++) {
+    if (maxVals[Nvals*n+0]==0) continue; //never launched
+    order.push_back(n);
+    totalTime += sumVals[Nvals*n+1];
+  }
+  std::sort(order.begin(), order.end(),
+            [&](const int a, const int b) {
+              return sumVals[Nvals*a+1] > sumVals[Nvals*b+1];
+            });
+
+  const int size = comm.size();
+
+  //throughputs are per device: the total over ranks of the modelled
+  // work over the total over ranks of the device time
+  printf("Kernel stats (%d ranks, times are max over ranks, throughput is per device):\n", size);
+  printf("%-40s %10s %12s %12s %7s %10s %10s\n",
+         "kernel", "launches", "time (s)", "avg (s)", "%", "GB/s", "GFLOP/s");
+  for (const int n : order) {
+    const double launches = maxVals[Nvals*n+0];
+    const double time     = maxVals[Nvals*n+1];
+    const double sumTime  = sumVals[Nvals*n+1];
+    const double bytes    = sumVals[Nvals*n+2];
+    const double flops    = sumVals[Nvals*n+3];
+
+    printf("%-40s %10lld %12.4e %12.4e %6.2f%%",
+           all[n]->name.c_str(), static_cast<long long int>(launches),
+           time, time/launches,
+           (totalTime>0.0) ? 100.0*sumTime/totalTime : 0.0);
+    if (sumTime>0.0 && bytes>0.0) printf(" %10.2f", bytes/sumTime/1.0e9);
+    else                          printf(" %10s", "-");
+    if (sumTime>0.0 && flops>0.0) printf(" %10.2f", flops/sumTime/1.0e9);
+    else                          printf(" %10s", "-");
+    printf("\n");
+  }
+}
+
+} //namespace libp
@@ -0,0 +1,382 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "platform.hpp"
+#include "timer.hpp"
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace libp {
+
+/********************************
+ * Kernel tuning
+ ********************************/
+// Each tuned kernel is keyed on the thread model, the device arch, its
+// name, and a hash of its source text, build properties (which carry
+// the degree, element type, and precision) and candidate points, so
+// editing the kernel or its search space forces a re-tune. Selections
+// are kept as plain
+// text in
+//   <cache dir>/tuning/<host>.txt
+// one line per key. Rank 0 reads and writes the file and broadcasts its
+// choice.
+
+void tuningSpace_t::addDefine(const std::string name, const std::vector<int> values) {
+  LIBP_ABORT("Tuning define " << name << " has no values", values.size()==0);
+
+  //drop repeats, keeping the default first
+  std::vector<int> distinct;
+  for (const int v : values) {
+    if (std::find(distinct.begin(), distinct.end(), v)==distinct.end())
+      distinct.push_back(v);
+  }
+  defines.push_back({name, distinct});
+}
+
+void tuningSpace_t::addBlockDefine(const std::string name, const int defaultValue,
+                                   const int threadsPerItem, const int maxThreads) {
+  std::vector<int> values = {defaultValue};
+  for (int Nb=1;Nb*threadsPerItem<=maxThreads;Nb*=2) values.push_back(Nb);
+  addDefine(name, values);
+}
+
+void tuningSpace_t::addConstraint(std::function<bool(const point_t&)> valid) {
+  constraints.push_back(valid);
+}
+
+std::vector<tuningSpace_t::point_t> tuningSpace_t::points() const {
+
+  const int Ndefines = static_cast<int>(defines.size());
+
+  //walk the cartesian product of the values, like an odometer
+  std::vector<point_t> all;
+  std::vector<size_t> index(Ndefines, 0);
+  while (true) {
+    point_t point;
+    for (int d=0;d<Ndefines;d++) {
+      point[defines[d].first] = defines[d].second[index[d]];
+    }
+
+    //the default is always a candidate. Constraints also see the
+    // dropped defines, at their defaults
+    bool valid = true;
+    if (all.size()) {
+      point_t full = point;
+      full.insert(fixed.begin(), fixed.end());
+      for (auto& constraint : constraints) valid = valid && constraint(full);
+    }
+    if (valid) all.push_back(point);
+
+    int d=0;
+    for (;d<Ndefines;d++) {
+      if (++index[d] < defines[d].second.size()) break;
+      index[d] = 0;
+    }
+    if (d==Ndefines) break;
+  }
+  return all;
+}
+
+tuningSpace_t tuningSpace_t::usedIn(const std::string& source) const {
+  tuningSpace_t space;
+  space.constraints = constraints;
+  space.fixed = fixed;
+  for (const auto& define : defines) {
+    if (source.find(define.first)!=std::string::npos)
+      space.defines.push_back(define);
+    else
+      space.fixed[define.first] = define.second[0];
+  }
+  return space;
+}
+
+std::string tuningSpace_t::label(const point_t& point) {
+  if (point.empty()) return "default";
+
+  std::string s;
+  for (const auto& define : point) {
+    if (s.size()) s += ",";
+    s += define.first + "=" + std::to_string(define.second);
+  }
+  return s;
+}
+
+namespace {
+
+/*FNV-1a*/
+uint64_t Hash(const std::string& s) {
+  uint64_t h = 0xcbf29ce484222325ULL;
+  for (const char c : s) {
+    h ^= static_cast<unsigned char>(c);
+    h *= 0x100000001b3ULL;
+  }
+  return h;
+}
+
+using tuningEntries_t = std::vector<std::pair<std::string, std::string>>;
+
+/*(key, label) lines of the database. Rank 0 only*/
+tuningEntries_t LoadTuningEntries(const std::string& fileName) {
+  tuningEntries_t entries;
+
+  std::ifstream file(fileName);
+  std::string line;
+  while (std::getline(file, line)) {
+    if (line.empty() || line[0]=='#') continue;
+
+    //four key fields, then the label
+    std::istringstream iss(line);
+    std::string fields[5];
+    bool valid=true;
+    for (int n=0;n<5;n++) valid = valid && static_cast<bool>(iss >> fields[n]);
+    if (!valid) continue;
+
+    entries.push_back({fields[0] + " " + fields[1] + " " + fields[2] + " " + fields[3],
+                       fields[4]});
+  }
+  return entries;
+}
+
+void SaveTuningEntry(const std::string& fileName,
+                     const std::string& key,
+                     const std::string& label) {
+
+  //re-read the file, in case other runs added to it since we looked
+  tuningEntries_t entries = LoadTuningEntries(fileName);
+  bool found=false;
+  for (auto& entry : entries) {
+    if (entry.first==key) {
+      entry.second = label;
+      found=true;
+    }
+  }
+  if (!found) entries.push_back({key, label});
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(fileName).parent_path(), ec);
+
+  //write to a temporary file and move it into place, so a concurrent
+  // run never reads a partial database
+  const std::string tmpName = fileName + ".tmp";
+  std::ofstream file(tmpName);
+  LIBP_WARNING("Unable to write kernel tuning database " << tmpName,
+               !file.is_open());
+  if (!file.is_open()) return;
+
+  file << "# libParanumal kernel tuning selections" << std::endl;
+  file << "# thread model, arch, kernel, build hash, defines" << std::endl;
+  for (const auto& entry : entries) {
+    file << entry.first << " " << entry.second << std::endl;
+  }
+  file.close();
+
+  if (file) {
+    std::filesystem::rename(tmpName, fileName, ec);
+  } else {
+    std::filesystem::remove(tmpName, ec);
+  }
+}
+
+properties_t PointProperties(const properties_t& kernelInfo,
+                             const tuningSpace_t::point_t& point) {
+  properties_t props = kernelInfo;
+  for (const auto& define : point) {
+    props["defines/" + define.first] = define.second;
+  }
+  return props;
+}
+
+} //namespace
+
+kernel_t platform_t::tuneKernel(std::string fileName,
+                                std::string kernelName,
+                                properties_t& kernelInfo,
+                                const tuningSpace_t& space,
+                                std::function<void(kernel_t&)> launch,
+                                deviceMemory<dfloat> o_result) {
+
+  assertInitialized();
+
+  //only search the defines the kernel source uses. Defines used only in
+  // included headers are left at their defaults
+  std::ifstream sourceFile(fileName);
+  const std::string source((std::istreambuf_iterator<char>(sourceFile)),
+                           std::istreambuf_iterator<char>());
+
+  const std::vector<tuningSpace_t::point_t> points = space.usedIn(source).points();
+  const int Npoints = static_cast<int>(points.size());
+
+  if (!iplatform->kernelTuning || Npoints==1) {
+    properties_t props = PointProperties(kernelInfo, points[0]);
+    return buildKernel(fileName, kernelName, props);
+  }
+
+  //name the machine after the host of rank 0
+  memory<char> hostname(MAX_PROCESSOR_NAME);
+  std::memset(hostname.ptr(), 0, MAX_PROCESSOR_NAME);
+  int namelen;
+  Comm::GetProcessorName(hostname.ptr(), namelen);
+  comm.Bcast(hostname, 0);
+
+  const std::string tuningFile = getCacheDir() + "/tuning/" + hostname.ptr() + ".txt";
+
+  std::string arch = device.arch();
+  if (arch.empty()) arch = "-";
+
+  std::string candidateLabels;
+  for (const auto& point : points) candidateLabels += "|" + tuningSpace_t::label(point);
+
+  std::stringstream ss;
+  ss << device.mode() << " " << arch << " " << kernelName << " "
+     << std::hex << std::setw(16) << std::setfill('0')
+     << Hash(source + "|" + kernelInfo.dump() + candidateLabels);
+  const std::string key = ss.str();
+
+  //look for an earlier selection
+  int selected = -1;
+  if (comm.rank()==0) {
+    for (const auto& entry : LoadTuningEntries(tuningFile)) {
+      if (entry.first!=key) continue;
+      for (int p=0;p<Npoints;p++) {
+        if (tuningSpace_t::label(points[p])==entry.second) selected = p;
+      }
+    }
+  }
+  comm.Bcast(selected, 0);
+
+  if (selected>=0) {
+    properties_t props = PointProperties(kernelInfo, points[selected]);
+    return buildKernel(fileName, kernelName, props);
+  }
+
+  //compile every candidate as one batch
+  std::vector<kernel_t> candidates(Npoints);
+  std::vector<kernelBuild_t> builds;
+  for (int p=0;p<Npoints;p++) {
+    builds.push_back({fileName, kernelName,
+                      PointProperties(kernelInfo, points[p]),
+                      &candidates[p]});
+  }
+  buildKernels(builds);
+
+  //run each candidate once from the same contents of o_result, and
+  // reject those which do not reproduce the default's output
+  const size_t Nresult = o_result.length();
+  memory<dfloat> initial(Nresult), reference(Nresult), result(Nresult);
+  o_result.copyTo(initial);
+
+  const dfloat tol = std::sqrt(std::numeric_limits<dfloat>::epsilon());
+
+  dfloat scale = 0.0;
+  memory<int> valid(Npoints), allValid(Npoints);
+  for (int p=0;p<Npoints;p++) {
+    kernel_t& candidate = candidates[p];
+    candidate.disableStats();
+
+    o_result.copyFrom(initial);
+    launch(candidate);
+    o_result.copyTo((p==0) ? reference : result);
+
+    valid[p] = 1;
+    if (p==0) {
+      for (size_t n=0;n<Nresult;n++) {
+        if (std::isfinite(reference[n])) scale = std::max(scale, std::abs(reference[n]));
+      }
+      continue;
+    }
+
+    for (size_t n=0;n<Nresult;n++) {
+      if (!std::isfinite(reference[n])) continue; //nothing to compare against
+      if (!(std::abs(result[n]-reference[n]) <= tol*(1+scale))) valid[p] = 0;
+    }
+  }
+
+  //a candidate must be correct on every rank
+  comm.Allreduce(valid, allValid, Comm::Min);
+
+  constexpr int Ntrials = 10;
+
+  memory<double> times(Npoints), maxTimes(Npoints);
+  for (int p=0;p<Npoints;p++) {
+    kernel_t& candidate = candidates[p];
+    if (!allValid[p]) {
+      times[p] = std::numeric_limits<double>::max();
+      continue;
+    }
+
+    launch(candidate); //warm up
+
+    device.finish();
+    timePoint_t start = Time();
+    for (int n=0;n<Ntrials;n++) launch(candidate);
+    device.finish();
+    times[p] = ElapsedTime(start, Time())/Ntrials;
+  }
+
+  //leave the caller's data as we found it
+  o_result.copyFrom(initial);
+
+  //the slowest rank sets the pace
+  comm.Allreduce(times, maxTimes, Comm::Max);
+
+  selected = 0;
+  for (int p=1;p<Npoints;p++) {
+    if (maxTimes[p]<maxTimes[selected]) selected = p;
+  }
+
+  if (comm.rank()==0) {
+    for (int p=1;p<Npoints;p++) {
+      LIBP_WARNING("Tuning candidate " << tuningSpace_t::label(points[p])
+                   << " of " << kernelName << " does not reproduce the default's result",
+                   !allValid[p]);
+    }
+
+    printf("Tuned %s over %d variants: %s (%.3e s), default %s (%.3e s)\n",
+           kernelName.c_str(), Npoints,
+           tuningSpace_t::label(points[selected]).c_str(), maxTimes[selected],
+           tuningSpace_t::label(points[0]).c_str(), maxTimes[0]);
+
+    SaveTuningEntry(tuningFile, key, tuningSpace_t::label(points[selected]));
+  }
+
+  kernel_t kernel = candidates[selected];
+  if (iplatform->kernelStats)
+    kernel.enableStats(kernelName, device);
+
+  for (int p=0;p<Npoints;p++) {
+    if (p!=selected) candidates[p].free();
+  }
+
+  return kernel;
+}
+
+} //namespace libp
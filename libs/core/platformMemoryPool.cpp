@@ -0,0 +1,50 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "platform.hpp"
+
+namespace libp {
+
+void platform_t::MemoryPoolConfig() {
+  if (settings().compareSetting("MEMORY POOL", "TRUE")) {
+    iplatform->devicePool = std::make_shared<memoryPool_t>(device, properties_t());
+    iplatform->pinnedPool = std::make_shared<memoryPool_t>(device, properties_t("host", true));
+  }
+}
+
+void platform_t::reportMemoryPool() {
+  assertInitialized();
+  if (iplatform->devicePool) iplatform->devicePool->Report(comm, "device");
+  if (iplatform->pinnedPool) iplatform->pinnedPool->Report(comm, "pinned host");
+}
+
+void platform_t::trimMemoryPool() {
+  assertInitialized();
+  if (iplatform->devicePool) iplatform->devicePool->Trim();
+  if (iplatform->pinnedPool) iplatform->pinnedPool->Trim();
+}
+
+} //namespace libp
@@ -53,6 +53,55 @@ platformSettings_t::platformSettings_t(comm_t _comm):
   newSetting("CACHE DIR",
              LIBP_DIR "/.occa",
              "Path for OCCA to place kernel cache");
+
+  newSetting("KERNEL BUILD RANKS",
+             "ROOT",
+             "Ranks sharing kernel compilation (ROOT builds once into a shared CACHE DIR, NODE suits a node-local CACHE DIR, ALL a shared one)",
+             {"ROOT", "NODE", "ALL"});
+
+  newSetting("KERNEL STATS",
+             "FALSE",
+             "Count and time every kernel launch, and report per-kernel throughput at the end of the run",
+             {"TRUE", "FALSE"});
+
+  newSetting("KERNEL TUNING",
+             "FALSE",
+             "Time the variants of tunable kernels at setup and keep the fastest (selections are cached in CACHE DIR)",
+             {"TRUE", "FALSE"});
+
+  newSetting("MEMORY POOL",
+             "FALSE",
+             "Recycle device and pinned host allocations through size-class pools",
+             {"TRUE", "FALSE"});
+
+  newSetting("PROFILE",
+             "FALSE",
+             "Time nested code regions and report them at the end of the run (SYNC finishes the device at region boundaries)",
+             {"FALSE", "TRUE", "SYNC"});
+
+  newSetting("PROFILE FILE",
+             "",
+             "File to write the region profile to as JSON (none if empty)");
+
+  newSetting("COMM PROGRESS THREAD",
+             Comm::ProgressThreadRequested() ? "TRUE" : "FALSE",
+             "Progress ogs MPI exchanges from a helper thread (needs LIBP_COMM_PROGRESS_THREAD=TRUE in the environment)",
+             {"TRUE", "FALSE"});
+
+  newSetting("OGS SETUP CACHE",
+             "FALSE",
+             "Store ogs setup plans in the cache directory and reuse them in later runs",
+             {"TRUE", "FALSE"});
+
+  newSetting("OGS TUNING DATABASE",
+             "FALSE",
+             "Record the exchange methods selected by ogs::Auto in the cache directory",
+             {"TRUE", "FALSE"});
+
+  newSetting("OGS STATS",
+             "FALSE",
+             "Count calls, bytes and time spent in ogs communication",
+             {"TRUE", "FALSE"});
 }
 
 void platformSettings_t::report() {
@@ -70,6 +119,18 @@ void platformSettings_t::report() {
         ||compareSetting("THREAD MODEL","HIP")
         ||compareSetting("THREAD MODEL","OpenCL") ))
       reportSetting("DEVICE NUMBER");
+
+    reportSetting("KERNEL BUILD RANKS");
+    reportSetting("KERNEL STATS");
+    reportSetting("KERNEL TUNING");
+    reportSetting("MEMORY POOL");
+    reportSetting("PROFILE");
+    if (!compareSetting("PROFILE","FALSE"))
+      reportSetting("PROFILE FILE");
+    reportSetting("COMM PROGRESS THREAD");
+    reportSetting("OGS SETUP CACHE");
+    reportSetting("OGS TUNING DATABASE");
+    reportSetting("OGS STATS");
   }
 }
 
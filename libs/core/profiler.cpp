@@ -0,0 +1,332 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "timer.hpp"
+#include <map>
+#include <fstream>
+#include <algorithm>
+
+namespace libp {
+
+namespace Profiler {
+
+namespace {
+
+struct region_t {
+  std::string name;
+  std::string path; //names from the root, separated by '/'
+  int parent=-1;
+  std::map<std::string, int> children;
+
+  hlong calls=0;
+  double inclusive=0.0; //seconds
+  double childTime=0.0; //inclusive time of the children
+  timePoint_t start;
+};
+
+struct profiler_t {
+  bool enabled=false;
+  bool sync=false;
+  std::string fileName;
+  device_t device; //for synchronized timing
+
+  //region 0 is the root, which is never timed
+  std::vector<region_t> regions;
+  int current=0;
+};
+
+profiler_t profiler;
+
+void Clear() {
+  profiler.regions.clear();
+  profiler.regions.emplace_back();
+  profiler.current=0;
+}
+
+timePoint_t Now() {
+  if (profiler.sync) profiler.device.finish();
+  return Time();
+}
+
+/*Cross-rank statistics of one region*/
+struct stats_t {
+  std::string path;
+  std::string name;
+  int depth;
+  double minVal[3], avgVal[3], maxVal[3]; //calls, inclusive, exclusive
+};
+
+void WriteJSON(std::ostream &out, const std::vector<stats_t> &stats,
+               size_t &n, const int depth) {
+
+  const char* valNames[3] = {"calls", "inclusive", "exclusive"};
+
+  out << "[";
+  bool first=true;
+  while (n<stats.size() && stats[n].depth==depth) {
+    const stats_t &s = stats[n];
+    const std::string indent(2*depth+2, ' ');
+
+    out << (first ? "\n" : ",\n") << indent << "{\"name\": \"" << s.name << "\", ";
+    for (int v=0;v<3;v++) {
+      out << "\"" << valNames[v] << "\": {\"min\": " << s.minVal[v]
+          << ", \"avg\": " << s.avgVal[v]
+          << ", \"max\": " << s.maxVal[v] << "}, ";
+    }
+    out << "\"children\": ";
+    n++;
+    WriteJSON(out, stats, n, depth+1);
+    out << "}";
+    first=false;
+  }
+  out << "]";
+}
+
+} //namespace
+
+void Setup(platform_t &platform, const bool enabled, const bool sync,
+           const std::string fileName) {
+  profiler.enabled = enabled;
+  profiler.sync = sync;
+  profiler.fileName = fileName;
+  profiler.device = platform.device;
+  Clear();
+}
+
+bool Enabled() {
+  return profiler.enabled;
+}
+
+void Begin(const char* name) {
+  if (!profiler.enabled) return;
+  Begin(std::string(name));
+}
+
+void Begin(const std::string &name) {
+  if (!profiler.enabled) return;
+
+  region_t &parent = profiler.regions[profiler.current];
+  auto it = parent.children.find(name);
+
+  int id;
+  if (it == parent.children.end()) {
+    id = static_cast<int>(profiler.regions.size());
+    region_t region;
+    region.name = name;
+    region.path = (profiler.current==0) ? name : parent.path + "/" + name;
+    region.parent = profiler.current;
+    profiler.regions[profiler.current].children[name] = id;
+    profiler.regions.push_back(region);
+  } else {
+    id = it->second;
+  }
+
+  profiler.current = id;
+  profiler.regions[id].calls++;
+  profiler.regions[id].start = Now();
+}
+
+void End() {
+  if (!profiler.enabled) return;
+
+  LIBP_ABORT("Profiler::End called with no open region",
+             profiler.current==0);
+
+  region_t &region = profiler.regions[profiler.current];
+  const double elapsed = ElapsedTime(region.start, Now());
+  region.inclusive += elapsed;
+
+  profiler.current = region.parent;
+  profiler.regions[profiler.current].childTime += elapsed;
+}
+
+void Reset() {
+  if (!profiler.enabled) return;
+
+  LIBP_WARNING("Profiler::Reset called inside an open region",
+               profiler.current!=0);
+  Clear();
+}
+
+void Report(comm_t comm) {
+  if (!profiler.enabled) return;
+
+  LIBP_WARNING("Profiler::Report called inside an open region",
+               profiler.current!=0);
+
+  const int rank = comm.rank();
+  const int size = comm.size();
+
+  //ranks may not have entered the same regions, so first collect the
+  // union of region paths on rank 0, in depth-first order
+  std::string localPaths;
+  std::vector<int> stack(1, 0);
+  while (stack.size()) {
+    const int id = stack.back();
+    stack.pop_back();
+    if (id) localPaths += profiler.regions[id].path + "\n";
+    //visit children in the order they were first entered
+    std::vector<int> children;
+    for (auto &child : profiler.regions[id].children) children.push_back(child.second);
+    std::sort(children.begin(), children.end());
+    stack.insert(stack.end(), children.rbegin(), children.rend());
+  }
+
+  int Nchars = static_cast<int>(localPaths.size());
+  memory<int> counts(size), offsets(size+1);
+  comm.Gather(Nchars, counts, 0);
+
+  offsets[0]=0;
+  if (rank==0) {
+    for (int r=0;r<size;r++) offsets[r+1] = offsets[r]+counts[r];
+  }
+
+  memory<char> sendPaths(Nchars+1);
+  std::copy(localPaths.begin(), localPaths.end(), sendPaths.ptr());
+  memory<char> recvPaths((rank==0) ? offsets[size]+1 : 1);
+  comm.Gatherv(sendPaths, Nchars, recvPaths, counts, offsets, 0);
+
+  //rank 0 merges the paths into one tree
+  std::vector<std::string> paths;
+  if (rank==0) {
+    std::map<std::string, std::vector<std::string>> children;
+    std::map<std::string, bool> known;
+    const std::string all(recvPaths.ptr(), offsets[size]);
+    size_t begin=0;
+    while (begin<all.size()) {
+      const size_t end = all.find('\n', begin);
+      const std::string path = all.substr(begin, end-begin);
+      if (!known[path]) {
+        known[path] = true;
+        const size_t slash = path.rfind('/');
+        const std::string parentPath = (slash==std::string::npos) ? "" : path.substr(0, slash);
+        children[parentPath].push_back(path);
+      }
+      begin = end+1;
+    }
+
+    std::vector<std::string> pathStack(1, "");
+    while (pathStack.size()) {
+      const std::string path = pathStack.back();
+      pathStack.pop_back();
+      if (path.size()) paths.push_back(path);
+      std::vector<std::string> &kids = children[path];
+      for (auto it = kids.rbegin(); it != kids.rend(); ++it) {
+        pathStack.push_back(*it);
+      }
+    }
+  }
+
+  //share the merged list
+  std::string allPaths;
+  for (const std::string &path : paths) allPaths += path + "\n";
+  Nchars = static_cast<int>(allPaths.size());
+  comm.Bcast(Nchars, 0);
+  memory<char> mergedPaths(Nchars+1);
+  if (rank==0) std::copy(allPaths.begin(), allPaths.end(), mergedPaths.ptr());
+  comm.Bcast(mergedPaths, 0, Nchars);
+
+  if (rank!=0) {
+    const std::string all(mergedPaths.ptr(), Nchars);
+    size_t begin=0;
+    while (begin<all.size()) {
+      const size_t end = all.find('\n', begin);
+      paths.push_back(all.substr(begin, end-begin));
+      begin = end+1;
+    }
+  }
+
+  //fill in this rank's values. Regions this rank never entered count
+  // as zero
+  std::map<std::string, int> localIds;
+  for (size_t n=1;n<profiler.regions.size();n++) {
+    localIds[profiler.regions[n].path] = static_cast<int>(n);
+  }
+
+  const int Nregions = static_cast<int>(paths.size());
+  memory<double> vals(3*Nregions, 0.0);
+  for (int n=0;n<Nregions;n++) {
+    auto it = localIds.find(paths[n]);
+    if (it == localIds.end()) continue;
+    const region_t &region = profiler.regions[it->second];
+    vals[3*n+0] = static_cast<double>(region.calls);
+    vals[3*n+1] = region.inclusive;
+    vals[3*n+2] = region.inclusive - region.childTime;
+  }
+
+  memory<double> minVals(3*Nregions), maxVals(3*Nregions), sumVals(3*Nregions);
+  comm.Allreduce(vals, minVals, Comm::Min);
+  comm.Allreduce(vals, maxVals, Comm::Max);
+  comm.Allreduce(vals, sumVals, Comm::Sum);
+
+  if (rank!=0) return;
+
+  std::vector<stats_t> stats(Nregions);
+  for (int n=0;n<Nregions;n++) {
+    stats_t &s = stats[n];
+    s.path = paths[n];
+    const size_t slash = s.path.rfind('/');
+    s.name = (slash==std::string::npos) ? s.path : s.path.substr(slash+1);
+    s.depth = static_cast<int>(std::count(s.path.begin(), s.path.end(), '/'));
+    for (int v=0;v<3;v++) {
+      s.minVal[v] = minVals[3*n+v];
+      s.avgVal[v] = sumVals[3*n+v]/size;
+      s.maxVal[v] = maxVals[3*n+v];
+    }
+  }
+
+  printf("Profile (%d ranks%s):\n", size, profiler.sync ? ", device synchronized" : "");
+  printf("%-40s %11s  %-35s  %-35s\n", "", "calls",
+         "     inclusive time (s)", "     exclusive time (s)");
+  printf("%-40s %11s  %11s %11s %11s  %11s %11s %11s\n", "region", "max",
+         "min", "avg", "max", "min", "avg", "max");
+  for (const stats_t &s : stats) {
+    const std::string label = std::string(2*s.depth, ' ') + s.name;
+    printf("%-40s %11lld  %11.4e %11.4e %11.4e  %11.4e %11.4e %11.4e\n",
+           label.c_str(), static_cast<long long int>(s.maxVal[0]),
+           s.minVal[1], s.avgVal[1], s.maxVal[1],
+           s.minVal[2], s.avgVal[2], s.maxVal[2]);
+  }
+
+  if (profiler.fileName.size()) {
+    std::ofstream file(profiler.fileName);
+    LIBP_WARNING("Unable to write profile " << profiler.fileName,
+                 !file.is_open());
+    if (file.is_open()) {
+      file << "{\"ranks\": " << size
+           << ", \"sync\": " << (profiler.sync ? "true" : "false")
+           << ", \"regions\": ";
+      size_t n=0;
+      WriteJSON(file, stats, n, 0);
+      file << "}\n";
+      printf("Profile written to %s\n", profiler.fileName.c_str());
+    }
+  }
+}
+
+} //namespace Profiler
+
+} //namespace libp
@@ -29,40 +29,105 @@ SOFTWARE.
 
 namespace libp {
 
+namespace {
+
+//one pass over the vectors for a group of pairs, unweighted if w is null
+template<int Nprods>
+void HostDots(const dlong N, const dfloat* w,
+              const dfloat* const* x, const dfloat* const* y,
+              dfloat* dots, const bool threads) {
+  dfloat s[Nprods] = {};
+
+  #pragma omp parallel for simd schedule(static) reduction(+:s) if(threads)
+  for (dlong n=0;n<N;n++) {
+    const dfloat wn = w ? w[n] : 1.0;
+    for (int p=0;p<Nprods;p++) s[p] += wn*x[p][n]*y[p][n];
+  }
+
+  for (int p=0;p<Nprods;p++) dots[p] = s[p];
+}
+
+} //namespace
+
 /*********************/
 /* vector operations */
 /*********************/
 
 // o_a[n] = alpha
 void linAlg_t::set(const dlong N, const dfloat alpha, deviceMemory<dfloat> o_a) {
+  if (hostMode) {
+    dfloat* a = o_a.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) a[n] = alpha;
+    return;
+  }
   setKernel(N, alpha, o_a);
 }
 
 // o_a[n] += alpha
 void linAlg_t::add(const dlong N, const dfloat alpha, deviceMemory<dfloat> o_a) {
+  if (hostMode) {
+    dfloat* a = o_a.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) a[n] += alpha;
+    return;
+  }
   addKernel(N, alpha, o_a);
 }
 
 // o_a[n] *= alpha
 void linAlg_t::scale(const dlong N, const dfloat alpha, deviceMemory<dfloat> o_a)  {
+  if (hostMode) {
+    dfloat* a = o_a.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) a[n] *= alpha;
+    return;
+  }
   scaleKernel(N, alpha, o_a);
 }
 
 // o_y[n] = beta*o_y[n] + alpha*o_x[n]
 void linAlg_t::axpy(const dlong N, const dfloat alpha, deviceMemory<dfloat> o_x,
                     const dfloat beta,  deviceMemory<dfloat> o_y) {
+  if (hostMode) {
+    const dfloat* x = o_x.ptr();
+    dfloat* y = o_y.ptr();
+    if (beta!=0) {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*x[n] + beta*y[n];
+    } else {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*x[n];
+    }
+    return;
+  }
   axpyKernel(N, alpha, o_x, beta, o_y);
 }
 
 // o_z[n] = beta*o_y[n] + alpha*o_x[n]
 void linAlg_t::zaxpy(const dlong N, const dfloat alpha, deviceMemory<dfloat> o_x,
                      const dfloat beta, deviceMemory<dfloat> o_y, deviceMemory<dfloat> o_z) {
+  if (hostMode) {
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    dfloat* z = o_z.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) z[n] = alpha*x[n] + beta*y[n];
+    return;
+  }
   zaxpyKernel(N, alpha, o_x, beta, o_y, o_z);
 }
 
 // o_x[n] = alpha*o_a[n]*o_x[n]
 void linAlg_t::amx(const dlong N, const dfloat alpha,
                    deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat* x = o_x.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) x[n] = alpha*a[n]*x[n];
+    return;
+  }
   amxKernel(N, alpha, o_a, o_x);
 }
 
@@ -70,6 +135,19 @@ void linAlg_t::amx(const dlong N, const dfloat alpha,
 void linAlg_t::amxpy(const dlong N, const dfloat alpha,
                      deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x,
                      const dfloat beta, deviceMemory<dfloat> o_y) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    const dfloat* x = o_x.ptr();
+    dfloat* y = o_y.ptr();
+    if (beta!=0) {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*a[n]*x[n] + beta*y[n];
+    } else {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*a[n]*x[n];
+    }
+    return;
+  }
   amxpyKernel(N, alpha, o_a, o_x, beta, o_y);
 }
 
@@ -77,12 +155,28 @@ void linAlg_t::amxpy(const dlong N, const dfloat alpha,
 void linAlg_t::zamxpy(const dlong N, const dfloat alpha,
                       deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x,
                       const dfloat beta, deviceMemory<dfloat> o_y, deviceMemory<dfloat> o_z) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    dfloat* z = o_z.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) z[n] = alpha*a[n]*x[n] + beta*y[n];
+    return;
+  }
   zamxpyKernel(N, alpha, o_a, o_x, beta, o_y, o_z);
 }
 
 // o_x[n] = alpha*o_x[n]/o_a[n]
 void linAlg_t::adx(const dlong N, const dfloat alpha,
                    deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat* x = o_x.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) x[n] = alpha*x[n]/a[n];
+    return;
+  }
   adxKernel(N, alpha, o_a, o_x);
 }
 
@@ -90,6 +184,19 @@ void linAlg_t::adx(const dlong N, const dfloat alpha,
 void linAlg_t::adxpy(const dlong N, const dfloat alpha,
                      deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x,
                      const dfloat beta, deviceMemory<dfloat> o_y) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    const dfloat* x = o_x.ptr();
+    dfloat* y = o_y.ptr();
+    if (beta!=0) {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*x[n]/a[n] + beta*y[n];
+    } else {
+      #pragma omp parallel for simd schedule(static) if(hostThreads)
+      for (dlong n=0;n<N;n++) y[n] = alpha*x[n]/a[n];
+    }
+    return;
+  }
   adxpyKernel(N, alpha, o_a, o_x, beta, o_y);
 }
 
@@ -97,11 +204,29 @@ void linAlg_t::adxpy(const dlong N, const dfloat alpha,
 void linAlg_t::zadxpy(const dlong N, const dfloat alpha,
                       deviceMemory<dfloat> o_a, deviceMemory<dfloat> o_x,
                       const dfloat beta, deviceMemory<dfloat> o_y, deviceMemory<dfloat> o_z) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    dfloat* z = o_z.ptr();
+    #pragma omp parallel for simd schedule(static) if(hostThreads)
+    for (dlong n=0;n<N;n++) z[n] = alpha*x[n]/a[n] + beta*y[n];
+    return;
+  }
   zadxpyKernel(N, alpha, o_a, o_x, beta, o_y, o_z);
 }
 
 // \min o_a
 dfloat linAlg_t::min(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat globalmin = std::numeric_limits<dfloat>::max();
+    #pragma omp parallel for simd schedule(static) reduction(min:globalmin) if(hostThreads)
+    for (dlong n=0;n<N;n++) globalmin = (a[n]<globalmin) ? a[n] : globalmin;
+    comm.Allreduce(globalmin, Comm::Min);
+    return globalmin;
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -119,6 +244,15 @@ dfloat linAlg_t::min(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
 
 // \max o_a
 dfloat linAlg_t::max(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat globalmax = -std::numeric_limits<dfloat>::max();
+    #pragma omp parallel for simd schedule(static) reduction(max:globalmax) if(hostThreads)
+    for (dlong n=0;n<N;n++) globalmax = (a[n]>globalmax) ? a[n] : globalmax;
+    comm.Allreduce(globalmax, Comm::Max);
+    return globalmax;
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -136,6 +270,15 @@ dfloat linAlg_t::max(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
 
 // \sum o_a
 dfloat linAlg_t::sum(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat globalsum = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:globalsum) if(hostThreads)
+    for (dlong n=0;n<N;n++) globalsum += a[n];
+    comm.Allreduce(globalsum, Comm::Sum);
+    return globalsum;
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -153,6 +296,15 @@ dfloat linAlg_t::sum(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
 
 // ||o_a||_2
 dfloat linAlg_t::norm2(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    dfloat globalnorm = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:globalnorm) if(hostThreads)
+    for (dlong n=0;n<N;n++) globalnorm += a[n]*a[n];
+    comm.Allreduce(globalnorm, Comm::Sum);
+    return sqrt(globalnorm);
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -171,6 +323,16 @@ dfloat linAlg_t::norm2(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
 // o_x.o_y
 dfloat linAlg_t::innerProd(const dlong N, deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
                            comm_t comm) {
+  if (hostMode) {
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    dfloat globaldot = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:globaldot) if(hostThreads)
+    for (dlong n=0;n<N;n++) globaldot += x[n]*y[n];
+    comm.Allreduce(globaldot, Comm::Sum);
+    return globaldot;
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -190,6 +352,17 @@ dfloat linAlg_t::innerProd(const dlong N, deviceMemory<dfloat> o_x, deviceMemory
 dfloat linAlg_t::weightedInnerProd(const dlong N, deviceMemory<dfloat> o_w,
                                    deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
                                    comm_t comm) {
+  if (hostMode) {
+    const dfloat* w = o_w.ptr();
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    dfloat globaldot = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:globaldot) if(hostThreads)
+    for (dlong n=0;n<N;n++) globaldot += w[n]*x[n]*y[n];
+    comm.Allreduce(globaldot, Comm::Sum);
+    return globaldot;
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -208,6 +381,16 @@ dfloat linAlg_t::weightedInnerProd(const dlong N, deviceMemory<dfloat> o_w,
 // ||o_a||_w2
 dfloat linAlg_t::weightedNorm2(const dlong N, deviceMemory<dfloat> o_w,
                                deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* w = o_w.ptr();
+    const dfloat* a = o_a.ptr();
+    dfloat globalnorm = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:globalnorm) if(hostThreads)
+    for (dlong n=0;n<N;n++) globalnorm += w[n]*a[n]*a[n];
+    comm.Allreduce(globalnorm, Comm::Sum);
+    return sqrt(globalnorm);
+  }
+
   int Nblock = (N+blocksize-1)/blocksize;
   Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
 
@@ -223,4 +406,311 @@ dfloat linAlg_t::weightedNorm2(const dlong N, deviceMemory<dfloat> o_w,
   return sqrt(globalnorm);
 }
 
+// dots[i] = pairs[i].first.pairs[i].second
+void linAlg_t::innerProds(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                          memory<dfloat> dots, comm_t comm) {
+  const int Ndots = static_cast<int>(pairs.size());
+  if (Ndots==0) return;
+
+  LIBP_ABORT("linAlg_t::innerProds output has " << dots.length()
+             << " entries for " << Ndots << " products",
+             dots.length() < static_cast<size_t>(Ndots));
+
+  if (hostMode) {
+    HostInnerProds(N, nullptr, pairs, dots.ptr());
+    comm.Allreduce(dots, Comm::Sum, Ndots);
+    return;
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  ReserveDots(Ndots);
+  LaunchInnerProds(N, pairs, Nblock);
+
+  ReduceDots(Ndots, Nblock, dots, comm);
+}
+
+// dots[i] = o_w.pairs[i].first.pairs[i].second
+void linAlg_t::weightedInnerProds(const dlong N, deviceMemory<dfloat> o_w,
+                                  const std::vector<innerProdPair_t>& pairs,
+                                  memory<dfloat> dots, comm_t comm) {
+  const int Ndots = static_cast<int>(pairs.size());
+  if (Ndots==0) return;
+
+  LIBP_ABORT("linAlg_t::weightedInnerProds output has " << dots.length()
+             << " entries for " << Ndots << " products",
+             dots.length() < static_cast<size_t>(Ndots));
+
+  if (hostMode) {
+    HostInnerProds(N, o_w.ptr(), pairs, dots.ptr());
+    comm.Allreduce(dots, Comm::Sum, Ndots);
+    return;
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  ReserveDots(Ndots);
+
+  for (int n=0;n<Ndots;n+=maxProds) {
+    const int Nprods = std::min(maxProds, Ndots-n);
+    const innerProdPair_t& p0 = pairs[n];
+    const innerProdPair_t& p1 = pairs[n+std::min(1, Nprods-1)];
+    const innerProdPair_t& p2 = pairs[n+std::min(2, Nprods-1)];
+    const innerProdPair_t& p3 = pairs[n+std::min(3, Nprods-1)];
+    weightedInnerProdsKernel1[Nprods-1](Nblock, N, o_w,
+                                        p0.first, p0.second, p1.first, p1.second,
+                                        p2.first, p2.second, p3.first, p3.second,
+                                        o_dots + n*Nblock);
+  }
+
+  ReduceDots(Ndots, Nblock, dots, comm);
+}
+
+//up to maxProds pairs per pass. Pointers past the end of the batch are
+// padded with the last pair, and never read
+void linAlg_t::LaunchInnerProds(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                                const int Nblock) {
+  const int Ndots = static_cast<int>(pairs.size());
+  for (int n=0;n<Ndots;n+=maxProds) {
+    const int Nprods = std::min(maxProds, Ndots-n);
+    const innerProdPair_t& p0 = pairs[n];
+    const innerProdPair_t& p1 = pairs[n+std::min(1, Nprods-1)];
+    const innerProdPair_t& p2 = pairs[n+std::min(2, Nprods-1)];
+    const innerProdPair_t& p3 = pairs[n+std::min(3, Nprods-1)];
+    innerProdsKernel1[Nprods-1](Nblock, N,
+                                p0.first, p0.second, p1.first, p1.second,
+                                p2.first, p2.second, p3.first, p3.second,
+                                o_dots + n*Nblock);
+  }
+}
+
+//host version of the batched products, maxProds pairs per pass
+void linAlg_t::HostInnerProds(const dlong N, const dfloat* w,
+                              const std::vector<innerProdPair_t>& pairs, dfloat* dots) {
+  const int Ndots = static_cast<int>(pairs.size());
+  for (int n=0;n<Ndots;n+=maxProds) {
+    const int Nprods = std::min(maxProds, Ndots-n);
+
+    const dfloat* x[maxProds];
+    const dfloat* y[maxProds];
+    for (int p=0;p<Nprods;p++) {
+      x[p] = pairs[n+p].first.ptr();
+      y[p] = pairs[n+p].second.ptr();
+    }
+
+    switch (Nprods) {
+      case 1: HostDots<1>(N, w, x, y, dots+n, hostThreads); break;
+      case 2: HostDots<2>(N, w, x, y, dots+n, hostThreads); break;
+      case 3: HostDots<3>(N, w, x, y, dots+n, hostThreads); break;
+      default: HostDots<4>(N, w, x, y, dots+n, hostThreads); break;
+    }
+  }
+}
+
+//grow the batched reduction scratch to hold Ndots partial sums per block
+void linAlg_t::ReserveDots(const int Ndots) {
+  const size_t Nscratch = static_cast<size_t>(Ndots)*(blocksize+1);
+  if (o_dots.length() < Nscratch) {
+    o_dots = platform->malloc<dfloat>(Nscratch);
+  }
+  if (h_dots.length() < static_cast<size_t>(Ndots)) {
+    h_dots = platform->hostMalloc<dfloat>(Ndots);
+  }
+}
+
+//sum the blocks' partial products, then one copy and one Allreduce for
+// the batch
+void linAlg_t::ReduceDots(const int Ndots, const int Nblock,
+                          memory<dfloat> dots, comm_t comm) {
+  deviceMemory<dfloat> o_sums = o_dots + Ndots*Nblock;
+  innerProdsKernel2(Nblock, Ndots, o_dots, o_sums);
+
+  h_dots.copyFrom(o_sums, Ndots, 0, properties_t("async", true));
+  platform->finish();
+
+  for (int n=0;n<Ndots;n++) dots[n] = h_dots[n];
+  comm.Allreduce(dots, Comm::Sum, Ndots);
+}
+
+/*****************************/
+/* non-blocking reductions   */
+/*****************************/
+
+// o_x.o_y
+linAlgReduction_t linAlg_t::innerProdAsync(const dlong N, deviceMemory<dfloat> o_x,
+                                           deviceMemory<dfloat> o_y, comm_t comm) {
+  if (hostMode) {
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    memory<dfloat> dot(1);
+    dfloat localdot = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:localdot) if(hostThreads)
+    for (dlong n=0;n<N;n++) localdot += x[n]*y[n];
+    dot[0] = localdot;
+    return StartReduction(dot, false, comm);
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  innerProdKernel1(Nblock, N, o_x, o_y, o_scratch);
+  innerProdKernel2(Nblock, o_scratch);
+
+  return StartReduction(o_scratch, 1, false, comm);
+}
+
+// ||o_a||_2
+linAlgReduction_t linAlg_t::norm2Async(const dlong N, deviceMemory<dfloat> o_a, comm_t comm) {
+  if (hostMode) {
+    const dfloat* a = o_a.ptr();
+    memory<dfloat> dot(1);
+    dfloat localdot = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:localdot) if(hostThreads)
+    for (dlong n=0;n<N;n++) localdot += a[n]*a[n];
+    dot[0] = localdot;
+    return StartReduction(dot, true, comm);
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  norm2Kernel1(Nblock, N, o_a, o_scratch);
+  norm2Kernel2(Nblock, o_scratch);
+
+  return StartReduction(o_scratch, 1, true, comm);
+}
+
+// o_w.o_x.o_y
+linAlgReduction_t linAlg_t::weightedInnerProdAsync(const dlong N, deviceMemory<dfloat> o_w,
+                                                   deviceMemory<dfloat> o_x, deviceMemory<dfloat> o_y,
+                                                   comm_t comm) {
+  if (hostMode) {
+    const dfloat* w = o_w.ptr();
+    const dfloat* x = o_x.ptr();
+    const dfloat* y = o_y.ptr();
+    memory<dfloat> dot(1);
+    dfloat localdot = 0.0;
+    #pragma omp parallel for simd schedule(static) reduction(+:localdot) if(hostThreads)
+    for (dlong n=0;n<N;n++) localdot += w[n]*x[n]*y[n];
+    dot[0] = localdot;
+    return StartReduction(dot, false, comm);
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  weightedInnerProdKernel1(Nblock, N, o_w, o_x, o_y, o_scratch);
+  weightedInnerProdKernel2(Nblock, o_scratch);
+
+  return StartReduction(o_scratch, 1, false, comm);
+}
+
+// pairs[i].first.pairs[i].second
+linAlgReduction_t linAlg_t::innerProdsAsync(const dlong N, const std::vector<innerProdPair_t>& pairs,
+                                            comm_t comm) {
+  const int Ndots = static_cast<int>(pairs.size());
+  LIBP_ABORT("linAlg_t::innerProdsAsync called with no pairs",
+             Ndots==0);
+
+  if (hostMode) {
+    memory<dfloat> dots(Ndots);
+    HostInnerProds(N, nullptr, pairs, dots.ptr());
+    return StartReduction(dots, false, comm);
+  }
+
+  int Nblock = (N+blocksize-1)/blocksize;
+  Nblock = (Nblock>blocksize) ? blocksize : Nblock; //limit to blocksize entries
+
+  ReserveDots(Ndots);
+  LaunchInnerProds(N, pairs, Nblock);
+
+  deviceMemory<dfloat> o_sums = o_dots + Ndots*Nblock;
+  innerProdsKernel2(Nblock, Ndots, o_dots, o_sums);
+
+  return StartReduction(o_sums, Ndots, false, comm);
+}
+
+//wait for the device result, then start its Allreduce. The handle owns
+// the host buffer, so the shared scratch is free for the next reduction
+linAlgReduction_t linAlg_t::StartReduction(deviceMemory<dfloat> o_result, const int Nvalues,
+                                           const bool norm, comm_t comm) {
+  pinnedMemory<dfloat> h_result = (Nvalues==1) ? h_scratch : h_dots;
+
+  h_result.copyFrom(o_result, Nvalues, 0, properties_t("async", true));
+  platform->finish();
+
+  memory<dfloat> values(Nvalues);
+  for (int n=0;n<Nvalues;n++) values[n] = h_result[n];
+
+  return StartReduction(values, norm, comm);
+}
+
+//start the Allreduce of local values. The handle takes the buffer
+linAlgReduction_t linAlg_t::StartReduction(memory<dfloat> values, const bool norm,
+                                           comm_t comm) {
+  linAlgReduction_t reduction;
+  reduction.comm = comm;
+  reduction.norm = norm;
+  reduction.values = values;
+
+  comm.Iallreduce(reduction.values, Comm::Sum,
+                  static_cast<int>(values.length()), reduction.request);
+  reduction.pending = true;
+
+  return reduction;
+}
+
+linAlgReduction_t::linAlgReduction_t(linAlgReduction_t&& other):
+  comm(other.comm),
+  request(other.request),
+  values(other.values),
+  pending(other.pending),
+  norm(other.norm) {
+  other.pending = false;
+}
+
+linAlgReduction_t& linAlgReduction_t::operator=(linAlgReduction_t&& other) {
+  if (this != &other) {
+    if (pending) comm.Wait(request);
+    comm = other.comm;
+    request = other.request;
+    values = other.values;
+    pending = other.pending;
+    norm = other.norm;
+    other.pending = false;
+  }
+  return *this;
+}
+
+linAlgReduction_t::~linAlgReduction_t() {
+  if (pending) comm.Wait(request);
+}
+
+dfloat linAlgReduction_t::Wait() {
+  LIBP_ABORT("linAlgReduction_t::Wait called on an empty handle",
+             values.length()==0);
+
+  if (pending) {
+    comm.Wait(request);
+    pending = false;
+  }
+  return norm ? sqrt(values[0]) : values[0];
+}
+
+void linAlgReduction_t::Wait(memory<dfloat> dots) {
+  LIBP_ABORT("linAlgReduction_t::Wait output has " << dots.length()
+             << " entries for " << values.length() << " values",
+             dots.length() < values.length());
+
+  if (pending) {
+    comm.Wait(request);
+    pending = false;
+  }
+  for (size_t n=0;n<values.length();n++) {
+    dots[n] = norm ? sqrt(values[n]) : values[n];
+  }
+}
+
 } //namespace libp
@@ -37,6 +37,12 @@ void linAlg_t::Setup(platform_t *_platform) {
   platform = _platform;
   kernelInfo = platform->props();
 
+  //Serial and OpenMP memory lives on the host, so skip the kernels and
+  // work on it directly
+  const std::string mode = platform->device.mode();
+  hostMode = (mode=="Serial" || mode=="OpenMP");
+  hostThreads = (mode=="OpenMP");
+
   //add defines
   kernelInfo["defines/" "p_blockSize"] = blocksize;
   kernelInfo["defines/init_dfloat_min"] =  std::numeric_limits<dfloat>::max();
@@ -50,155 +56,202 @@ void linAlg_t::Setup(platform_t *_platform) {
 //initialize list of kernels
 void linAlg_t::InitKernels(std::vector<std::string> kernels) {
 
+  //host loops need no kernels
+  if (hostMode) return;
+
+  std::vector<kernelBuild_t> builds;
+  bool prods2Queued = false;
+
   for (size_t i=0;i<kernels.size();i++) {
     std::string name = kernels[i];
     if (name=="set") {
       if (setKernel.isInitialized()==false)
-        setKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgSet.okl",
-                                        "set",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgSet.okl",
+                          "set",
+                          kernelInfo, &setKernel});
     } else if (name=="add") {
       if (addKernel.isInitialized()==false)
-        addKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAdd.okl",
-                                        "add",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAdd.okl",
+                          "add",
+                          kernelInfo, &addKernel});
     } else if (name=="scale") {
       if (scaleKernel.isInitialized()==false)
-        scaleKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgScale.okl",
-                                        "scale",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgScale.okl",
+                          "scale",
+                          kernelInfo, &scaleKernel});
     } else if (name=="axpy") {
       if (axpyKernel.isInitialized()==false)
-        axpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAXPY.okl",
-                                        "axpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAXPY.okl",
+                          "axpy",
+                          kernelInfo, &axpyKernel});
     } else if (name=="zaxpy") {
       if (zaxpyKernel.isInitialized()==false)
-        zaxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAXPY.okl",
-                                        "zaxpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAXPY.okl",
+                          "zaxpy",
+                          kernelInfo, &zaxpyKernel});
     } else if (name=="amx") {
       if (amxKernel.isInitialized()==false)
-        amxKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAMXPY.okl",
-                                        "amx",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAMXPY.okl",
+                          "amx",
+                          kernelInfo, &amxKernel});
     } else if (name=="amxpy") {
       if (amxpyKernel.isInitialized()==false)
-        amxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAMXPY.okl",
-                                        "amxpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAMXPY.okl",
+                          "amxpy",
+                          kernelInfo, &amxpyKernel});
     } else if (name=="zamxpy") {
       if (zamxpyKernel.isInitialized()==false)
-        zamxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgAMXPY.okl",
-                                        "zamxpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgAMXPY.okl",
+                          "zamxpy",
+                          kernelInfo, &zamxpyKernel});
     } else if (name=="adx") {
       if (adxKernel.isInitialized()==false)
-        adxKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgADXPY.okl",
-                                        "adx",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgADXPY.okl",
+                          "adx",
+                          kernelInfo, &adxKernel});
     } else if (name=="adxpy") {
       if (adxpyKernel.isInitialized()==false)
-        adxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgADXPY.okl",
-                                        "adxpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgADXPY.okl",
+                          "adxpy",
+                          kernelInfo, &adxpyKernel});
     } else if (name=="zadxpy") {
       if (zadxpyKernel.isInitialized()==false)
-        zadxpyKernel = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgADXPY.okl",
-                                        "zadxpy",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgADXPY.okl",
+                          "zadxpy",
+                          kernelInfo, &zadxpyKernel});
     } else if (name=="min") {
       if (minKernel1.isInitialized()==false) {
-        minKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgMin.okl",
-                                        "min1",
-                                        kernelInfo);
-        minKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgMin.okl",
-                                        "min2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgMin.okl",
+                          "min1",
+                          kernelInfo, &minKernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgMin.okl",
+                          "min2",
+                          kernelInfo, &minKernel2});
       }
     } else if (name=="max") {
       if (maxKernel1.isInitialized()==false) {
-        maxKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgMax.okl",
-                                        "max1",
-                                        kernelInfo);
-        maxKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgMax.okl",
-                                        "max2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgMax.okl",
+                          "max1",
+                          kernelInfo, &maxKernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgMax.okl",
+                          "max2",
+                          kernelInfo, &maxKernel2});
       }
     } else if (name=="sum") {
       if (sumKernel1.isInitialized()==false) {
-        sumKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgSum.okl",
-                                        "sum1",
-                                        kernelInfo);
-        sumKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgSum.okl",
-                                        "sum2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgSum.okl",
+                          "sum1",
+                          kernelInfo, &sumKernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgSum.okl",
+                          "sum2",
+                          kernelInfo, &sumKernel2});
       }
     } else if (name=="norm2") {
       if (norm2Kernel1.isInitialized()==false) {
-        norm2Kernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgNorm2.okl",
-                                        "norm2_1",
-                                        kernelInfo);
-        norm2Kernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgNorm2.okl",
-                                        "norm2_2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgNorm2.okl",
+                          "norm2_1",
+                          kernelInfo, &norm2Kernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgNorm2.okl",
+                          "norm2_2",
+                          kernelInfo, &norm2Kernel2});
       }
     } else if (name=="weightedNorm2") {
       if (weightedNorm2Kernel1.isInitialized()==false) {
-        weightedNorm2Kernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgWeightedNorm2.okl",
-                                        "weightedNorm2_1",
-                                        kernelInfo);
-        weightedNorm2Kernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgWeightedNorm2.okl",
-                                        "weightedNorm2_1",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgWeightedInnerProd.okl",
+                          "weightedNorm2_1",
+                          kernelInfo, &weightedNorm2Kernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgWeightedInnerProd.okl",
+                          "weightedNorm2_2",
+                          kernelInfo, &weightedNorm2Kernel2});
       }
     } else if (name=="innerProd") {
       if (innerProdKernel1.isInitialized()==false) {
-        innerProdKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgInnerProd.okl",
-                                        "innerProd1",
-                                        kernelInfo);
-        innerProdKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgInnerProd.okl",
-                                        "innerProd2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgInnerProd.okl",
+                          "innerProd1",
+                          kernelInfo, &innerProdKernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgInnerProd.okl",
+                          "innerProd2",
+                          kernelInfo, &innerProdKernel2});
       }
     } else if (name=="weightedInnerProd") {
       if (weightedInnerProdKernel1.isInitialized()==false) {
-        weightedInnerProdKernel1 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgWeightedInnerProd.okl",
-                                        "weightedInnerProd1",
-                                        kernelInfo);
-        weightedInnerProdKernel2 = platform->buildKernel(LINALG_DIR "/okl/"
-                                        "linAlgWeightedInnerProd.okl",
-                                        "weightedInnerProd2",
-                                        kernelInfo);
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgWeightedInnerProd.okl",
+                          "weightedInnerProd1",
+                          kernelInfo, &weightedInnerProdKernel1});
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgWeightedInnerProd.okl",
+                          "weightedInnerProd2",
+                          kernelInfo, &weightedInnerProdKernel2});
+      }
+    } else if (name=="innerProds" || name=="weightedInnerProds") {
+      const bool weighted = (name=="weightedInnerProds");
+      kernel_t *kernels1 = weighted ? weightedInnerProdsKernel1 : innerProdsKernel1;
+      if (kernels1[0].isInitialized()==false) {
+        //one variant per number of pairs reduced in a pass
+        for (int n=0;n<maxProds;n++) {
+          properties_t prodsInfo = kernelInfo;
+          prodsInfo["defines/" "p_Nprods"] = n+1;
+          builds.push_back({LINALG_DIR "/okl/"
+                            "linAlgInnerProds.okl",
+                            weighted ? "weightedInnerProds1" : "innerProds1",
+                            prodsInfo, kernels1+n});
+        }
+      }
+      if (innerProdsKernel2.isInitialized()==false && !prods2Queued) {
+        prods2Queued = true;
+        properties_t prodsInfo = kernelInfo;
+        prodsInfo["defines/" "p_Nprods"] = 1;
+        builds.push_back({LINALG_DIR "/okl/"
+                          "linAlgInnerProds.okl",
+                          "innerProds2",
+                          prodsInfo, &innerProdsKernel2});
       }
     } else {
       LIBP_FORCE_ABORT("Requested linAlg routine \"" << name << "\" not found");
     }
   }
+
+  platform->buildKernels(builds);
+
+  //modelled bytes and flops per entry of the streaming kernels, for
+  // "KERNEL STATS". The reductions are launched on blocks, not entries,
+  // so they are left unmodelled
+  constexpr double w = sizeof(dfloat);
+  setKernel.setModel(1*w, 0);
+  addKernel.setModel(2*w, 1);
+  scaleKernel.setModel(2*w, 1);
+  axpyKernel.setModel(3*w, 3);
+  zaxpyKernel.setModel(3*w, 3);
+  amxKernel.setModel(3*w, 2);
+  amxpyKernel.setModel(4*w, 4);
+  zamxpyKernel.setModel(4*w, 4);
+  adxKernel.setModel(3*w, 2);
+  adxpyKernel.setModel(4*w, 4);
+  zadxpyKernel.setModel(4*w, 4);
 }
 
 } //namespace libp
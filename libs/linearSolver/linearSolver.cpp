@@ -36,6 +36,8 @@ int linearSolver_t::Solve(operator_t& linearOperator,
                           const int MAXIT,
                           const int verbose) {
   assertInitialized();
+  LIBP_PROFILE("linear solve");
+
   ig->FormInitialGuess(o_x, o_rhs);
   int iters = ls->Solve(linearOperator, precon, o_x, o_rhs, tol, MAXIT, verbose);
   ig->Update(linearOperator, o_x, o_rhs);
@@ -124,6 +124,7 @@ int nbfpcg::Solve(operator_t& linearOperator, operator_t& precon,
   int iter;
   beta0 = 0;
   for(iter=0;iter<MAXIT;++iter){
+    LIBP_PROFILE("iteration");
 
     //exit if tolerance is reached
     if(rdotr0<=TOL) break;
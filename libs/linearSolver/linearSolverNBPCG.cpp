@@ -114,6 +114,7 @@ int nbpcg::Solve(operator_t& linearOperator, operator_t& precon,
   int iter;
   beta0 = 0;
   for(iter=0;iter<MAXIT;++iter){
+    LIBP_PROFILE("iteration");
 
     //exit if tolerance is reached
     if(rdotr0<=TOL) break;
@@ -36,7 +36,7 @@ pcg::pcg(dlong _N, dlong _Nhalo,
          platform_t& _platform, settings_t& _settings, comm_t _comm):
   linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
 
-  platform.linAlg().InitKernels({"axpy", "innerProd", "norm2"});
+  platform.linAlg().InitKernels({"axpy", "innerProd", "innerProds", "norm2"});
 
   dlong Ntotal = N + Nhalo;
 
@@ -77,16 +77,23 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
   dfloat alpha = 0.0, beta = 0.0, pAp = 0.0;
   dfloat rdotr0 = 0.0;
   dfloat TOL = 0.0;
+  memory<dfloat> dots(2);
 
-  // Comput norm of RHS (for stopping tolerance).
+  // Comput norm of RHS (for stopping tolerance), overlapping its
+  // reduction with A*x
+  linAlgReduction_t normbReduction;
   if (settings.compareSetting("LINEAR SOLVER STOPPING CRITERION", "ABS/REL-RHS-2NORM")) {
-    dfloat normb = linAlg.norm2(N, o_r, comm);
-    TOL = std::max(tol*tol*normb*normb, tol*tol);
+    normbReduction = linAlg.norm2Async(N, o_r, comm);
   }
 
   // compute A*x
   linearOperator.Operator(o_x, o_Ax);
 
+  if (normbReduction.isPending()) {
+    dfloat normb = normbReduction.Wait();
+    TOL = std::max(tol*tol*normb*normb, tol*tol);
+  }
+
   // subtract r = r - A*x
   linAlg.axpy(N, -1.f, o_Ax, 1.f, o_r);
 
@@ -102,6 +109,7 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
 
   int iter;
   for(iter=0;iter<MAXIT;++iter){
+    LIBP_PROFILE("iteration");
 
     // Exit if tolerance is reached, taking at least one step.
     if (((iter == 0) && (rdotr0 == 0.0)) ||
@@ -114,12 +122,15 @@ int pcg::Solve(operator_t& linearOperator, operator_t& precon,
 
     // r.z
     rdotz2 = rdotz1;
-    rdotz1 = linAlg.innerProd(N, o_r, o_z, comm);
 
     if(flexible){
-      dfloat zdotAp = linAlg.innerProd(N, o_z, o_Ap, comm);
+      // r.z and z.Ap in one reduction
+      linAlg.innerProds(N, {{o_r, o_z}, {o_z, o_Ap}}, dots, comm);
+      rdotz1 = dots[0];
+      dfloat zdotAp = dots[1];
       beta = (iter==0) ? 0.0 : -alpha*zdotAp/rdotz2;
     } else {
+      rdotz1 = linAlg.innerProd(N, o_r, o_z, comm);
       beta = (iter==0) ? 0.0 : rdotz1/rdotz2;
     }
 
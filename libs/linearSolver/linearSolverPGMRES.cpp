@@ -38,7 +38,7 @@ pgmres::pgmres(dlong _N, dlong _Nhalo,
 
   // Make sure LinAlg has the necessary kernels
   platform.linAlg().InitKernels({"axpy", "zaxpy",
-                               "innerProd", "norm2"});
+                               "innerProds", "norm2"});
 
   dlong Ntotal = N + Nhalo;
 
@@ -58,6 +58,7 @@ pgmres::pgmres(dlong _N, dlong _Nhalo,
   cs.malloc(restart);
   s.malloc(restart+1);
   y.malloc(restart);
+  h.malloc(restart+1);
 
   /*aux variables */
   o_Ax = platform.malloc<dfloat>(dummy);
@@ -104,23 +105,41 @@ int pgmres::Solve(operator_t& linearOperator, operator_t& precon,
 
     //Construct orthonormal basis via Gram-Schmidt
     for(int i=0;i<restart;++i){
+      LIBP_PROFILE("iteration");
+
       // compute z = A*V(:,i)
       linearOperator.Operator(o_V[i], o_z);
 
       // r = Precon^{-1} z
       precon.Operator(o_z, o_r);
 
-      for(int k=0; k<=i; ++k){
-        dfloat hki = linAlg.innerProd(N, o_r, o_V[k], comm);
+      // Classical Gram-Schmidt applied twice. Each pass takes the products
+      // with every basis vector in one reduction, and the second pass also
+      // takes r.r, so the norm of the result needs no reduction of its own
+      std::vector<linAlg_t::innerProdPair_t> pairs(i+1);
+      for(int k=0; k<=i; ++k) pairs[k] = {o_r, o_V[k]};
 
+      linAlg.innerProds(N, pairs, h, comm);
+      for(int k=0; k<=i; ++k){
         // r = r - hki*V[k]
-        linAlg.axpy(N, -hki, o_V[k], 1.0, o_r);
+        linAlg.axpy(N, -h[k], o_V[k], 1.0, o_r);
 
         // H(k,i) = hki
-        H[k + i*(restart+1)] = hki;
+        H[k + i*(restart+1)] = h[k];
+      }
+
+      pairs.push_back({o_r, o_r});
+      linAlg.innerProds(N, pairs, h, comm);
+      dfloat rdotr = h[i+1];
+      for(int k=0; k<=i; ++k){
+        linAlg.axpy(N, -h[k], o_V[k], 1.0, o_r);
+        H[k + i*(restart+1)] += h[k];
+
+        // the V[k] are orthonormal, so ||r - h V||^2 = r.r - h.h
+        rdotr -= h[k]*h[k];
       }
 
-      dfloat nw = linAlg.norm2(N, o_r, comm);
+      dfloat nw = sqrt(std::max(rdotr, static_cast<dfloat>(0.0)));
       H[i+1 + i*(restart+1)] = nw;
 
       // V(:,i+1) = r/nw
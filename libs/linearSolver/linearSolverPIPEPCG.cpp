@@ -0,0 +1,233 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linearSolver.hpp"
+
+namespace libp {
+
+namespace LinearSolver {
+
+#define PIPEPCG_BLOCKSIZE 512
+
+pipepcg::pipepcg(dlong _N, dlong _Nhalo,
+         platform_t& _platform, settings_t& _settings, comm_t _comm):
+  linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
+
+  platform.linAlg().InitKernels({"axpy", "innerProds"});
+
+  dlong Ntotal = N + Nhalo;
+
+  replacement = 0;
+  if (settings.hasSetting("PIPEPCG RESIDUAL REPLACEMENT"))
+    settings.getSetting("PIPEPCG RESIDUAL REPLACEMENT", replacement);
+
+  memory<dfloat> dummy(Ntotal, 0.0);
+
+  /*aux variables */
+  o_u = platform.malloc<dfloat>(Ntotal, dummy);
+  o_w = platform.malloc<dfloat>(Ntotal, dummy);
+  o_m = platform.malloc<dfloat>(Ntotal, dummy);
+  o_n = platform.malloc<dfloat>(Ntotal, dummy);
+  o_z = platform.malloc<dfloat>(Ntotal, dummy);
+  o_q = platform.malloc<dfloat>(Ntotal, dummy);
+  o_s = platform.malloc<dfloat>(Ntotal, dummy);
+  o_p = platform.malloc<dfloat>(Ntotal, dummy);
+
+  //copy of the right hand side for recomputing the true residual
+  if (replacement>0)
+    o_b = platform.malloc<dfloat>(Ntotal, dummy);
+
+  //pinned tmp buffer for reductions
+  dots = platform.hostMalloc<dfloat>(3*PIPEPCG_BLOCKSIZE);
+  o_dots = platform.malloc<dfloat>(3*PIPEPCG_BLOCKSIZE);
+
+  /* build kernels */
+  properties_t kernelInfo = platform.props(); //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)PIPEPCG_BLOCKSIZE;
+
+  // fused PIPEPCG update kernel
+  updatePIPEPCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdatePIPEPCG.okl",
+                                "updatePIPEPCG", kernelInfo);
+}
+
+/*Each iteration starts one Allreduce of r.u, w.u and r.r, and hides it
+  behind both the preconditioner and the operator, m = M*w and n = A*m.
+  The recurrences for p, s = A*p, q = M*s and z = A*q then update every
+  vector in one fused pass.*/
+int pipepcg::Solve(operator_t& linearOperator, operator_t& precon,
+                   deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                   const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank = comm.rank();
+  linAlg_t &linAlg = platform.linAlg();
+
+  // register scalars
+  dfloat alpha0 = 0;
+  dfloat beta0  = 0;
+  dfloat gamma0 = 0;
+  dfloat delta0 = 0;
+  dfloat rdotr0 = 0;
+
+  dfloat gamma1 = 0; // history gamma
+  dfloat alpha1 = 0; // history alpha
+
+  dfloat TOL = 0;
+
+  if (replacement>0) o_b.copyFrom(o_r, N);
+
+  // compute A*x
+  linearOperator.Operator(o_x, o_m);
+
+  // subtract r = r - A*x
+  linAlg.axpy(N, -1.f, o_m, 1.f, o_r);
+
+  // u = M*r, w = A*u
+  precon.Operator(o_r, o_u);
+  linearOperator.Operator(o_u, o_w);
+
+  // set alpha = beta = 0 to get
+  // r.u, w.u, and r.r
+  UpdatePIPEPCG(alpha0, beta0, o_x, o_r);
+
+  int iter;
+  for(iter=0;iter<MAXIT;++iter){
+    LIBP_PROFILE("iteration");
+
+    // m = M*w
+    precon.Operator(o_w, o_m);
+
+    // n = A*m
+    linearOperator.Operator(o_m, o_n);
+
+    // block for r.u, w.u, r.r
+    comm.Wait(request);
+    gamma1 = gamma0;
+    gamma0 = dots[0]; // gamma = r.u
+    delta0 = dots[1]; // delta = w.u
+    rdotr0 = dots[2];
+
+    if (iter==0) {
+      TOL = std::max(tol*tol*rdotr0,tol*tol);
+
+      if (verbose&&(rank==0))
+        printf("PIPEPCG: initial res norm %12.12f \n", sqrt(rdotr0));
+    } else if (verbose&&(rank==0)) {
+      if(rdotr0<0)
+        printf("WARNING PIPEPCG: rdotr = %17.15lf\n", rdotr0);
+
+      printf("PIPEPCG: it %d, r norm %12.12le, gamma = %le delta = %le \n", iter, sqrt(rdotr0), gamma0, delta0);
+    }
+
+    //exit if tolerance is reached
+    if(rdotr0<=TOL) break;
+
+    alpha1 = alpha0;
+    if (iter==0) {
+      beta0  = 0;
+      alpha0 = gamma0/delta0;
+    } else {
+      beta0  = gamma0/gamma1;
+      alpha0 = gamma0/(delta0 - beta0*gamma0/alpha1);
+    }
+
+    // z <= n + beta*z, q <= m + beta*q
+    // s <= w + beta*s, p <= u + beta*p
+    // x <= x + alpha*p, r <= r - alpha*s
+    // u <= u - alpha*q, w <= w - alpha*z
+    // r.u, w.u, r.r
+    UpdatePIPEPCG(alpha0, beta0, o_x, o_r);
+
+    // periodically replace the recurrences by their true values to
+    // limit the drift of r from b - A*x
+    if (replacement>0 && (iter+1)%replacement==0 && iter+1<MAXIT) {
+      ReplaceResidual(linearOperator, precon, o_x, o_r);
+    }
+  }
+
+  // the last reduction is still in flight if MAXIT was reached
+  comm.Wait(request);
+
+  return iter;
+}
+
+void pipepcg::UpdatePIPEPCG(const dfloat alpha, const dfloat beta,
+                            deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r){
+
+  int Nblocks = (N+PIPEPCG_BLOCKSIZE-1)/PIPEPCG_BLOCKSIZE;
+  Nblocks = (Nblocks>PIPEPCG_BLOCKSIZE) ? PIPEPCG_BLOCKSIZE : Nblocks; //limit to PIPEPCG_BLOCKSIZE entries
+
+  updatePIPEPCGKernel(N, Nblocks, alpha, beta,
+                      o_m, o_n, o_z, o_q, o_s, o_p,
+                      o_x, o_r, o_u, o_w, o_dots);
+
+  if (Nblocks>0) {
+    dots.copyFrom(o_dots, 3*Nblocks);
+  } else {
+    dots[0] = 0.0;
+    dots[1] = 0.0;
+    dots[2] = 0.0;
+  }
+
+  for(int n=1;n<Nblocks;++n) {
+    dots[0] += dots[0+3*n];
+    dots[1] += dots[1+3*n];
+    dots[2] += dots[2+3*n];
+  }
+  comm.Iallreduce(dots, Comm::Sum, 3, request);
+}
+
+// r = b - A*x, u = M*r, w = A*u, s = A*p, q = M*s, z = A*q
+void pipepcg::ReplaceResidual(operator_t& linearOperator, operator_t& precon,
+                              deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r){
+
+  // the fused update's reduction is superseded. The completed request
+  // is left null, so the next iteration's Wait returns at once
+  comm.Wait(request);
+
+  linearOperator.Operator(o_x, o_m);
+  o_r.copyFrom(o_b, N);
+  platform.linAlg().axpy(N, -1.f, o_m, 1.f, o_r);
+
+  precon.Operator(o_r, o_u);
+  linearOperator.Operator(o_u, o_w);
+
+  linearOperator.Operator(o_p, o_s);
+  precon.Operator(o_s, o_q);
+  linearOperator.Operator(o_q, o_z);
+
+  memory<dfloat> rdots(3);
+  platform.linAlg().innerProds(N, {{o_r, o_u}, {o_w, o_u}, {o_r, o_r}}, rdots, comm);
+
+  dots[0] = rdots[0];
+  dots[1] = rdots[1];
+  dots[2] = rdots[2];
+}
+
+} //namespace LinearSolver
+
+} //namespace libp
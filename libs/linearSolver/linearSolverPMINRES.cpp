@@ -81,6 +81,8 @@ int pminres::Solve(operator_t& linearOperator, operator_t& precon,
   // MINRES iteration loop.
   iter = 0;
   while (iter < MAXIT) {
+    LIBP_PROFILE("iteration");
+
     if (verbose && (rank == 0)) {
       printf("PMINRES:  it %3d  eta = % .15e, gamma = %.15e\n", iter, eta, gam);
     }
@@ -0,0 +1,351 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "linearSolver.hpp"
+
+namespace libp {
+
+namespace LinearSolver {
+
+#define SSTEPCG_BLOCKSIZE 256
+
+namespace {
+
+dfloat Dot(const int N, const memory<dfloat> x, const memory<dfloat> y) {
+  dfloat dot = 0.0;
+  for (int n=0;n<N;n++) dot += x[n]*y[n];
+  return dot;
+}
+
+// y = A*x, A column major
+void MatVec(const int N, const memory<dfloat> A, const memory<dfloat> x, memory<dfloat> y) {
+  for (int n=0;n<N;n++) y[n] = 0.0;
+  for (int m=0;m<N;m++) {
+    for (int n=0;n<N;n++) y[n] += A[n+m*N]*x[m];
+  }
+}
+
+} //namespace
+
+sstepcg::sstepcg(dlong _N, dlong _Nhalo,
+         platform_t& _platform, settings_t& _settings, comm_t _comm):
+  linearSolverBase_t(_N, _Nhalo, _platform, _settings, _comm) {
+
+  platform.linAlg().InitKernels({"axpy", "scale", "norm2", "innerProds"});
+
+  s = 4;
+  if (settings.hasSetting("SSTEPCG STEPS"))
+    settings.getSetting("SSTEPCG STEPS", s);
+
+  LIBP_ABORT("SSTEPCG STEPS must be at least 1, not " << s,
+             s<1);
+
+  chebyshev = true;
+  if (settings.hasSetting("SSTEPCG BASIS"))
+    chebyshev = settings.compareSetting("SSTEPCG BASIS", "CHEBYSHEV");
+
+  Ncols = 2*s+1;
+
+  dlong Ntotal = N + Nhalo;
+
+  memory<dfloat> dummy(Ncols*Ntotal, 0.0);
+
+  /*Krylov basis and its image under A*/
+  o_Y = platform.malloc<dfloat>(Ncols*Ntotal, dummy);
+  o_W = platform.malloc<dfloat>(Ncols*Ntotal, dummy);
+
+  /*aux variables */
+  o_Ax = platform.malloc<dfloat>(Ntotal, dummy);
+  o_t  = platform.malloc<dfloat>(Ntotal, dummy);
+
+  coeffs.malloc(3*Ncols);
+  o_coeffs = platform.malloc<dfloat>(3*Ncols);
+
+  basisAlpha.malloc(s+1);
+  basisBeta.malloc(s+1);
+  basisGamma.malloc(s+1);
+
+  G.malloc(Ncols*Ncols);
+  T.malloc(Ncols*Ncols);
+  g.malloc(Ncols);
+  a.malloc(Ncols);
+  c.malloc(Ncols);
+  d.malloc(Ncols);
+  Gv.malloc(Ncols);
+  Td.malloc(Ncols);
+
+  /* build kernels */
+  properties_t kernelInfo = platform.props(); //copy base properties
+
+  //add defines
+  kernelInfo["defines/" "p_blockSize"] = (int)SSTEPCG_BLOCKSIZE;
+  kernelInfo["defines/" "p_s"] = s;
+  kernelInfo["defines/" "p_Ncols"] = Ncols;
+
+  // basis recombination kernel
+  updateSSTEPCGKernel = platform.buildKernel(LINEARSOLVER_DIR "/okl/linearSolverUpdateSSTEPCG.okl",
+                                "updateSSTEPCG", kernelInfo);
+}
+
+/*Each outer step builds the 2s+1 basis vectors with the operator and
+  preconditioner, then reduces the Gram matrix Y^T*A*Y, Y^T*r and r.r in
+  one batched reduction. The s CG iterations then run on the host in the
+  coordinates of the basis, and one kernel applies them to x, r, p and z.*/
+int sstepcg::Solve(operator_t& linearOperator, operator_t& precon,
+                   deviceMemory<dfloat>& o_x, deviceMemory<dfloat>& o_r,
+                   const dfloat tol, const int MAXIT, const int verbose) {
+
+  int rank = comm.rank();
+  linAlg_t &linAlg = platform.linAlg();
+
+  dlong Ntotal = N + Nhalo;
+
+  deviceMemory<dfloat> o_p = o_Y;
+  deviceMemory<dfloat> o_z = o_Y + (s+1)*Ntotal;
+
+  // compute A*x
+  linearOperator.Operator(o_x, o_Ax);
+
+  // subtract r = r - A*x
+  linAlg.axpy(N, -1.f, o_Ax, 1.f, o_r);
+
+  // z = M*r, p = z
+  precon.Operator(o_r, o_z);
+  o_p.copyFrom(o_z, N);
+
+  if (chebyshev && lambdaMax==0) EstimateSpectrum(linearOperator, precon);
+  SetupBasis();
+
+  //products reduced per outer step: the upper triangle of Y^T*W, Y^T*r,
+  // and r.r
+  std::vector<linAlg_t::innerProdPair_t> pairs;
+  for (int j=0;j<Ncols;j++) {
+    for (int i=0;i<=j;i++) {
+      pairs.push_back({o_Y + i*Ntotal, o_W + j*Ntotal});
+    }
+  }
+  for (int i=0;i<Ncols;i++) {
+    pairs.push_back({o_Y + i*Ntotal, o_r});
+  }
+  pairs.push_back({o_r, o_r});
+
+  memory<dfloat> dots(pairs.size());
+
+  dfloat rdotr = 0.0;
+  dfloat TOL = 0.0;
+
+  int iter = 0;
+  while (true) {
+    LIBP_PROFILE("s-step");
+
+    if (iter>=MAXIT) break;
+
+    BuildBasis(linearOperator, precon);
+
+    linAlg.innerProds(N, pairs, dots, comm);
+
+    int k=0;
+    for (int j=0;j<Ncols;j++) {
+      for (int i=0;i<=j;i++) {
+        G[i+j*Ncols] = dots[k];
+        G[j+i*Ncols] = dots[k];
+        k++;
+      }
+    }
+    for (int i=0;i<Ncols;i++) g[i] = dots[k++];
+    rdotr = dots[k];
+
+    if (iter==0) {
+      TOL = std::max(tol*tol*rdotr,tol*tol);
+
+      if (verbose&&(rank==0))
+        printf("SSTEPCG: initial res norm %12.12f \n", sqrt(rdotr));
+    } else if (verbose&&(rank==0)) {
+      if(rdotr<0)
+        printf("WARNING SSTEPCG: rdotr = %17.15lf\n", rdotr);
+
+      printf("SSTEPCG: it %d, r norm %12.12le\n", iter, sqrt(rdotr));
+    }
+
+    //exit if tolerance is reached
+    if(rdotr<=TOL) break;
+
+    // coordinates of x-x_k, z, and p in the basis
+    for (int i=0;i<Ncols;i++) {
+      a[i] = 0.0;
+      c[i] = 0.0;
+      d[i] = 0.0;
+    }
+    c[s+1] = 1.0;
+    d[0] = 1.0;
+
+    // r.z = (r_k - W*a).(Y*c) = g.c - a.G*c
+    dfloat rdotz = g[s+1];
+
+    for (int j=0;j<s && iter<MAXIT;j++, iter++) {
+      // p.A*p
+      MatVec(Ncols, G, d, Gv);
+      const dfloat pAp = Dot(Ncols, d, Gv);
+
+      const dfloat alpha = rdotz/pAp;
+
+      // x <= x + alpha*p
+      // z <= z - alpha*B*p
+      MatVec(Ncols, T, d, Td);
+      for (int i=0;i<Ncols;i++) {
+        a[i] += alpha*d[i];
+        c[i] -= alpha*Td[i];
+      }
+
+      MatVec(Ncols, G, c, Gv);
+      const dfloat rdotz1 = Dot(Ncols, g, c) - Dot(Ncols, a, Gv);
+
+      const dfloat beta = rdotz1/rdotz;
+      rdotz = rdotz1;
+
+      // p <= z + beta*p
+      for (int i=0;i<Ncols;i++) d[i] = c[i] + beta*d[i];
+    }
+
+    // x <= x + Y*a
+    // r <= r - W*a
+    // p <= Y*d
+    // z <= Y*c
+    for (int i=0;i<Ncols;i++) {
+      coeffs[i]         = a[i];
+      coeffs[i+Ncols]   = c[i];
+      coeffs[i+2*Ncols] = d[i];
+    }
+    o_coeffs.copyFrom(coeffs);
+
+    updateSSTEPCGKernel(N, Ntotal, o_coeffs, o_Y, o_W, o_x, o_r);
+  }
+
+  return iter;
+}
+
+//Power iteration for the largest eigenvalue of M*A, which sets the
+// interval of the Chebyshev basis
+void sstepcg::EstimateSpectrum(operator_t& linearOperator, operator_t& precon) {
+
+  linAlg_t &linAlg = platform.linAlg();
+
+  deviceMemory<dfloat> o_z = o_Y + (s+1)*(N+Nhalo);
+  o_t.copyFrom(o_z, N);
+
+  dfloat norm = linAlg.norm2(N, o_t, comm);
+
+  const int Nsteps = 10;
+  for (int n=0;n<Nsteps && norm>0;n++) {
+    linAlg.scale(N, 1.0/norm, o_t);
+
+    linearOperator.Operator(o_t, o_Ax);
+    precon.Operator(o_Ax, o_t);
+
+    norm = linAlg.norm2(N, o_t, comm);
+  }
+
+  //power iteration approaches the largest eigenvalue from below
+  lambdaMax = 1.1*norm;
+}
+
+//recurrence coefficients of the basis, and the change of basis matrix T
+// with B*Y[:,i] = Y*T[:,i] for every column but the last of each block
+void sstepcg::SetupBasis() {
+
+  if (chebyshev) {
+    //Chebyshev polynomials on [0, lambdaMax]
+    const dfloat lmax = (lambdaMax>0) ? lambdaMax : 1.0;
+    const dfloat center = 0.5*lmax;
+    const dfloat halfWidth = 0.5*lmax;
+
+    for (int i=0;i<=s;i++) {
+      basisAlpha[i] = center;
+      basisBeta[i]  = (i==0) ? 0.0 : 0.5*halfWidth;
+      basisGamma[i] = (i==0) ? halfWidth : 0.5*halfWidth;
+    }
+  } else {
+    for (int i=0;i<=s;i++) {
+      basisAlpha[i] = 0.0;
+      basisBeta[i]  = 0.0;
+      basisGamma[i] = 1.0;
+    }
+  }
+
+  for (int n=0;n<Ncols*Ncols;n++) T[n] = 0.0;
+
+  //p block is columns 0..s, z block is columns s+1..2s
+  for (int i=0;i<s;i++) {
+    T[(i+1)+i*Ncols] = basisGamma[i];
+    T[ i   +i*Ncols] = basisAlpha[i];
+    if (i>0) T[(i-1)+i*Ncols] = basisBeta[i];
+  }
+  for (int i=0;i<s-1;i++) {
+    const int col = s+1+i;
+    T[(col+1)+col*Ncols] = basisGamma[i];
+    T[ col   +col*Ncols] = basisAlpha[i];
+    if (i>0) T[(col-1)+col*Ncols] = basisBeta[i];
+  }
+}
+
+// Y[:,i+1] = (B*Y[:,i] - alpha_i*Y[:,i] - beta_i*Y[:,i-1])/gamma_i
+// W[:,i]   = A*Y[:,i]
+void sstepcg::BuildBasis(operator_t& linearOperator, operator_t& precon) {
+
+  linAlg_t &linAlg = platform.linAlg();
+
+  const dlong Ntotal = N + Nhalo;
+
+  const int offsets[2] = {0, s+1};
+  const int lengths[2] = {s+1, s};
+
+  for (int b=0;b<2;b++) {
+    for (int i=0;i<lengths[b];i++) {
+      const int col = offsets[b]+i;
+      deviceMemory<dfloat> o_Yi = o_Y + col*Ntotal;
+      deviceMemory<dfloat> o_Wi = o_W + col*Ntotal;
+
+      linearOperator.Operator(o_Yi, o_Wi);
+
+      if (i==lengths[b]-1) continue;
+
+      deviceMemory<dfloat> o_Yn = o_Y + (col+1)*Ntotal;
+      precon.Operator(o_Wi, o_Yn);
+
+      if (chebyshev) {
+        linAlg.axpy(N, -basisAlpha[i]/basisGamma[i], o_Yi, 1.0/basisGamma[i], o_Yn);
+        if (i>0) {
+          deviceMemory<dfloat> o_Yp = o_Y + (col-1)*Ntotal;
+          linAlg.axpy(N, -basisBeta[i]/basisGamma[i], o_Yp, 1.0, o_Yn);
+        }
+      }
+    }
+  }
+}
+
+} //namespace LinearSolver
+
+} //namespace libp
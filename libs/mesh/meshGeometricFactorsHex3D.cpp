@@ -65,7 +65,7 @@ void mesh_t::GeometricFactorsHex3D(){
 
   /* unified storage array for geometric factors */
   /* note that we have volume geometric factors for each node */
-  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo*Np);
+  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo*Np, Memory::ParallelFirstTouch);
 
   Nggeo = 6;
 
@@ -85,7 +85,7 @@ void mesh_t::GeometricFactorsHex3D(){
   props["defines/" "p_G22ID"]= G22ID;
 
   /* number of second order geometric factors */
-  ggeo.malloc(Nelements*Nggeo*Np);
+  ggeo.malloc(Nelements*Nggeo*Np, Memory::ParallelFirstTouch);
 
   wJ.malloc(Nelements*Np);
 
@@ -52,7 +52,7 @@ void mesh_t::GeometricFactorsQuad2D(){
 
   /* unified storage array for geometric factors */
   /* note that we have volume geometric factors for each node */
-  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo*Np);
+  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo*Np, Memory::ParallelFirstTouch);
 
   Nggeo = 3;
 
@@ -66,7 +66,7 @@ void mesh_t::GeometricFactorsQuad2D(){
   props["defines/" "p_G11ID"]= G11ID;
 
   /* number of second order geometric factors */
-  ggeo.malloc(Nelements*Nggeo*Np);
+  ggeo.malloc(Nelements*Nggeo*Np, Memory::ParallelFirstTouch);
 
   wJ.malloc(Nelements*Np);
 
@@ -60,7 +60,7 @@ void mesh_t::GeometricFactorsTet3D(){
   props["defines/" "p_JID"]= JID;
 
   /* unified storage array for geometric factors */
-  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo);
+  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo, Memory::ParallelFirstTouch);
 
   Nggeo = 6;
 
@@ -80,7 +80,7 @@ void mesh_t::GeometricFactorsTet3D(){
   props["defines/" "p_G22ID"]= G22ID;
 
   /* number of second order geometric factors */
-  ggeo.malloc(Nelements*Nggeo);
+  ggeo.malloc(Nelements*Nggeo, Memory::ParallelFirstTouch);
 
   wJ.malloc(Nelements);
 
@@ -47,7 +47,7 @@ void mesh_t::GeometricFactorsTri2D(){
   props["defines/" "p_JID"]= JID;
 
   /* unified storage array for geometric factors */
-  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo);
+  vgeo.malloc((Nelements+totalHaloPairs)*Nvgeo, Memory::ParallelFirstTouch);
 
   Nggeo = 3;
 
@@ -61,7 +61,7 @@ void mesh_t::GeometricFactorsTri2D(){
   props["defines/" "p_G11ID"]= G11ID;
 
   /* number of second order geometric factors */
-  ggeo.malloc(Nelements*Nggeo);
+  ggeo.malloc(Nelements*Nggeo, Memory::ParallelFirstTouch);
 
   wJ.malloc(Nelements);
 
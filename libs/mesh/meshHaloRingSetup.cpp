@@ -310,8 +310,10 @@ void mesh_t::HaloRingSetup(){
   // finally we now have a list of all elements that we need to send to form
   //  the 1-ring (to rule them all)
 
-  //make the halo exchange op
+  //make the halo exchange op, tuned for the vertex coordinates exchanged
+  // here and the patch solution vectors exchanged by the OAS smoother
   int verbose = 0;
+  ringHalo.SetAutoTuneSizes({Nverts, Np});
   ringHalo.Setup(Nelements+totalRingElements,
                  globalElementId, comm,
                  ogs::Auto, verbose, platform);
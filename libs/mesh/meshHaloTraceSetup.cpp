@@ -33,8 +33,10 @@ namespace libp {
 
 // Setup assumes field to be exchanged is Nelements*Nfields*Np in size
 // with Np being the fastest running index (hence each field entry is strided
-// Np apart)
-ogs::halo_t mesh_t::HaloTraceSetup(int Nfields){
+// Np apart). If autoTuneSizes lists the k values the halo will exchange,
+// the exchange method is tuned for those sizes rather than using Pairwise
+ogs::halo_t mesh_t::HaloTraceSetup(int Nfields,
+                                   const std::vector<int> autoTuneSizes){
 
   hlong localNelements = Nelements;
   hlong globalOffset = Nelements;
@@ -82,9 +84,14 @@ ogs::halo_t mesh_t::HaloTraceSetup(int Nfields){
 
   int verbose = 0;
   ogs::halo_t traceHalo;
+  ogs::Method method = ogs::Pairwise;
+  if (autoTuneSizes.size()) {
+    traceHalo.SetAutoTuneSizes(autoTuneSizes);
+    method = ogs::Auto;
+  }
   traceHalo.Setup((Nelements+totalHaloPairs)*Np*Nfields,
                   globalids, comm,
-                  ogs::Pairwise, verbose, platform);
+                  method, verbose, platform);
 
   return traceHalo;
 }
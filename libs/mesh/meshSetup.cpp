@@ -25,12 +25,15 @@ SOFTWARE.
 */
 
 #include "mesh.hpp"
+#include "timer.hpp"
 
 namespace libp {
 
 void mesh_t::Setup(platform_t& _platform, meshSettings_t& _settings,
                    comm_t _comm){
 
+  LIBP_PROFILE("mesh setup");
+
   platform = _platform;
   settings = _settings;
   props = platform.props();
@@ -28,6 +28,7 @@ SOFTWARE.
 #include "ogs/ogsUtils.hpp"
 #include "ogs/ogsOperator.hpp"
 #include "ogs/ogsExchange.hpp"
+#include "ogs/ogsStats.hpp"
 
 namespace libp {
 
@@ -41,6 +42,7 @@ void ogs_t::GatherScatter(deviceMemory<T> o_v,
                           const int k,
                           const Op op,
                           const Transpose trans){
+  LIBP_PROFILE("ogs gather scatter");
   GatherScatterStart (o_v, k, op, trans);
   GatherScatterFinish(o_v, k, op, trans);
 }
@@ -50,6 +52,12 @@ void ogs_t::GatherScatterStart(deviceMemory<T> o_v,
                                const int k,
                                const Op op,
                                const Transpose trans){
+  if (stats) {
+    stats->Call(ogsStats_t::GatherScatter);
+    stats->Message(k*sizeof(T), trans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
@@ -60,6 +68,7 @@ void ogs_t::GatherScatterStart(deviceMemory<T> o_v,
   if (exchange->gpu_aware) {
     //prepare MPI exchange
     exchange->Start(o_haloBuf, k, op, trans);
+    if (stats) stats->End(ogsStats_t::Pack);
   } else {
     //get current stream
     device_t &device = platform.device;
@@ -72,12 +81,27 @@ void ogs_t::GatherScatterStart(deviceMemory<T> o_v,
 
     //wait for o_haloBuf to be ready
     device.finish();
+    if (stats) stats->End(ogsStats_t::Pack);
 
     //queue copy to host
     device.setStream(dataStream);
+    if (stats) stats->Begin(ogsStats_t::Staging);
     haloBuf.copyFrom(o_haloBuf, Nhalo*k,
                      0, properties_t("async", true));
+    if (stats) stats->End(ogsStats_t::Staging);
     device.setStream(currentStream);
+
+    //with a progress thread, start the MPI exchange now so it
+    // advances while the user's kernels execute
+    if (exchange->ProgressThreadActive()) {
+      device.setStream(dataStream);
+      device.finish();
+      device.setStream(currentStream);
+
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start(haloBuf, k, op, trans);
+      if (stats) stats->End(ogsStats_t::Pack);
+    }
   }
 }
 
@@ -87,14 +111,17 @@ void ogs_t::GatherScatterFinish(deviceMemory<T> o_v,
                                 const Op op,
                                 const Transpose trans){
 
-  //queue local gs operation
-  gatherLocal->GatherScatter(o_v, k, op, trans);
-
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
 
+  //queue local gs operation
+  gatherFused->GatherScatter(o_v, o_haloBuf, k, op, trans,
+                             ogsFusedOperator_t::LocalRows);
+
   if (exchange->gpu_aware) {
     //finish MPI exchange
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(o_haloBuf, k, op, trans);
+    if (stats) stats->End(ogsStats_t::Wait);
   } else {
     pinnedMemory<T> haloBuf = exchange->h_workspace;
 
@@ -107,19 +134,30 @@ void ogs_t::GatherScatterFinish(deviceMemory<T> o_v,
     device.finish();
 
     /*MPI exchange of host buffer*/
-    exchange->Start (haloBuf, k, op, trans);
+    if (!exchange->ProgressThreadActive()) {
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start (haloBuf, k, op, trans);
+      if (stats) stats->End(ogsStats_t::Pack);
+    }
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(haloBuf, k, op, trans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
     // copy recv back to device
     const dlong Nhalo = (trans == Trans) ? NhaloP : NhaloT;
+    if (stats) stats->Begin(ogsStats_t::Staging);
     haloBuf.copyTo(o_haloBuf, Nhalo*k,
                    0, properties_t("async", true));
     device.finish(); //wait for transfer to finish
+    if (stats) stats->End(ogsStats_t::Staging);
     device.setStream(currentStream);
   }
 
   //write exchanged halo buffer back to vector
-  gatherHalo->Scatter(o_v, o_haloBuf, k, trans);
+  if (stats) stats->Begin(ogsStats_t::Unpack);
+  gatherFused->GatherScatter(o_v, o_haloBuf, k, op, trans,
+                             ogsFusedOperator_t::HaloRows);
+  if (stats) stats->End(ogsStats_t::Unpack);
 }
 
 template
@@ -143,6 +181,7 @@ void ogs_t::GatherScatter(memory<T> v,
                           const int k,
                           const Op op,
                           const Transpose trans){
+  LIBP_PROFILE("ogs gather scatter");
   GatherScatterStart (v, k, op, trans);
   GatherScatterFinish(v, k, op, trans);
 }
@@ -152,6 +191,12 @@ void ogs_t::GatherScatterStart(memory<T> v,
                                const int k,
                                const Op op,
                                const Transpose trans){
+  if (stats) {
+    stats->Call(ogsStats_t::GatherScatter);
+    stats->Message(k*sizeof(T), trans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   /*Cast workspace to type T*/
@@ -162,6 +207,8 @@ void ogs_t::GatherScatterStart(memory<T> v,
 
   //prepare MPI exchange
   exchange->Start(haloBuf, k, op, trans);
+
+  if (stats) stats->End(ogsStats_t::Pack);
 }
 
 template<typename T>
@@ -173,14 +220,20 @@ void ogs_t::GatherScatterFinish(memory<T> v,
   /*Cast workspace to type T*/
   pinnedMemory<T> haloBuf = exchange->h_workspace;
 
-  //queue local gs operation
-  gatherLocal->GatherScatter(v, k, op, trans);
+  //local gs operation while the exchange is in flight
+  gatherFused->GatherScatter(v, haloBuf, k, op, trans,
+                             ogsFusedOperator_t::LocalRows);
 
   //finish MPI exchange
+  if (stats) stats->Begin(ogsStats_t::Wait);
   exchange->Finish(haloBuf, k, op, trans);
+  if (stats) stats->End(ogsStats_t::Wait);
 
   //write exchanged halo buffer back to vector
-  gatherHalo->Scatter(v, haloBuf, k, trans);
+  if (stats) stats->Begin(ogsStats_t::Unpack);
+  gatherFused->GatherScatter(v, haloBuf, k, op, trans,
+                             ogsFusedOperator_t::HaloRows);
+  if (stats) stats->End(ogsStats_t::Unpack);
 }
 
 template
@@ -217,17 +270,25 @@ void ogs_t::GatherStart(deviceMemory<T> o_gv,
                         const Transpose trans){
   AssertGatherDefined();
 
-  deviceMemory<T> o_haloBuf = exchange->o_workspace;
+  if (stats) stats->Call(ogsStats_t::Gather);
 
   if (trans==Trans) { //if trans!=ogs::Trans theres no comms required
+    if (stats) {
+      stats->Message(k*sizeof(T), Trans);
+      stats->Begin(ogsStats_t::Pack);
+    }
+
     exchange->AllocBuffer(k*sizeof(T));
 
+    deviceMemory<T> o_haloBuf = exchange->o_workspace;
+
     //collect halo buffer
     gatherHalo->Gather(o_haloBuf, o_v, k, op, Trans);
 
     if (exchange->gpu_aware) {
       //prepare MPI exchange
       exchange->Start(o_haloBuf, k, op, Trans);
+      if (stats) stats->End(ogsStats_t::Pack);
     } else {
       //get current stream
       device_t &device = platform.device;
@@ -238,12 +299,27 @@ void ogs_t::GatherStart(deviceMemory<T> o_gv,
 
       //wait for o_haloBuf to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_haloBuf, NhaloT*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
+
+      //with a progress thread, start the MPI exchange now so it
+      // advances while the user's kernels execute
+      if (exchange->ProgressThreadActive()) {
+        device.setStream(dataStream);
+        device.finish();
+        device.setStream(currentStream);
+
+        if (stats) stats->Begin(ogsStats_t::Pack);
+        exchange->Start(haloBuf, k, op, Trans);
+        if (stats) stats->End(ogsStats_t::Pack);
+      }
     }
   } else {
     //gather halo
@@ -261,18 +337,26 @@ void ogs_t::GatherFinish(deviceMemory<T> o_gv,
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
 
-  //queue local g operation
-  gatherLocal->Gather(o_gv, o_v, k, op, trans);
-
   if (trans==Trans) { //if trans!=ogs::Trans theres no comms required
     if (exchange->gpu_aware) {
+      //queue local g operation
+      gatherFused->Gather(o_gv, o_v, o_haloBuf, k, op, Trans,
+                          ogsFusedOperator_t::LocalRows);
+
       //finish MPI exchange
+      if (stats) stats->Begin(ogsStats_t::Wait);
       exchange->Finish(o_haloBuf, k, op, Trans);
+      if (stats) stats->End(ogsStats_t::Wait);
 
-      //put the result at the end of o_gv
-      o_haloBuf.copyTo(o_gv + k*NlocalT,
-                       k*NhaloP, 0, properties_t("async", true));
+      //put the exchanged halo at the end of o_gv
+      if (stats) stats->Begin(ogsStats_t::Unpack);
+      gatherFused->Gather(o_gv, o_v, o_haloBuf, k, op, Trans,
+                          ogsFusedOperator_t::HaloRows);
+      if (stats) stats->End(ogsStats_t::Unpack);
     } else {
+      //queue local g operation
+      gatherLocal->Gather(o_gv, o_v, k, op, trans);
+
       pinnedMemory<T> haloBuf = exchange->h_workspace;
 
       //get current stream
@@ -284,16 +368,27 @@ void ogs_t::GatherFinish(deviceMemory<T> o_gv,
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (haloBuf, k, op, trans);
+      if (!exchange->ProgressThreadActive()) {
+        if (stats) stats->Begin(ogsStats_t::Pack);
+        exchange->Start (haloBuf, k, op, trans);
+        if (stats) stats->End(ogsStats_t::Pack);
+      }
+      if (stats) stats->Begin(ogsStats_t::Wait);
       exchange->Finish(haloBuf, k, op, trans);
+      if (stats) stats->End(ogsStats_t::Wait);
 
       // copy recv back to device
       //put the result at the end of o_gv
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_gv + k*NlocalT, k*NhaloP,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     }
+  } else {
+    //queue local g operation
+    gatherLocal->Gather(o_gv, o_v, k, op, trans);
   }
 }
 
@@ -333,7 +428,14 @@ void ogs_t::GatherStart(memory<T> gv,
                         const Transpose trans){
   AssertGatherDefined();
 
+  if (stats) stats->Call(ogsStats_t::Gather);
+
   if (trans==Trans) { //if trans!=ogs::Trans theres no comms required
+    if (stats) {
+      stats->Message(k*sizeof(T), Trans);
+      stats->Begin(ogsStats_t::Pack);
+    }
+
     exchange->AllocBuffer(k*sizeof(T));
 
     /*Cast workspace to type T*/
@@ -344,6 +446,8 @@ void ogs_t::GatherStart(memory<T> gv,
 
     //prepare MPI exchange
     exchange->Start(haloBuf, k, op, Trans);
+
+    if (stats) stats->End(ogsStats_t::Pack);
   } else {
     //gather halo
     gatherHalo->Gather(gv + k*NlocalT, v, k, op, trans);
@@ -358,18 +462,27 @@ void ogs_t::GatherFinish(memory<T> gv,
                          const Transpose trans){
   AssertGatherDefined();
 
-  //queue local g operation
-  gatherLocal->Gather(gv, v, k, op, trans);
-
   if (trans==Trans) { //if trans!=ogs::Trans theres no comms required
     /*Cast workspace to type T*/
     pinnedMemory<T> haloBuf = exchange->h_workspace;
 
+    //local g operation while the exchange is in flight
+    gatherFused->Gather(gv, v, haloBuf, k, op, Trans,
+                        ogsFusedOperator_t::LocalRows);
+
     //finish MPI exchange
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(haloBuf, k, op, Trans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
-    //put the result at the end of o_gv
-    haloBuf.copyTo(gv+k*NlocalT, k*NhaloP);
+    //put the exchanged halo at the end of gv
+    if (stats) stats->Begin(ogsStats_t::Unpack);
+    gatherFused->Gather(gv, v, haloBuf, k, op, Trans,
+                        ogsFusedOperator_t::HaloRows);
+    if (stats) stats->End(ogsStats_t::Unpack);
+  } else {
+    //queue local g operation
+    gatherLocal->Gather(gv, v, k, op, trans);
   }
 }
 
@@ -405,11 +518,18 @@ void ogs_t::ScatterStart(deviceMemory<T> o_v,
                          const Transpose trans){
   AssertGatherDefined();
 
-  deviceMemory<T> o_haloBuf = exchange->o_workspace;
+  if (stats) stats->Call(ogsStats_t::Scatter);
 
   if (trans==NoTrans) { //if trans!=ogs::NoTrans theres no comms required
+    if (stats) {
+      stats->Message(k*sizeof(T), NoTrans);
+      stats->Begin(ogsStats_t::Pack);
+    }
+
     exchange->AllocBuffer(k*sizeof(T));
 
+    deviceMemory<T> o_haloBuf = exchange->o_workspace;
+
     device_t &device = platform.device;
 
     if (exchange->gpu_aware) {
@@ -422,6 +542,7 @@ void ogs_t::ScatterStart(deviceMemory<T> o_v,
 
       //prepare MPI exchange
       exchange->Start(o_haloBuf, k, Add, NoTrans);
+      if (stats) stats->End(ogsStats_t::Pack);
     } else {
       //get current stream
       stream_t currentStream = device.getStream();
@@ -431,12 +552,27 @@ void ogs_t::ScatterStart(deviceMemory<T> o_v,
 
       //wait for o_gv to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_gv + k*NlocalT, NhaloP*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
+
+      //with a progress thread, start the MPI exchange now so it
+      // advances while the user's kernels execute
+      if (exchange->ProgressThreadActive()) {
+        device.setStream(dataStream);
+        device.finish();
+        device.setStream(currentStream);
+
+        if (stats) stats->Begin(ogsStats_t::Pack);
+        exchange->Start(haloBuf, k, Add, NoTrans);
+        if (stats) stats->End(ogsStats_t::Pack);
+      }
     }
   }
 }
@@ -456,7 +592,9 @@ void ogs_t::ScatterFinish(deviceMemory<T> o_v,
   if (trans==NoTrans) { //if trans!=ogs::NoTrans theres no comms required
     if (exchange->gpu_aware) {
       //finish MPI exchange
+      if (stats) stats->Begin(ogsStats_t::Wait);
       exchange->Finish(o_haloBuf, k, Add, NoTrans);
+      if (stats) stats->End(ogsStats_t::Wait);
     } else {
       pinnedMemory<T> haloBuf = exchange->h_workspace;
 
@@ -469,18 +607,28 @@ void ogs_t::ScatterFinish(deviceMemory<T> o_v,
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (haloBuf, k, Add, NoTrans);
+      if (!exchange->ProgressThreadActive()) {
+        if (stats) stats->Begin(ogsStats_t::Pack);
+        exchange->Start (haloBuf, k, Add, NoTrans);
+        if (stats) stats->End(ogsStats_t::Pack);
+      }
+      if (stats) stats->Begin(ogsStats_t::Wait);
       exchange->Finish(haloBuf, k, Add, NoTrans);
+      if (stats) stats->End(ogsStats_t::Wait);
 
       // copy recv back to device
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_haloBuf, NhaloT*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     }
 
     //scatter halo buffer
+    if (stats) stats->Begin(ogsStats_t::Unpack);
     gatherHalo->Scatter(o_v, o_haloBuf, k, NoTrans);
+    if (stats) stats->End(ogsStats_t::Unpack);
   } else {
     //scatter halo
     gatherHalo->Scatter(o_v, o_gv + k*NlocalT, k, trans);
@@ -521,7 +669,14 @@ void ogs_t::ScatterStart(memory<T> v,
                          const Transpose trans){
   AssertGatherDefined();
 
+  if (stats) stats->Call(ogsStats_t::Scatter);
+
   if (trans==NoTrans) { //if trans!=ogs::NoTrans theres no comms required
+    if (stats) {
+      stats->Message(k*sizeof(T), NoTrans);
+      stats->Begin(ogsStats_t::Pack);
+    }
+
     exchange->AllocBuffer(k*sizeof(T));
 
     /*Cast workspace to type T*/
@@ -532,6 +687,8 @@ void ogs_t::ScatterStart(memory<T> v,
 
     //prepare MPI exchange
     exchange->Start(haloBuf, k, Add, NoTrans);
+
+    if (stats) stats->End(ogsStats_t::Pack);
   }
 }
 
@@ -550,10 +707,14 @@ void ogs_t::ScatterFinish(memory<T> v,
     pinnedMemory<T> haloBuf = exchange->h_workspace;
 
     //finish MPI exchange (and put the result at the end of o_gv)
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(haloBuf, k, Add, NoTrans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
     //scatter halo buffer
+    if (stats) stats->Begin(ogsStats_t::Unpack);
     gatherHalo->Scatter(v, haloBuf, k, NoTrans);
+    if (stats) stats->End(ogsStats_t::Unpack);
   } else {
     //scatter halo
     gatherHalo->Scatter(v, gv + k*NlocalT, k, trans);
@@ -73,14 +73,17 @@ inline void ogsAllToAll_t::Start(pinnedMemory<T> &buf, const int k,
   // collect everything needed with single MPI all to all
   comm.Ialltoallv(sendBuf,     sendCounts, sendOffsets,
                   buf+Nhalo*k, recvCounts, recvOffsets,
-                  request);
+                  request[0]);
+
+  ProgressStart(1, request);
 }
 
 template<typename T>
 inline void ogsAllToAll_t::Finish(pinnedMemory<T> &buf, const int k,
                            const Op op, const Transpose trans){
 
-  comm.Wait(request);
+  ProgressStop();
+  comm.Wait(request[0]);
 
   //if we recvieved anything via MPI, gather the recv buffer and scatter
   // it back to to original vector
@@ -335,6 +338,8 @@ ogsAllToAll_t::ogsAllToAll_t(dlong Nshared,
   sendOffsets.malloc(size+1);
   recvOffsets.malloc(size+1);
 
+  request.malloc(1);
+
   sendOffsets[0]=0;
   recvOffsets[0]=0;
 
@@ -29,12 +29,13 @@ SOFTWARE.
 #include "ogs/ogsOperator.hpp"
 #include "ogs/ogsExchange.hpp"
 #include "timer.hpp"
+#include <algorithm>
 
 namespace libp {
 
 namespace ogs {
 
-static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
+static void DeviceExchangeTest(ogsExchange_t* exchange, const int k, double time[3]) {
   const int Ncold = 10;
   const int Nhot  = 10;
   double localTime, sumTime, minTime, maxTime;
@@ -42,6 +43,8 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   comm_t& comm = exchange->comm;
   int size = comm.size();
 
+  exchange->AllocBuffer(k*sizeof(dfloat));
+
   pinnedMemory<dfloat>   buf = exchange->h_workspace;
   deviceMemory<dfloat> o_buf = exchange->o_workspace;
 
@@ -51,20 +54,20 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   for (int n=0;n<Ncold;++n) {
     if (exchange->gpu_aware) {
       /*GPU-aware exchange*/
-      exchange->Start (o_buf, 1, Add, Sym);
-      exchange->Finish(o_buf, 1, Add, Sym);
+      exchange->Start (o_buf, k, Add, Sym);
+      exchange->Finish(o_buf, k, Add, Sym);
     } else {
       //if not using gpu-aware mpi move the halo buffer to the host
-      o_buf.copyTo(buf, exchange->Nhalo,
+      o_buf.copyTo(buf, exchange->Nhalo*k,
                    0, properties_t("async", true));
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (buf, 1, Add, Sym);
-      exchange->Finish(buf, 1, Add, Sym);
+      exchange->Start (buf, k, Add, Sym);
+      exchange->Finish(buf, k, Add, Sym);
 
       // copy recv back to device
-      o_buf.copyFrom(buf, exchange->Nhalo,
+      o_buf.copyFrom(buf, exchange->Nhalo*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
     }
@@ -75,20 +78,20 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   for (int n=0;n<Nhot;++n) {
     if (exchange->gpu_aware) {
       /*GPU-aware exchange*/
-      exchange->Start (o_buf, 1, Add, Sym);
-      exchange->Finish(o_buf, 1, Add, Sym);
+      exchange->Start (o_buf, k, Add, Sym);
+      exchange->Finish(o_buf, k, Add, Sym);
     } else {
       //if not using gpu-aware mpi move the halo buffer to the host
-      o_buf.copyTo(buf, exchange->Nhalo,
+      o_buf.copyTo(buf, exchange->Nhalo*k,
                    0, properties_t("async", true));
       device.finish();
 
       /*MPI exchange of host buffer*/
-      exchange->Start (buf, 1, Add, Sym);
-      exchange->Finish(buf, 1, Add, Sym);
+      exchange->Start (buf, k, Add, Sym);
+      exchange->Finish(buf, k, Add, Sym);
 
       // copy recv back to device
-      o_buf.copyFrom(buf, exchange->Nhalo,
+      o_buf.copyFrom(buf, exchange->Nhalo*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
     }
@@ -105,7 +108,7 @@ static void DeviceExchangeTest(ogsExchange_t* exchange, double time[3]) {
   time[2] = maxTime;      //max
 }
 
-static void HostExchangeTest(ogsExchange_t* exchange, double time[3]) {
+static void HostExchangeTest(ogsExchange_t* exchange, const int k, double time[3]) {
   const int Ncold = 10;
   const int Nhot  = 10;
   double localTime, sumTime, minTime, maxTime;
@@ -113,19 +116,21 @@ static void HostExchangeTest(ogsExchange_t* exchange, double time[3]) {
   comm_t& comm = exchange->comm;
   int size = comm.size();
 
+  exchange->AllocBuffer(k*sizeof(dfloat));
+
   pinnedMemory<dfloat> buf = exchange->h_workspace;
 
   //dry run
   for (int n=0;n<Ncold;++n) {
-    exchange->Start (buf, 1, Add, Sym);
-    exchange->Finish(buf, 1, Add, Sym);
+    exchange->Start (buf, k, Add, Sym);
+    exchange->Finish(buf, k, Add, Sym);
   }
 
   //hot runs
   timePoint_t start = Time();
   for (int n=0;n<Nhot;++n) {
-    exchange->Start (buf, 1, Add, Sym);
-    exchange->Finish(buf, 1, Add, Sym);
+    exchange->Start (buf, k, Add, Sym);
+    exchange->Finish(buf, k, Add, Sym);
   }
   timePoint_t end = Time();
 
@@ -139,25 +144,155 @@ static void HostExchangeTest(ogsExchange_t* exchange, double time[3]) {
   time[2] = maxTime;      //max
 }
 
+static const char* MethodName(const Method method) {
+  switch (method) {
+    case Pairwise:      return "Pairwise";
+    case CrystalRouter: return "CrystalRouter";
+    case AllToAll:      return "AllToAll";
+    case Persistent:    return "Persistent";
+    case Neighborhood:  return "Neighborhood";
+    case Hierarchical:  return "Hierarchical";
+    default:            return "Auto";
+  }
+}
+
+static ogsExchange_t* NewExchange(const Method method,
+                                  dlong Nshared,
+                                  memory<parallelNode_t> &sharedNodes,
+                                  ogsOperator_t& gatherHalo,
+                                  stream_t dataStream,
+                                  comm_t comm,
+                                  platform_t &platform) {
+  switch (method) {
+    case AllToAll:
+      return new ogsAllToAll_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+    case Persistent:
+      return new ogsPersistent_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+    case Neighborhood:
+      return new ogsNeighborhood_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+    case Hierarchical:
+      return new ogsHierarchical_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+    case CrystalRouter:
+      return new ogsCrystalRouter_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+    default:
+      return new ogsPairwise_t(Nshared, sharedNodes, gatherHalo, dataStream, comm, platform);
+  }
+}
+
 ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
                                     memory<parallelNode_t> &sharedNodes,
                                     ogsOperator_t& _gatherHalo,
                                     comm_t _comm,
                                     platform_t &_platform,
-                                    const int verbose) {
+                                    const int verbose,
+                                    Method &method) {
 
   int rank, size;
   rank = comm.rank();
   size = comm.size();
 
-  if (size==1) return new ogsPairwise_t(Nshared, sharedNodes,
-                                        _gatherHalo, dataStream,
-                                        comm, platform);
+  if (size==1) {
+    method = Pairwise;
+    return new ogsPairwise_t(Nshared, sharedNodes,
+                             _gatherHalo, dataStream,
+                             comm, platform);
+  }
+
+  //payload sizes to tune for, ascending
+  std::vector<int> ks;
+  for (int k : autoTuneSizes) if (k>0) ks.push_back(k);
+  if (ks.size()==0) ks.push_back(1);
+  std::sort(ks.begin(), ks.end());
+  ks.erase(std::unique(ks.begin(), ks.end()), ks.end());
+
+  //look up selections made for this halo in earlier runs
+  const bool useDatabase = platform.settings().compareSetting("OGS TUNING DATABASE", "TRUE");
+
+  std::string databaseFile;
+  std::vector<tuningEntry_t> entries;
+  if (useDatabase) {
+    databaseFile = TuningDatabaseFile(Nshared, sharedNodes);
+    LoadTuningDatabase(databaseFile, entries);
+  }
+
+  std::vector<size_t> sizes;
+  std::vector<Method> methods;
+  std::vector<ogsExchange_t*> exchanges;
+  bool updated = false;
+
+  for (int k : ks) {
+    const size_t Nbytes = k*sizeof(dfloat);
+
+    auto entry = std::find_if(entries.begin(), entries.end(),
+                              [Nbytes](const tuningEntry_t& e) { return e.Nbytes==Nbytes; });
+
+    Method kMethod;
+    ogsExchange_t* kExchange;
+    if (entry != entries.end()) {
+      kMethod = entry->method;
+      kExchange = NewExchange(kMethod, Nshared, sharedNodes,
+                              _gatherHalo, dataStream,
+                              comm, platform);
+      kExchange->gpu_aware = entry->gpu_aware;
+
+      if (rank==0 && verbose) {
+        printf("   Exchange method for k=%d loaded from tuning database: %s", k, MethodName(kMethod));
+        if (kExchange->gpu_aware) printf(" (GPU-aware)");
+        printf("\n");
+      }
+    } else {
+      kExchange = AutoBenchmark(Nshared, sharedNodes, _gatherHalo,
+                                k, verbose, kMethod);
+      entries.push_back({Nbytes, kMethod, kExchange->gpu_aware});
+      updated = true;
+    }
+
+    //consecutive sizes with the same selection share an exchange
+    if (exchanges.size()>0
+        && methods.back()==kMethod
+        && exchanges.back()->gpu_aware==kExchange->gpu_aware) {
+      delete kExchange;
+      continue;
+    }
+    sizes.push_back(Nbytes);
+    methods.push_back(kMethod);
+    exchanges.push_back(kExchange);
+  }
+
+  if (useDatabase && updated) {
+    SaveTuningDatabase(databaseFile, entries);
+  }
+
+  if (exchanges.size()==1) {
+    method = methods[0];
+    return exchanges[0];
+  }
+
+  //Auto is recorded so a cached setup comes back here, and to the database
+  method = Auto;
+
+  std::vector<std::shared_ptr<ogsExchange_t>> shared;
+  for (ogsExchange_t* ex : exchanges) {
+    shared.push_back(std::shared_ptr<ogsExchange_t>(ex));
+  }
+  return new ogsSizeDispatch_t(sizes, shared);
+}
+
+ogsExchange_t* ogsBase_t::AutoBenchmark(dlong Nshared,
+                                        memory<parallelNode_t> &sharedNodes,
+                                        ogsOperator_t& _gatherHalo,
+                                        const int k,
+                                        const int verbose,
+                                        Method &method) {
+
+  int rank = comm.rank();
 
   ogsExchange_t* bestExchange;
-  Method method;
   double bestTime;
 
+  if (rank==0 && verbose)
+    printf("   Exchange benchmark with k=%d\n", k);
+
 #ifdef GPU_AWARE_MPI
   if (rank==0 && verbose)
     printf("   Method         Device Exchange (avg, min, max)  Device Exchange (GPU-aware)      Host Exchange \n");
@@ -180,7 +315,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   pairwise->gpu_aware=false;
 
   double pairwiseTime[3];
-  DeviceExchangeTest(pairwise, pairwiseTime);
+  DeviceExchangeTest(pairwise, k, pairwiseTime);
   double pairwiseAvg = pairwiseTime[0];
 
 #ifdef GPU_AWARE_MPI
@@ -188,7 +323,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   pairwise->gpu_aware=true;
 
   double pairwiseGATime[3];
-  DeviceExchangeTest(pairwise, pairwiseGATime);
+  DeviceExchangeTest(pairwise, k, pairwiseGATime);
 
   if (pairwiseGATime[0] < pairwiseAvg)
     pairwiseAvg = pairwiseGATime[0];
@@ -199,7 +334,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
 
   //test exchange from host memory (just for reporting)
   double pairwiseHostTime[3];
-  HostExchangeTest(pairwise, pairwiseHostTime);
+  HostExchangeTest(pairwise, k, pairwiseHostTime);
 
   bestExchange = pairwise;
   method = Pairwise;
@@ -218,6 +353,65 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
             pairwiseHostTime[0], pairwiseHostTime[1], pairwiseHostTime[2]);
 #endif
 
+  /********************************
+   * Persistent Pairwise
+   ********************************/
+  ogsExchange_t* persistent = new ogsPersistent_t(Nshared, sharedNodes,
+                                                  _gatherHalo, dataStream,
+                                                  comm, platform);
+
+  //standard copy to host - exchange - copy back to device
+  persistent->gpu_aware=false;
+
+  double persistentTime[3];
+  DeviceExchangeTest(persistent, k, persistentTime);
+  double persistentAvg = persistentTime[0];
+
+#ifdef GPU_AWARE_MPI
+  //test GPU-aware exchange
+  persistent->gpu_aware=true;
+
+  double persistentGATime[3];
+  DeviceExchangeTest(persistent, k, persistentGATime);
+
+  if (persistentGATime[0] < persistentAvg)
+    persistentAvg = persistentGATime[0];
+  else
+    persistent->gpu_aware=false;
+
+#endif
+
+  //test exchange from host memory (just for reporting)
+  double persistentHostTime[3];
+  HostExchangeTest(persistent, k, persistentHostTime);
+
+  //per-exchange latency saved by reusing the pairwise requests
+  const double persistentSaved = pairwiseAvg - persistentAvg;
+
+  if (persistentAvg < bestTime) {
+    delete bestExchange;
+    bestExchange = persistent;
+    method = Persistent;
+    bestTime = persistentAvg;
+  } else {
+    delete persistent;
+  }
+
+#ifdef GPU_AWARE_MPI
+  if (rank==0 && verbose)
+    printf("   Persistent     %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            persistentTime[0],     persistentTime[1],     persistentTime[2],
+            persistentGATime[0],   persistentGATime[1],   persistentGATime[2],
+            persistentHostTime[0], persistentHostTime[1], persistentHostTime[2]);
+#else
+  if (rank==0 && verbose)
+    printf("   Persistent     %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            persistentTime[0],     persistentTime[1],     persistentTime[2],
+            persistentHostTime[0], persistentHostTime[1], persistentHostTime[2]);
+#endif
+  if (rank==0 && verbose)
+    printf("   (Persistent saves %5.3e per exchange vs. Pairwise)\n", persistentSaved);
+
   /********************************
    * All-to-All
    ********************************/
@@ -228,7 +422,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   alltoall->gpu_aware=false;
 
   double alltoallTime[3];
-  DeviceExchangeTest(alltoall, alltoallTime);
+  DeviceExchangeTest(alltoall, k, alltoallTime);
   double alltoallAvg = alltoallTime[0];
 
 #ifdef GPU_AWARE_MPI
@@ -236,7 +430,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   alltoall->gpu_aware=true;
 
   double alltoallGATime[3];
-  DeviceExchangeTest(alltoall, alltoallGATime);
+  DeviceExchangeTest(alltoall, k, alltoallGATime);
 
   if (alltoallGATime[0] < alltoallAvg)
     alltoallAvg = alltoallGATime[0];
@@ -247,7 +441,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
 
   //test exchange from host memory (just for reporting)
   double alltoallHostTime[3];
-  HostExchangeTest(alltoall, alltoallHostTime);
+  HostExchangeTest(alltoall, k, alltoallHostTime);
 
   if (alltoallAvg < bestTime) {
     delete bestExchange;
@@ -271,6 +465,59 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
             alltoallHostTime[0], alltoallHostTime[1], alltoallHostTime[2]);
 #endif
 
+  /********************************
+   * Neighborhood Collective
+   ********************************/
+  ogsExchange_t* neighborhood = new ogsNeighborhood_t(Nshared, sharedNodes,
+                                                      _gatherHalo, dataStream,
+                                                      comm, platform);
+  //standard copy to host - exchange - copy back to device
+  neighborhood->gpu_aware=false;
+
+  double neighborhoodTime[3];
+  DeviceExchangeTest(neighborhood, k, neighborhoodTime);
+  double neighborhoodAvg = neighborhoodTime[0];
+
+#ifdef GPU_AWARE_MPI
+  //test GPU-aware exchange
+  neighborhood->gpu_aware=true;
+
+  double neighborhoodGATime[3];
+  DeviceExchangeTest(neighborhood, k, neighborhoodGATime);
+
+  if (neighborhoodGATime[0] < neighborhoodAvg)
+    neighborhoodAvg = neighborhoodGATime[0];
+  else
+    neighborhood->gpu_aware=false;
+
+#endif
+
+  //test exchange from host memory (just for reporting)
+  double neighborhoodHostTime[3];
+  HostExchangeTest(neighborhood, k, neighborhoodHostTime);
+
+  if (neighborhoodAvg < bestTime) {
+    delete bestExchange;
+    bestExchange = neighborhood;
+    method = Neighborhood;
+    bestTime = neighborhoodAvg;
+  } else {
+    delete neighborhood;
+  }
+
+#ifdef GPU_AWARE_MPI
+  if (rank==0 && verbose)
+    printf("   Neighborhood   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            neighborhoodTime[0],     neighborhoodTime[1],     neighborhoodTime[2],
+            neighborhoodGATime[0],   neighborhoodGATime[1],   neighborhoodGATime[2],
+            neighborhoodHostTime[0], neighborhoodHostTime[1], neighborhoodHostTime[2]);
+#else
+  if (rank==0 && verbose)
+    printf("   Neighborhood   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            neighborhoodTime[0],     neighborhoodTime[1],     neighborhoodTime[2],
+            neighborhoodHostTime[0], neighborhoodHostTime[1], neighborhoodHostTime[2]);
+#endif
+
   /********************************
    * Crystal Router
    ********************************/
@@ -282,7 +529,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   crystal->gpu_aware=false;
 
   double crystalTime[3];
-  DeviceExchangeTest(crystal, crystalTime);
+  DeviceExchangeTest(crystal, k, crystalTime);
   double crystalAvg = crystalTime[0];
 
 #ifdef GPU_AWARE_MPI
@@ -290,7 +537,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
   crystal->gpu_aware=true;
 
   double crystalGATime[3];
-  DeviceExchangeTest(crystal, crystalGATime);
+  DeviceExchangeTest(crystal, k, crystalGATime);
 
   if (crystalGATime[0] < crystalAvg)
     crystalAvg = crystalGATime[0];
@@ -301,7 +548,7 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
 
   //test exchange from host memory (just for reporting)
   double crystalHostTime[3];
-  HostExchangeTest(crystal, crystalHostTime);
+  HostExchangeTest(crystal, k, crystalHostTime);
 
   if (crystalAvg < bestTime) {
     delete bestExchange;
@@ -325,17 +572,45 @@ ogsExchange_t* ogsBase_t::AutoSetup(dlong Nshared,
             crystalHostTime[0], crystalHostTime[1], crystalHostTime[2]);
 #endif
 
+  /********************************
+   * Node-aware Hierarchical
+   ********************************/
+  ogsExchange_t* hierarchical = new ogsHierarchical_t(Nshared, sharedNodes,
+                                                      _gatherHalo, dataStream,
+                                                      comm, platform);
+
+  //node aggregation is always done from host memory
+  double hierarchicalTime[3];
+  DeviceExchangeTest(hierarchical, k, hierarchicalTime);
+  double hierarchicalAvg = hierarchicalTime[0];
+
+  //test exchange from host memory (just for reporting)
+  double hierarchicalHostTime[3];
+  HostExchangeTest(hierarchical, k, hierarchicalHostTime);
+
+  if (hierarchicalAvg < bestTime) {
+    delete bestExchange;
+    bestExchange = hierarchical;
+    method = Hierarchical;
+    bestTime = hierarchicalAvg;
+  } else {
+    delete hierarchical;
+  }
+
+#ifdef GPU_AWARE_MPI
+  if (rank==0 && verbose)
+    printf("   Hierarchical   %5.3e %5.3e %5.3e        ---       ---       ---      %5.3e %5.3e %5.3e \n",
+            hierarchicalTime[0],     hierarchicalTime[1],     hierarchicalTime[2],
+            hierarchicalHostTime[0], hierarchicalHostTime[1], hierarchicalHostTime[2]);
+#else
+  if (rank==0 && verbose)
+    printf("   Hierarchical   %5.3e %5.3e %5.3e    %5.3e %5.3e %5.3e \n",
+            hierarchicalTime[0],     hierarchicalTime[1],     hierarchicalTime[2],
+            hierarchicalHostTime[0], hierarchicalHostTime[1], hierarchicalHostTime[2]);
+#endif
+
   if (rank==0 && verbose) {
-    switch (method) {
-      case AllToAll:
-        printf("   Exchange method selected: AllToAll"); break;
-      case Pairwise:
-        printf("   Exchange method selected: Pairwise"); break;
-      case CrystalRouter:
-        printf("   Exchange method selected: CrystalRouter"); break;
-      default:
-        break;
-    }
+    printf("   Exchange method selected: %s", MethodName(method));
     if (bestExchange->gpu_aware) printf(" (GPU-aware)");
     printf("\n");
   }
@@ -0,0 +1,587 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsOperator.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+/********************************
+ * GatherScatter Operation
+ ********************************/
+template <template<typename> class U,
+          template<typename> class V,
+          template<typename> class Op,
+          typename T>
+void ogsFusedOperator_t::GatherScatter(U<T> v,
+                                       const V<T> haloBuf,
+                                       const int K,
+                                       const Transpose trans,
+                                       const dlong blockStart,
+                                       const dlong blockEnd) {
+
+  const dlong *__restrict__ gRowStarts = (trans==NoTrans) ? rowStartsN.ptr() : rowStartsT.ptr();
+  const dlong *__restrict__ gColIds    = (trans==NoTrans) ? colIdsN.ptr()    : colIdsT.ptr();
+  const dlong *__restrict__ sRowStarts = (trans==Trans)   ? rowStartsN.ptr() : rowStartsT.ptr();
+  const dlong *__restrict__ sColIds    = (trans==Trans)   ? colIdsN.ptr()    : colIdsT.ptr();
+
+  T*__restrict__ v_ptr = v.ptr();
+  const T*__restrict__ halo_ptr = haloBuf.ptr();
+
+  const Op<T> op;
+
+  constexpr int simdWidth = ogsOperator_t::simdWidth;
+
+  if (K==1) {
+    #pragma omp parallel for schedule(static)
+    for(dlong b=blockStart;b<blockEnd;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = blockRowStartsHost[b+1];
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong sstart = sRowStarts[n];
+        const dlong send   = sRowStarts[n+1];
+
+        if (sstart==send) continue; //nothing to write back
+
+        T val;
+        if (n>=NlocalRows) { //halo rows are copies from the halo buffer
+          val = halo_ptr[n-NlocalRows];
+        } else {
+          const dlong gstart = gRowStarts[n];
+          const dlong gend   = gRowStarts[n+1];
+
+          //unit degree rows which scatter back to themselves are no-ops
+          if (gend-gstart==1 && send-sstart==1
+              && gColIds[gstart]==sColIds[sstart]) continue;
+
+          val = op.init();
+          for(dlong g=gstart;g<gend;++g){
+            op(val, v_ptr[gColIds[g]]);
+          }
+        }
+        for(dlong s=sstart;s<send;++s){
+          v_ptr[sColIds[s]] = val;
+        }
+      }
+    }
+  } else {
+    #pragma omp parallel for schedule(static)
+    for(dlong b=blockStart;b<blockEnd;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = blockRowStartsHost[b+1];
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong sstart = sRowStarts[n];
+        const dlong send   = sRowStarts[n+1];
+
+        if (sstart==send) continue; //nothing to write back
+
+        if (n>=NlocalRows) { //halo rows are copies from the halo buffer
+          const T* h_row = halo_ptr + (n-NlocalRows)*K;
+          for(dlong s=sstart;s<send;++s){
+            T* v_row = v_ptr + sColIds[s]*K;
+            #pragma omp simd
+            for (int k=0;k<K;++k) {
+              v_row[k] = h_row[k];
+            }
+          }
+          continue;
+        }
+
+        const dlong gstart = gRowStarts[n];
+        const dlong gend   = gRowStarts[n+1];
+
+        if (gend-gstart==1) { //unit degree rows are straight copies
+          const dlong gid = gColIds[gstart];
+          for(dlong s=sstart;s<send;++s){
+            if (sColIds[s]==gid) continue;
+            const T* g_row = v_ptr + gid*K;
+            T* v_row = v_ptr + sColIds[s]*K;
+            #pragma omp simd
+            for (int k=0;k<K;++k) {
+              v_row[k] = g_row[k];
+            }
+          }
+          continue;
+        }
+
+        //gather-scatter in short SIMD-width chunks of k
+        for (int k0=0;k0<K;k0+=simdWidth) {
+          const int Nk = std::min(simdWidth, K-k0);
+
+          T val[simdWidth];
+          for (int k=0;k<simdWidth;++k) val[k] = op.init();
+
+          for(dlong g=gstart;g<gend;++g){
+            const T* v_row = v_ptr + k0 + gColIds[g]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              op(val[k], v_row[k]);
+            }
+          }
+          for(dlong s=sstart;s<send;++s){
+            T* v_row = v_ptr + k0 + sColIds[s]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              v_row[k] = val[k];
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+template <template<typename> class U,
+          template<typename> class V,
+          typename T>
+void ogsFusedOperator_t::GatherScatter(U<T> v,
+                                       const V<T> haloBuf,
+                                       const int k,
+                                       const Op op,
+                                       const Transpose trans,
+                                       const Rows rows) {
+  const dlong blockStart = (rows==LocalRows) ? 0 : NlocalRowBlocksHost;
+  const dlong blockEnd   = (rows==LocalRows) ? NlocalRowBlocksHost : NrowBlocksHost;
+
+  switch (op){
+    case Add:
+      GatherScatter<U, V, Op_Add, T>(v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Mul:
+      GatherScatter<U, V, Op_Mul, T>(v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Max:
+      GatherScatter<U, V, Op_Max, T>(v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Min:
+      GatherScatter<U, V, Op_Min, T>(v, haloBuf, k, trans, blockStart, blockEnd); break;
+  }
+}
+
+template
+void ogsFusedOperator_t::GatherScatter(memory<float> v, const pinnedMemory<float> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(memory<double> v, const pinnedMemory<double> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(memory<int> v, const pinnedMemory<int> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(memory<long long int> v, const pinnedMemory<long long int> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+
+template<typename T>
+void ogsFusedOperator_t::GatherScatter(deviceMemory<T> o_v,
+                                       const deviceMemory<T> o_haloBuf,
+                                       const int k,
+                                       const Op op,
+                                       const Transpose trans,
+                                       const Rows rows) {
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, op);
+
+  const dlong blockStart = (rows==LocalRows) ? 0 : NlocalRowBlocks;
+  const dlong Nblocks    = (rows==LocalRows) ? NlocalRowBlocks : NrowBlocks-NlocalRowBlocks;
+
+  if (Nblocks)
+    gatherScatterKernel[type][op](Nblocks,
+                                  k,
+                                  NlocalRows,
+                                  o_blockRowStarts + blockStart,
+                                  (trans==NoTrans) ? o_rowStartsN : o_rowStartsT,
+                                  (trans==NoTrans) ? o_colIdsN    : o_colIdsT,
+                                  (trans==Trans)   ? o_rowStartsN : o_rowStartsT,
+                                  (trans==Trans)   ? o_colIdsN    : o_colIdsT,
+                                  o_haloBuf,
+                                  o_v);
+}
+
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<float> v, const deviceMemory<float> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<double> v, const deviceMemory<double> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<int> v, const deviceMemory<int> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+template
+void ogsFusedOperator_t::GatherScatter(deviceMemory<long long int> v, const deviceMemory<long long int> haloBuf,
+                                       const int k, const Op op, const Transpose trans,
+                                       const Rows rows);
+
+/********************************
+ * Gather Operation
+ ********************************/
+template <template<typename> class U,
+          template<typename> class V,
+          template<typename> class Op,
+          typename T>
+void ogsFusedOperator_t::Gather(U<T> gv,
+                                const U<T> v,
+                                const V<T> haloBuf,
+                                const int K,
+                                const Transpose trans,
+                                const dlong blockStart,
+                                const dlong blockEnd) {
+
+  const dlong *__restrict__ rowStarts = (trans==NoTrans) ? rowStartsN.ptr() : rowStartsT.ptr();
+  const dlong *__restrict__ colIds    = (trans==NoTrans) ? colIdsN.ptr()    : colIdsT.ptr();
+
+  const T*__restrict__ v_ptr = v.ptr();
+  const T*__restrict__ halo_ptr = haloBuf.ptr();
+  T*__restrict__ gv_ptr = gv.ptr();
+
+  const Op<T> op;
+
+  constexpr int simdWidth = ogsOperator_t::simdWidth;
+
+  const dlong NgatherRows = NlocalRows + NhaloRowsP;
+
+  if (K==1) {
+    #pragma omp parallel for schedule(static)
+    for(dlong b=blockStart;b<blockEnd;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], NgatherRows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        if (n>=NlocalRows) { //halo rows are copies from the halo buffer
+          gv_ptr[n] = halo_ptr[n-NlocalRows];
+          continue;
+        }
+
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
+
+        if (end-start==1) { //unit degree rows are straight copies
+          gv_ptr[n] = v_ptr[colIds[start]];
+          continue;
+        }
+
+        T val = op.init();
+        for(dlong g=start;g<end;++g){
+          op(val, v_ptr[colIds[g]]);
+        }
+        gv_ptr[n] = val;
+      }
+    }
+  } else {
+    #pragma omp parallel for schedule(static)
+    for(dlong b=blockStart;b<blockEnd;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], NgatherRows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const T* src = nullptr;
+        if (n>=NlocalRows) { //halo rows are copies from the halo buffer
+          src = halo_ptr + (n-NlocalRows)*K;
+        } else if (rowStarts[n+1]-rowStarts[n]==1) { //unit degree rows are straight copies
+          src = v_ptr + colIds[rowStarts[n]]*K;
+        }
+
+        if (src) {
+          #pragma omp simd
+          for (int k=0;k<K;++k) {
+            gv_ptr[k+n*K] = src[k];
+          }
+          continue;
+        }
+
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
+
+        //gather in short SIMD-width chunks of k
+        for (int k0=0;k0<K;k0+=simdWidth) {
+          const int Nk = std::min(simdWidth, K-k0);
+
+          T val[simdWidth];
+          for (int k=0;k<simdWidth;++k) val[k] = op.init();
+
+          for(dlong g=start;g<end;++g){
+            const T* v_row = v_ptr + k0 + colIds[g]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              op(val[k], v_row[k]);
+            }
+          }
+          for (int k=0;k<Nk;++k) {
+            gv_ptr[k0+k+n*K] = val[k];
+          }
+        }
+      }
+    }
+  }
+}
+
+template <template<typename> class U,
+          template<typename> class V,
+          typename T>
+void ogsFusedOperator_t::Gather(U<T> gv,
+                                const U<T> v,
+                                const V<T> haloBuf,
+                                const int k,
+                                const Op op,
+                                const Transpose trans,
+                                const Rows rows) {
+  const dlong blockStart = (rows==LocalRows) ? 0 : NlocalRowBlocksHost;
+  const dlong blockEnd   = (rows==LocalRows) ? NlocalRowBlocksHost : NrowBlocksHost;
+
+  switch (op){
+    case Add:
+      Gather<U, V, Op_Add, T>(gv, v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Mul:
+      Gather<U, V, Op_Mul, T>(gv, v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Max:
+      Gather<U, V, Op_Max, T>(gv, v, haloBuf, k, trans, blockStart, blockEnd); break;
+    case Min:
+      Gather<U, V, Op_Min, T>(gv, v, haloBuf, k, trans, blockStart, blockEnd); break;
+  }
+}
+
+template
+void ogsFusedOperator_t::Gather(memory<float> gv, const memory<float> v,
+                                const pinnedMemory<float> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(memory<double> gv, const memory<double> v,
+                                const pinnedMemory<double> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(memory<int> gv, const memory<int> v,
+                                const pinnedMemory<int> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(memory<long long int> gv, const memory<long long int> v,
+                                const pinnedMemory<long long int> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+
+template<typename T>
+void ogsFusedOperator_t::Gather(deviceMemory<T> o_gv,
+                                const deviceMemory<T> o_v,
+                                const deviceMemory<T> o_haloBuf,
+                                const int k,
+                                const Op op,
+                                const Transpose trans,
+                                const Rows rows) {
+  constexpr Type type = ogsType<T>::get();
+  InitializeKernels(platform, type, op);
+
+  const dlong blockStart = (rows==LocalRows) ? 0 : NlocalRowBlocks;
+  const dlong Nblocks    = (rows==LocalRows) ? NlocalRowBlocks : NrowBlocks-NlocalRowBlocks;
+
+  if (Nblocks)
+    gatherKernel[type][op](Nblocks,
+                           k,
+                           NlocalRows,
+                           NlocalRows + NhaloRowsP,
+                           o_blockRowStarts + blockStart,
+                           (trans==NoTrans) ? o_rowStartsN : o_rowStartsT,
+                           (trans==NoTrans) ? o_colIdsN    : o_colIdsT,
+                           o_v,
+                           o_haloBuf,
+                           o_gv);
+}
+
+template
+void ogsFusedOperator_t::Gather(deviceMemory<float> gv, const deviceMemory<float> v,
+                                const deviceMemory<float> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(deviceMemory<double> gv, const deviceMemory<double> v,
+                                const deviceMemory<double> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(deviceMemory<int> gv, const deviceMemory<int> v,
+                                const deviceMemory<int> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+template
+void ogsFusedOperator_t::Gather(deviceMemory<long long int> gv, const deviceMemory<long long int> v,
+                                const deviceMemory<long long int> haloBuf,
+                                const int k, const Op op, const Transpose trans,
+                                const Rows rows);
+
+/********************************
+ * Setup
+ ********************************/
+ogsFusedOperator_t::ogsFusedOperator_t(platform_t& _platform,
+                                       const ogsOperator_t& gatherLocal,
+                                       const ogsOperator_t& gatherHalo):
+  platform(_platform) {
+
+  NlocalRows = gatherLocal.NrowsT;
+  NhaloRows  = gatherHalo.NrowsT;
+  NhaloRowsP = gatherHalo.NrowsN;
+  Nrows = NlocalRows + NhaloRows;
+
+  const dlong nnzN = gatherLocal.nnzN + gatherHalo.nnzN;
+  const dlong nnzT = gatherLocal.nnzT + gatherHalo.nnzT;
+
+  rowStartsN.malloc(Nrows+1);
+  rowStartsT.malloc(Nrows+1);
+  colIdsN.malloc(nnzN);
+  colIdsT.malloc(nnzT);
+
+  //local rows first
+  rowStartsN.copyFrom(gatherLocal.rowStartsN, NlocalRows+1);
+  rowStartsT.copyFrom(gatherLocal.rowStartsT, NlocalRows+1);
+  colIdsN.copyFrom(gatherLocal.colIdsN, gatherLocal.nnzN);
+  colIdsT.copyFrom(gatherLocal.colIdsT, gatherLocal.nnzT);
+
+  //then the halo rows
+  for (dlong n=0;n<NhaloRows;n++) {
+    rowStartsN[NlocalRows+n+1] = gatherLocal.nnzN + gatherHalo.rowStartsN[n+1];
+    rowStartsT[NlocalRows+n+1] = gatherLocal.nnzT + gatherHalo.rowStartsT[n+1];
+  }
+  colIdsN.copyFrom(gatherHalo.colIdsN, gatherHalo.nnzN, gatherLocal.nnzN);
+  colIdsT.copyFrom(gatherHalo.colIdsT, gatherHalo.nnzT, gatherLocal.nnzT);
+
+  o_rowStartsN = platform.malloc(rowStartsN);
+  o_rowStartsT = platform.malloc(rowStartsT);
+  o_colIdsN = platform.malloc(colIdsN);
+  o_colIdsT = platform.malloc(colIdsT);
+
+  setupRowBlocks();
+}
+
+// Partition the rows such that each threadblock loads at most
+// gatherNodesPerBlock entries. Since every positive node is also
+// in the T operator, blocking on T rows also bounds the N rows.
+// A new block is always started at the first halo row so the
+// local and halo rows can be applied separately.
+void ogsFusedOperator_t::setupRowBlocks() {
+
+  constexpr dlong gatherNodesPerBlock = ogsOperator_t::gatherNodesPerBlock;
+
+  dlong blockSum=0;
+  NrowBlocks=0;
+  if (Nrows) NrowBlocks++;
+
+  for (dlong i=0;i<Nrows;i++) {
+    const dlong rowSize = rowStartsT[i+1]-rowStartsT[i];
+
+    //this row is pathalogically big. We can't currently run this
+    LIBP_ABORT("Multiplicity of global node id: " << i
+               << " in ogsFusedOperator_t::setupRowBlocks is too large.",
+               rowSize > gatherNodesPerBlock);
+
+    if (blockSum+rowSize > gatherNodesPerBlock
+        || (i==NlocalRows && i>0)) { //adding this row will exceed the nnz per block, or starts the halo rows
+      NrowBlocks++; //count the previous block
+      blockSum=rowSize; //start a new row block
+    } else {
+      blockSum+=rowSize; //add this row to the block
+    }
+  }
+
+  blockRowStarts.calloc(NrowBlocks+1);
+
+  blockSum=0;
+  NrowBlocks=0;
+  if (Nrows) NrowBlocks++;
+
+  for (dlong i=0;i<Nrows;i++) {
+    const dlong rowSize = rowStartsT[i+1]-rowStartsT[i];
+
+    if (blockSum+rowSize > gatherNodesPerBlock
+        || (i==NlocalRows && i>0)) { //adding this row will exceed the nnz per block, or starts the halo rows
+      blockRowStarts[NrowBlocks++] = i; //mark the previous block
+      blockSum=rowSize; //start a new row block
+    } else {
+      blockSum+=rowSize; //add this row to the block
+    }
+  }
+  blockRowStarts[NrowBlocks] = Nrows;
+
+  NlocalRowBlocks=0;
+  while (NlocalRowBlocks<NrowBlocks
+         && blockRowStarts[NlocalRowBlocks]<NlocalRows) NlocalRowBlocks++;
+
+  o_blockRowStarts = platform.malloc(blockRowStarts);
+
+  //block the local and halo rows separately on the host too
+  dlong NhaloRowBlocksHost=0;
+  memory<dlong> localBlockRowStarts, haloBlockRowStarts;
+  ogs::setupHostRowBlocks(NlocalRows, rowStartsT,
+                          NlocalRowBlocksHost, localBlockRowStarts);
+  ogs::setupHostRowBlocks(NhaloRows, rowStartsT + NlocalRows,
+                          NhaloRowBlocksHost, haloBlockRowStarts);
+
+  NrowBlocksHost = NlocalRowBlocksHost + NhaloRowBlocksHost;
+  blockRowStartsHost.malloc(NrowBlocksHost+1);
+  for (dlong b=0;b<NlocalRowBlocksHost;b++) {
+    blockRowStartsHost[b] = localBlockRowStarts[b];
+  }
+  for (dlong b=0;b<=NhaloRowBlocksHost;b++) {
+    blockRowStartsHost[NlocalRowBlocksHost+b] = NlocalRows + haloBlockRowStarts[b];
+  }
+}
+
+void ogsFusedOperator_t::Free() {
+  rowStartsT.free();
+  colIdsT.free();
+  rowStartsN.free();
+  colIdsN.free();
+
+  o_rowStartsT.free();
+  o_colIdsT.free();
+  o_rowStartsN.free();
+  o_colIdsN.free();
+
+  blockRowStarts.free();
+  o_blockRowStarts.free();
+  blockRowStartsHost.free();
+
+  NlocalRows=0;
+  NhaloRows=0;
+  NhaloRowsP=0;
+  Nrows=0;
+  NrowBlocks=0;
+  NlocalRowBlocks=0;
+  NrowBlocksHost=0;
+  NlocalRowBlocksHost=0;
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -28,6 +28,7 @@ SOFTWARE.
 #include "ogs/ogsUtils.hpp"
 #include "ogs/ogsOperator.hpp"
 #include "ogs/ogsExchange.hpp"
+#include "ogs/ogsStats.hpp"
 
 namespace libp {
 
@@ -38,12 +39,19 @@ namespace ogs {
  ********************************/
 template<typename T>
 void halo_t::Exchange(deviceMemory<T> o_v, const int k) {
+  LIBP_PROFILE("halo exchange");
   ExchangeStart (o_v, k);
   ExchangeFinish(o_v, k);
 }
 
 template<typename T>
 void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
+  if (stats) {
+    stats->Call(ogsStats_t::Exchange);
+    stats->Message(k*sizeof(T), NoTrans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
@@ -60,6 +68,7 @@ void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
 
     //prepare MPI exchange
     exchange->Start(o_haloBuf, k, Add, NoTrans);
+    if (stats) stats->End(ogsStats_t::Pack);
 
   } else {
     //get current stream
@@ -72,11 +81,14 @@ void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
     if (gathered_halo) {
       //wait for o_v to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_v + k*NlocalT, NhaloP*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     } else {
       //collect halo buffer
@@ -84,12 +96,27 @@ void halo_t::ExchangeStart(deviceMemory<T> o_v, const int k){
 
       //wait for o_haloBuf to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_haloBuf, NhaloP*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
+      device.setStream(currentStream);
+    }
+
+    //with a progress thread, start the MPI exchange now so it
+    // advances while the user's kernels execute
+    if (exchange->ProgressThreadActive()) {
+      device.setStream(dataStream);
+      device.finish();
       device.setStream(currentStream);
+
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start(haloBuf, k, Add, NoTrans);
+      if (stats) stats->End(ogsStats_t::Pack);
     }
   }
 }
@@ -102,14 +129,18 @@ void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
   //write exchanged halo buffer back to vector
   if (exchange->gpu_aware) {
     //finish MPI exchange
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(o_haloBuf, k, Add, NoTrans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
+    if (stats) stats->Begin(ogsStats_t::Unpack);
     if (gathered_halo) {
       o_haloBuf.copyTo(o_v + k*(NlocalT+NhaloP), k*Nhalo,
                        k*NhaloP, properties_t("async", true));
     } else {
       gatherHalo->Scatter(o_v, o_haloBuf, k, NoTrans);
     }
+    if (stats) stats->End(ogsStats_t::Unpack);
   } else {
     pinnedMemory<T> haloBuf = exchange->h_workspace;
 
@@ -122,22 +153,34 @@ void halo_t::ExchangeFinish(deviceMemory<T> o_v, const int k){
     device.finish();
 
     /*MPI exchange of host buffer*/
-    exchange->Start (haloBuf, k, Add, NoTrans);
+    if (!exchange->ProgressThreadActive()) {
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start (haloBuf, k, Add, NoTrans);
+      if (stats) stats->End(ogsStats_t::Pack);
+    }
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(haloBuf, k, Add, NoTrans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
     // copy recv back to device
     if (gathered_halo) {
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_v + k*(NlocalT+NhaloP), k*Nhalo,
                      k*NhaloP, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     } else {
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_haloBuf+k*NhaloP, k*Nhalo,
                      k*NhaloP, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
 
+      if (stats) stats->Begin(ogsStats_t::Unpack);
       gatherHalo->Scatter(o_v, o_haloBuf, k, NoTrans);
+      if (stats) stats->End(ogsStats_t::Unpack);
     }
   }
 }
@@ -158,12 +201,19 @@ template void halo_t::Exchange(deviceMemory<long long int> o_v, const int k);
 //host version
 template<typename T>
 void halo_t::Exchange(memory<T> v, const int k) {
+  LIBP_PROFILE("halo exchange");
   ExchangeStart (v, k);
   ExchangeFinish(v, k);
 }
 
 template<typename T>
 void halo_t::ExchangeStart(memory<T> v, const int k) {
+  if (stats) {
+    stats->Call(ogsStats_t::Exchange);
+    stats->Message(k*sizeof(T), NoTrans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   pinnedMemory<T> haloBuf = exchange->h_workspace;
@@ -178,6 +228,8 @@ void halo_t::ExchangeStart(memory<T> v, const int k) {
 
   //Prepare MPI exchange
   exchange->Start(haloBuf, k, Add, NoTrans);
+
+  if (stats) stats->End(ogsStats_t::Pack);
 }
 
 template<typename T>
@@ -186,9 +238,12 @@ void halo_t::ExchangeFinish(memory<T> v, const int k) {
   pinnedMemory<T> haloBuf = exchange->h_workspace;
 
   //finish MPI exchange
+  if (stats) stats->Begin(ogsStats_t::Wait);
   exchange->Finish(haloBuf, k, Add, NoTrans);
+  if (stats) stats->End(ogsStats_t::Wait);
 
   //write exchanged halo buffer back to vector
+  if (stats) stats->Begin(ogsStats_t::Unpack);
   if (gathered_halo) {
     //if this halo was build from a gathered ogs the halo nodes are at the end
     haloBuf.copyTo(v + k*(NlocalT+NhaloP),
@@ -197,6 +252,7 @@ void halo_t::ExchangeFinish(memory<T> v, const int k) {
   } else {
     gatherHalo->Scatter(v, haloBuf, k, NoTrans);
   }
+  if (stats) stats->End(ogsStats_t::Unpack);
 }
 
 template void halo_t::ExchangeStart(memory<float> v, const int k);
@@ -223,6 +279,12 @@ void halo_t::Combine(deviceMemory<T> o_v, const int k) {
 
 template<typename T>
 void halo_t::CombineStart(deviceMemory<T> o_v, const int k){
+  if (stats) {
+    stats->Call(ogsStats_t::Combine);
+    stats->Message(k*sizeof(T), Trans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   deviceMemory<T> o_haloBuf = exchange->o_workspace;
@@ -239,6 +301,7 @@ void halo_t::CombineStart(deviceMemory<T> o_v, const int k){
 
     //prepare MPI exchange
     exchange->Start(o_haloBuf, k, Add, Trans);
+    if (stats) stats->End(ogsStats_t::Pack);
   } else {
     //get current stream
     device_t &device = platform.device;
@@ -250,11 +313,14 @@ void halo_t::CombineStart(deviceMemory<T> o_v, const int k){
     if (gathered_halo) {
       //wait for o_v to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_v + k*NlocalT, NhaloT*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     } else {
       //collect halo buffer
@@ -262,12 +328,27 @@ void halo_t::CombineStart(deviceMemory<T> o_v, const int k){
 
       //wait for o_haloBuf to be ready
       device.finish();
+      if (stats) stats->End(ogsStats_t::Pack);
 
       //queue copy to host
       device.setStream(dataStream);
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyFrom(o_haloBuf, NhaloT*k,
                        0, properties_t("async", true));
+      if (stats) stats->End(ogsStats_t::Staging);
+      device.setStream(currentStream);
+    }
+
+    //with a progress thread, start the MPI exchange now so it
+    // advances while the user's kernels execute
+    if (exchange->ProgressThreadActive()) {
+      device.setStream(dataStream);
+      device.finish();
       device.setStream(currentStream);
+
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start(haloBuf, k, Add, Trans);
+      if (stats) stats->End(ogsStats_t::Pack);
     }
   }
 }
@@ -280,8 +361,11 @@ void halo_t::CombineFinish(deviceMemory<T> o_v, const int k){
   //write exchanged halo buffer back to vector
   if (exchange->gpu_aware) {
     //finish MPI exchange
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(o_haloBuf, k, Add, Trans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
+    if (stats) stats->Begin(ogsStats_t::Unpack);
     if (gathered_halo) {
       //if this halo was build from a gathered ogs the halo nodes are at the end
       o_haloBuf.copyTo(o_v + k*NlocalT, k*NhaloP,
@@ -289,6 +373,7 @@ void halo_t::CombineFinish(deviceMemory<T> o_v, const int k){
     } else {
       gatherHalo->Scatter(o_v, o_haloBuf, k, Trans);
     }
+    if (stats) stats->End(ogsStats_t::Unpack);
   } else {
     pinnedMemory<T> haloBuf = exchange->h_workspace;
 
@@ -301,22 +386,34 @@ void halo_t::CombineFinish(deviceMemory<T> o_v, const int k){
     device.finish();
 
     /*MPI exchange of host buffer*/
-    exchange->Start (haloBuf, k, Add, Trans);
+    if (!exchange->ProgressThreadActive()) {
+      if (stats) stats->Begin(ogsStats_t::Pack);
+      exchange->Start (haloBuf, k, Add, Trans);
+      if (stats) stats->End(ogsStats_t::Pack);
+    }
+    if (stats) stats->Begin(ogsStats_t::Wait);
     exchange->Finish(haloBuf, k, Add, Trans);
+    if (stats) stats->End(ogsStats_t::Wait);
 
     if (gathered_halo) {
       // copy recv back to device
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_v + k*NlocalT, NhaloP*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
     } else {
+      if (stats) stats->Begin(ogsStats_t::Staging);
       haloBuf.copyTo(o_haloBuf, NhaloP*k,
                      0, properties_t("async", true));
       device.finish(); //wait for transfer to finish
+      if (stats) stats->End(ogsStats_t::Staging);
       device.setStream(currentStream);
 
+      if (stats) stats->Begin(ogsStats_t::Unpack);
       gatherHalo->Scatter(o_v, o_haloBuf, k, Trans);
+      if (stats) stats->End(ogsStats_t::Unpack);
     }
   }
 }
@@ -343,6 +440,12 @@ void halo_t::Combine(memory<T> v, const int k) {
 
 template<typename T>
 void halo_t::CombineStart(memory<T> v, const int k) {
+  if (stats) {
+    stats->Call(ogsStats_t::Combine);
+    stats->Message(k*sizeof(T), Trans);
+    stats->Begin(ogsStats_t::Pack);
+  }
+
   exchange->AllocBuffer(k*sizeof(T));
 
   pinnedMemory<T> haloBuf = exchange->h_workspace;
@@ -357,6 +460,8 @@ void halo_t::CombineStart(memory<T> v, const int k) {
 
   //Prepare MPI exchange
   exchange->Start(haloBuf, k, Add, Trans);
+
+  if (stats) stats->End(ogsStats_t::Pack);
 }
 
 
@@ -366,15 +471,19 @@ void halo_t::CombineFinish(memory<T> v, const int k) {
   pinnedMemory<T> haloBuf = exchange->h_workspace;
 
   //finish MPI exchange
+  if (stats) stats->Begin(ogsStats_t::Wait);
   exchange->Finish(haloBuf, k, Add, Trans);
+  if (stats) stats->End(ogsStats_t::Wait);
 
   //write exchanged halo buffer back to vector
+  if (stats) stats->Begin(ogsStats_t::Unpack);
   if (gathered_halo) {
     //if this halo was build from a gathered ogs the halo nodes are at the end
     haloBuf.copyTo(v + k*NlocalT, k*NhaloP);
   } else {
     gatherHalo->Scatter(v, haloBuf, k, Trans);
   }
+  if (stats) stats->End(ogsStats_t::Unpack);
 }
 
 template void halo_t::CombineStart(memory<float> v, const int k);
@@ -0,0 +1,540 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsExchange.hpp"
+
+#ifdef GLIBCXX_PARALLEL
+#include <parallel/algorithm>
+using __gnu_parallel::sort;
+#else
+using std::sort;
+#endif
+
+namespace libp {
+
+namespace ogs {
+
+//raw view into the shared window, for passing to comm_t
+template<typename T>
+struct windowView {
+  T *p;
+  T* ptr() { return p; }
+  const T* ptr() const { return p; }
+};
+
+//sparse gather from the shared window
+template <template<typename> class Op,
+          typename T>
+static void windowGather(const dlong Nrows,
+                         const dlong *__restrict__ rowStarts,
+                         const dlong *__restrict__ colIds,
+                         const int K,
+                         const T *__restrict__ v,
+                         T *__restrict__ gv) {
+  const Op<T> op;
+
+  #pragma omp parallel for
+  for(dlong n=0;n<Nrows;++n){
+    const dlong start = rowStarts[n];
+    const dlong end   = rowStarts[n+1];
+
+    for (int k=0;k<K;++k) {
+      T val = op.init();
+      for(dlong g=start;g<end;++g){
+        op(val, v[k+colIds[g]*K]);
+      }
+      gv[k+n*K] = val;
+    }
+  }
+}
+
+template <typename T>
+static void windowGather(const dlong Nrows,
+                         const memory<dlong> rowStarts,
+                         const memory<dlong> colIds,
+                         const int K,
+                         const Op op,
+                         const T *v,
+                         T *gv) {
+  switch (op){
+    case Add:
+      windowGather<Op_Add, T>(Nrows, rowStarts.ptr(), colIds.ptr(), K, v, gv); break;
+    case Mul:
+      windowGather<Op_Mul, T>(Nrows, rowStarts.ptr(), colIds.ptr(), K, v, gv); break;
+    case Max:
+      windowGather<Op_Max, T>(Nrows, rowStarts.ptr(), colIds.ptr(), K, v, gv); break;
+    case Min:
+      windowGather<Op_Min, T>(Nrows, rowStarts.ptr(), colIds.ptr(), K, v, gv); break;
+  }
+}
+
+void ogsHierarchical_t::NodeSync() {
+  nodeComm.WinSync(window);
+  nodeComm.Barrier();
+  nodeComm.WinSync(window);
+}
+
+/**********************************
+* Host exchange
+***********************************/
+template<typename T>
+inline void ogsHierarchical_t::Start(pinnedMemory<T> &buf, const int k,
+                                     const Op op, const Transpose trans){
+
+  T *win = static_cast<T*>(windowBase);
+
+  //wait for the node to finish reading the window from the last exchange
+  NodeSync();
+
+  //write this rank's halo contributions to the window
+  const dlong Ncontrib = (trans==NoTrans) ? NhaloP : Nhalo;
+  if (Ncontrib) {
+    std::memcpy(win + segOffset*k, buf.ptr(), Ncontrib*k*sizeof(T));
+  }
+
+  //post recvs of the other nodes' partial results
+  for (int r=0;r<NnbrNodes;r++) {
+    comm.Irecv(windowView<T>{win + (recvOffset+nbrOffsets[r])*k},
+               nbrNodes[r],
+               k*nbrCounts[r],
+               nbrNodes[r],
+               requests[r]);
+  }
+
+  //wait for all contributions on this node
+  NodeSync();
+
+  if (NnbrNodes) {
+    pinnedMemory<T> sendBuf = h_sendspace;
+
+    //combine this node's contributions to each outgoing entry
+    if (trans==NoTrans)
+      windowGather(Nslots, sendStartsN, sendIdsN, k, op, win, sendBuf.ptr());
+    else
+      windowGather(Nslots, sendStartsT, sendIdsT, k, op, win, sendBuf.ptr());
+
+    //post sends
+    for (int r=0;r<NnbrNodes;r++) {
+      comm.Isend(sendBuf + nbrOffsets[r]*k,
+                 nbrNodes[r],
+                 k*nbrCounts[r],
+                 rank,
+                 requests[NnbrNodes+r]);
+    }
+  }
+
+  ProgressStart(2*NnbrNodes, requests);
+}
+
+template<typename T>
+inline void ogsHierarchical_t::Finish(pinnedMemory<T> &buf, const int k,
+                                      const Op op, const Transpose trans){
+
+  ProgressStop();
+  comm.Waitall(2*NnbrNodes, requests);
+
+  //wait for the leader's recvs to land in the window
+  NodeSync();
+
+  //gather the node-local and remote contributions to each halo node
+  const T *win = static_cast<T*>(windowBase);
+  if (trans==NoTrans)
+    windowGather(Nhalo, rowStartsN, colIdsN, k, op, win, buf.ptr());
+  else
+    windowGather(Nhalo, rowStartsT, colIdsT, k, op, win, buf.ptr());
+}
+
+void ogsHierarchical_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+/**********************************
+* Device exchange
+***********************************/
+// The node aggregation happens in host shared memory, so device
+// buffers are always staged through the host workspace
+template<typename T>
+void ogsHierarchical_t::Start(deviceMemory<T> &o_buf,
+                              const int k,
+                              const Op op,
+                              const Transpose trans){
+  pinnedMemory<T> buf = h_workspace;
+
+  const dlong Ncontrib = (trans==NoTrans) ? NhaloP : Nhalo;
+  o_buf.copyTo(buf, Ncontrib*k);
+
+  Start(buf, k, op, trans);
+}
+
+template<typename T>
+void ogsHierarchical_t::Finish(deviceMemory<T> &o_buf,
+                               const int k,
+                               const Op op,
+                               const Transpose trans){
+  pinnedMemory<T> buf = h_workspace;
+
+  Finish(buf, k, op, trans);
+
+  o_buf.copyFrom(buf, Nhalo*k);
+}
+
+void ogsHierarchical_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsHierarchical_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+ogsHierarchical_t::ogsHierarchical_t(dlong Nshared,
+                                     memory<parallelNode_t> &sharedNodes,
+                                     ogsOperator_t& gatherHalo,
+                                     stream_t _dataStream,
+                                     comm_t _comm,
+                                     platform_t &_platform):
+  ogsExchange_t(_platform,_comm,_dataStream) {
+
+  Nhalo  = gatherHalo.NrowsT;
+  NhaloP = gatherHalo.NrowsN;
+
+  //the node aggregation is done in host memory
+  gpu_aware = false;
+
+  nodeComm = comm.SplitShared(rank);
+  nodeRank = nodeComm.rank();
+  nodeSize = nodeComm.size();
+
+  //label each node by the rank of its leader
+  int nodeId = rank;
+  nodeComm.Bcast(nodeId, 0);
+
+  memory<int> nodeIds(size);
+  nodeIds[rank] = nodeId;
+  comm.Allgather(nodeIds, 1);
+
+  // Every halo node on this rank is a contribution to the node's
+  // aggregation. Each is identified by (nodeRank, localId) and
+  // grouped by its baseId.
+  memory<parallelNode_t> contribs(Nhalo);
+  for (dlong n=0;n<Nshared;n++) {
+    const dlong id = sharedNodes[n].newId;
+    contribs[id].localId = id;
+    contribs[id].baseId  = abs(sharedNodes[n].baseId);
+    contribs[id].newId   = 0;
+    contribs[id].sign    = (id<NhaloP) ? 2 : -2;
+    contribs[id].rank    = nodeRank;
+    contribs[id].destRank = nodeId;
+  }
+
+  //list the other nodes each baseId must be sent to
+  dlong Nlinks=0;
+  for (dlong n=0;n<Nshared;n++) {
+    if (nodeIds[sharedNodes[n].rank]!=nodeId) Nlinks++;
+  }
+
+  memory<parallelNode_t> links(Nlinks);
+  Nlinks=0;
+  for (dlong n=0;n<Nshared;n++) {
+    const int destNode = nodeIds[sharedNodes[n].rank];
+    if (destNode!=nodeId) {
+      links[Nlinks] = sharedNodes[n];
+      links[Nlinks].baseId = abs(sharedNodes[n].baseId);
+      links[Nlinks].destRank = destNode;
+      Nlinks++;
+    }
+  }
+
+  auto linkOrder = [](const parallelNode_t& a, const parallelNode_t& b) {
+                     if(a.destRank < b.destRank) return true; //group by node
+                     if(a.destRank > b.destRank) return false;
+
+                     return a.baseId < b.baseId; //then order by baseId
+                   };
+  auto linkEqual = [](const parallelNode_t& a, const parallelNode_t& b) {
+                     return a.destRank==b.destRank && a.baseId==b.baseId;
+                   };
+
+  sort(links.ptr(), links.ptr()+Nlinks, linkOrder);
+  Nlinks = std::unique(links.ptr(), links.ptr()+Nlinks, linkEqual) - links.ptr();
+
+  //collect everything on the node leader
+  memory<int> contribCounts(nodeSize);
+  memory<int> contribOffsets(nodeSize+1);
+  memory<int> linkCounts(nodeSize);
+  memory<int> linkOffsets(nodeSize+1);
+
+  nodeComm.Gather(static_cast<int>(Nhalo), contribCounts, 0);
+  nodeComm.Gather(static_cast<int>(Nlinks), linkCounts, 0);
+
+  dlong NcontribTotal=0, NlinksTotal=0;
+  if (nodeRank==0) {
+    contribOffsets[0] = 0;
+    linkOffsets[0] = 0;
+    for (int r=0;r<nodeSize;r++) {
+      contribOffsets[r+1] = contribOffsets[r] + contribCounts[r];
+      linkOffsets[r+1] = linkOffsets[r] + linkCounts[r];
+    }
+    NcontribTotal = contribOffsets[nodeSize];
+    NlinksTotal = linkOffsets[nodeSize];
+  }
+
+  memory<parallelNode_t> nodeContribs(NcontribTotal);
+  memory<parallelNode_t> nodeLinks(NlinksTotal);
+
+  nodeComm.Gatherv(contribs, Nhalo, nodeContribs,
+                   contribCounts, contribOffsets, 0);
+  nodeComm.Gatherv(links, Nlinks, nodeLinks,
+                   linkCounts, linkOffsets, 0);
+
+  memory<dlong> rowCountsN(NcontribTotal);
+  memory<dlong> rowCountsT(NcontribTotal);
+  memory<int> nnzCountsN(nodeSize);
+  memory<int> nnzCountsT(nodeSize);
+  memory<int> nnzOffsetsN(nodeSize+1);
+  memory<int> nnzOffsetsT(nodeSize+1);
+  memory<dlong> nodeColIdsN;
+  memory<dlong> nodeColIdsT;
+  memory<dlong> segOffsets(nodeSize);
+  memory<dlong> segSizes(nodeSize);
+
+  if (nodeRank==0) {
+    // The leader builds the node's view of the exchange. Each distinct
+    // (destination node, baseId) pair is one slot in the message to
+    // that node. Both nodes order the slots by baseId, so the received
+    // slots line up with the sent ones.
+    sort(nodeLinks.ptr(), nodeLinks.ptr()+NlinksTotal, linkOrder);
+    Nslots = std::unique(nodeLinks.ptr(), nodeLinks.ptr()+NlinksTotal, linkEqual)
+              - nodeLinks.ptr();
+
+    NnbrNodes=0;
+    for (dlong n=0;n<Nslots;n++) {
+      if (n==0 || nodeLinks[n].destRank!=nodeLinks[n-1].destRank) NnbrNodes++;
+    }
+    nbrNodes.malloc(NnbrNodes);
+    nbrCounts.calloc(NnbrNodes);
+    nbrOffsets.malloc(NnbrNodes+1);
+
+    NnbrNodes=0;
+    nbrOffsets[0]=0;
+    for (dlong n=0;n<Nslots;n++) {
+      if (n==0 || nodeLinks[n].destRank!=nodeLinks[n-1].destRank) {
+        nbrNodes[NnbrNodes++] = nodeLinks[n].destRank;
+      }
+      nbrCounts[NnbrNodes-1]++;
+      nbrOffsets[NnbrNodes] = n+1;
+    }
+
+    // Window layout, in words: the leader's halo then the recv slots,
+    // followed by each other rank's halo.
+    recvOffset = contribCounts[0];
+    segOffsets[0] = 0;
+    segSizes[0] = contribCounts[0] + Nslots;
+    for (int r=1;r<nodeSize;r++) {
+      segOffsets[r] = segOffsets[r-1] + segSizes[r-1];
+      segSizes[r] = contribCounts[r];
+    }
+
+    //record the window location of each contribution and group by baseId
+    memory<parallelNode_t> groups(NcontribTotal);
+    for (int r=0;r<nodeSize;r++) {
+      for (dlong n=contribOffsets[r];n<contribOffsets[r+1];n++) {
+        groups[n] = nodeContribs[n];
+        groups[n].newId = segOffsets[r] + nodeContribs[n].localId;
+      }
+    }
+    sort(groups.ptr(), groups.ptr()+NcontribTotal,
+         [](const parallelNode_t& a, const parallelNode_t& b) {
+           return a.baseId < b.baseId;
+         });
+
+    //recv slots grouped by baseId
+    memory<parallelNode_t> slots(Nslots);
+    for (dlong n=0;n<Nslots;n++) {
+      slots[n].baseId = nodeLinks[n].baseId;
+      slots[n].newId  = recvOffset + n;
+    }
+    sort(slots.ptr(), slots.ptr()+Nslots,
+         [](const parallelNode_t& a, const parallelNode_t& b) {
+           return a.baseId < b.baseId;
+         });
+
+    auto baseIdLess = [](const parallelNode_t& a, const parallelNode_t& b) {
+                        return a.baseId < b.baseId;
+                      };
+
+    //send slots gather this node's contributions to each baseId
+    sendStartsN.malloc(Nslots+1);
+    sendStartsT.malloc(Nslots+1);
+    sendStartsN[0] = 0;
+    sendStartsT[0] = 0;
+    for (dlong n=0;n<Nslots;n++) {
+      auto range = std::equal_range(groups.ptr(), groups.ptr()+NcontribTotal,
+                                    nodeLinks[n], baseIdLess);
+      dlong cntN=0;
+      for (auto g=range.first;g!=range.second;g++) {
+        if (g->sign==2) cntN++;
+      }
+      sendStartsN[n+1] = sendStartsN[n] + cntN;
+      sendStartsT[n+1] = sendStartsT[n] + (range.second-range.first);
+    }
+    sendIdsN.malloc(sendStartsN[Nslots]);
+    sendIdsT.malloc(sendStartsT[Nslots]);
+    for (dlong n=0;n<Nslots;n++) {
+      auto range = std::equal_range(groups.ptr(), groups.ptr()+NcontribTotal,
+                                    nodeLinks[n], baseIdLess);
+      dlong cntN=sendStartsN[n], cntT=sendStartsT[n];
+      for (auto g=range.first;g!=range.second;g++) {
+        if (g->sign==2) sendIdsN[cntN++] = g->newId;
+        sendIdsT[cntT++] = g->newId;
+      }
+    }
+
+    // Each halo node gathers all contributions to its baseId on this
+    // node, along with the partial results recieved from other nodes
+    for (dlong n=0;n<NcontribTotal;n++) {
+      auto grange = std::equal_range(groups.ptr(), groups.ptr()+NcontribTotal,
+                                     nodeContribs[n], baseIdLess);
+      auto srange = std::equal_range(slots.ptr(), slots.ptr()+Nslots,
+                                     nodeContribs[n], baseIdLess);
+      dlong cntN=0;
+      for (auto g=grange.first;g!=grange.second;g++) {
+        if (g->sign==2) cntN++;
+      }
+      const dlong Nrecv = srange.second-srange.first;
+      rowCountsN[n] = cntN + Nrecv;
+      rowCountsT[n] = (grange.second-grange.first) + Nrecv;
+    }
+
+    nnzOffsetsN[0] = 0;
+    nnzOffsetsT[0] = 0;
+    for (int r=0;r<nodeSize;r++) {
+      nnzCountsN[r] = 0;
+      nnzCountsT[r] = 0;
+      for (dlong n=contribOffsets[r];n<contribOffsets[r+1];n++) {
+        nnzCountsN[r] += rowCountsN[n];
+        nnzCountsT[r] += rowCountsT[n];
+      }
+      nnzOffsetsN[r+1] = nnzOffsetsN[r] + nnzCountsN[r];
+      nnzOffsetsT[r+1] = nnzOffsetsT[r] + nnzCountsT[r];
+    }
+
+    nodeColIdsN.malloc(nnzOffsetsN[nodeSize]);
+    nodeColIdsT.malloc(nnzOffsetsT[nodeSize]);
+
+    dlong cntN=0, cntT=0;
+    for (dlong n=0;n<NcontribTotal;n++) {
+      auto grange = std::equal_range(groups.ptr(), groups.ptr()+NcontribTotal,
+                                     nodeContribs[n], baseIdLess);
+      auto srange = std::equal_range(slots.ptr(), slots.ptr()+Nslots,
+                                     nodeContribs[n], baseIdLess);
+      for (auto g=grange.first;g!=grange.second;g++) {
+        if (g->sign==2) nodeColIdsN[cntN++] = g->newId;
+        nodeColIdsT[cntT++] = g->newId;
+      }
+      for (auto s=srange.first;s!=srange.second;s++) {
+        nodeColIdsN[cntN++] = s->newId;
+        nodeColIdsT[cntT++] = s->newId;
+      }
+    }
+
+    requests.malloc(2*NnbrNodes);
+
+    h_sendspace = platform.hostMalloc<char>(Nslots*sizeof(dfloat));
+  }
+
+  //send each rank its window segment and gather operator
+  memory<dlong> seg(2);
+  nodeComm.Scatter(segOffsets, seg, 0, 1);
+  nodeComm.Scatter(segSizes, seg+1, 0, 1);
+  segOffset = seg[0];
+  segWords = seg[1];
+
+  memory<dlong> haloCountsN(Nhalo);
+  memory<dlong> haloCountsT(Nhalo);
+  nodeComm.Scatterv(rowCountsN, contribCounts, contribOffsets,
+                    haloCountsN, Nhalo, 0);
+  nodeComm.Scatterv(rowCountsT, contribCounts, contribOffsets,
+                    haloCountsT, Nhalo, 0);
+
+  rowStartsN.malloc(Nhalo+1);
+  rowStartsT.malloc(Nhalo+1);
+  rowStartsN[0] = 0;
+  rowStartsT[0] = 0;
+  for (dlong n=0;n<Nhalo;n++) {
+    rowStartsN[n+1] = rowStartsN[n] + haloCountsN[n];
+    rowStartsT[n+1] = rowStartsT[n] + haloCountsT[n];
+  }
+
+  colIdsN.malloc(rowStartsN[Nhalo]);
+  colIdsT.malloc(rowStartsT[Nhalo]);
+  nodeComm.Scatterv(nodeColIdsN, nnzCountsN, nnzOffsetsN,
+                    colIdsN, rowStartsN[Nhalo], 0);
+  nodeComm.Scatterv(nodeColIdsT, nnzCountsT, nnzOffsetsT,
+                    colIdsT, rowStartsT[Nhalo], 0);
+
+  //make scratch space
+  AllocBuffer(sizeof(dfloat));
+}
+
+void ogsHierarchical_t::AllocBuffer(size_t Nbytes) {
+  if (h_workspace.size() < Nhalo*Nbytes) {
+    h_workspace = platform.hostMalloc<char>(Nhalo*Nbytes);
+    o_workspace = platform.malloc<char>(Nhalo*Nbytes);
+  }
+  if (h_sendspace.size() < Nslots*Nbytes) {
+    h_sendspace = platform.hostMalloc<char>(Nslots*Nbytes);
+  }
+
+  //every rank on the node requests the same word size,
+  // so all ranks agree on when the window must grow
+  if (windowBytes < Nbytes) {
+    nodeComm.WinFree(window);
+
+    void *segBase;
+    nodeComm.WinAllocateShared(segWords*Nbytes, window, segBase);
+    nodeComm.WinSharedQuery(window, 0, windowBase);
+    windowBytes = Nbytes;
+
+    LIBP_ABORT("Shared memory window is not contiguous",
+               static_cast<char*>(segBase) - static_cast<char*>(windowBase)
+               != static_cast<std::ptrdiff_t>(segOffset*Nbytes));
+  }
+}
+
+ogsHierarchical_t::~ogsHierarchical_t() {
+  nodeComm.WinFree(window);
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -0,0 +1,216 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+void ogsNeighborhood_t::SetCounts(const int k, const Transpose trans) {
+  if (trans==NoTrans) {
+    for (int r=0;r<NranksSendT;++r) {
+      sendCounts[r]  = k*nbrSendCountsN[r];
+      sendOffsets[r] = k*nbrSendOffsetsN[r];
+    }
+    for (int r=0;r<NranksRecvT;++r) {
+      recvCounts[r]  = k*nbrRecvCountsN[r];
+      recvOffsets[r] = k*nbrRecvOffsetsN[r];
+    }
+  } else {
+    for (int r=0;r<NranksSendT;++r) {
+      sendCounts[r]  = k*sendCountsT[r];
+      sendOffsets[r] = k*sendOffsetsT[r];
+    }
+    for (int r=0;r<NranksRecvT;++r) {
+      recvCounts[r]  = k*recvCountsT[r];
+      recvOffsets[r] = k*recvOffsetsT[r];
+    }
+  }
+}
+
+/**********************************
+* Host exchange
+***********************************/
+template<typename T>
+inline void ogsNeighborhood_t::Start(pinnedMemory<T> &buf, const int k,
+                                     const Op op, const Transpose trans){
+
+  pinnedMemory<T> sendBuf = h_sendspace;
+
+  // extract the send buffer
+  if (trans == NoTrans)
+    extract(NsendN, k, sendIdsN, buf, sendBuf);
+  else
+    extract(NsendT, k, sendIdsT, buf, sendBuf);
+
+  SetCounts(k, trans);
+
+  // exchange with all neighbors in a single neighborhood collective
+  graphComm.INeighborAlltoallv(sendBuf,     sendCounts, sendOffsets,
+                               buf+Nhalo*k, recvCounts, recvOffsets,
+                               request[0]);
+
+  ProgressStart(1, request);
+}
+
+template<typename T>
+inline void ogsNeighborhood_t::Finish(pinnedMemory<T> &buf, const int k,
+                                      const Op op, const Transpose trans){
+
+  ProgressStop();
+  graphComm.Wait(request[0]);
+
+  //if we recvieved anything via MPI, gather the recv buffer and scatter
+  // it back to to original vector
+  dlong Nrecv = (trans==NoTrans) ? recvOffsetsN[NranksRecvN]
+                                 : recvOffsetsT[NranksRecvT];
+  if (Nrecv) {
+    // gather the recieved nodes
+    postmpi.Gather(buf, buf, k, op, trans);
+  }
+}
+
+void ogsNeighborhood_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+/**********************************
+* GPU-aware exchange
+***********************************/
+template<typename T>
+void ogsNeighborhood_t::Start(deviceMemory<T> &o_buf,
+                              const int k,
+                              const Op op,
+                              const Transpose trans){
+
+  const dlong Nsend = (trans == NoTrans) ? NsendN : NsendT;
+
+  if (Nsend) {
+    deviceMemory<T> o_sendBuf = o_sendspace;
+
+    // assemble the send buffer on device
+    if (trans == NoTrans) {
+      extractKernel[ogsType<T>::get()](NsendN, k, o_sendIdsN, o_buf, o_sendBuf);
+    } else {
+      extractKernel[ogsType<T>::get()](NsendT, k, o_sendIdsT, o_buf, o_sendBuf);
+    }
+    //wait for kernel to finish on default stream
+    device_t &device = platform.device;
+    device.finish();
+  }
+}
+
+template<typename T>
+void ogsNeighborhood_t::Finish(deviceMemory<T> &o_buf,
+                               const int k,
+                               const Op op,
+                               const Transpose trans){
+
+  deviceMemory<T> o_sendBuf = o_sendspace;
+
+  SetCounts(k, trans);
+
+  // exchange with all neighbors in a single neighborhood collective
+  graphComm.NeighborAlltoallv(o_sendBuf,     sendCounts, sendOffsets,
+                              o_buf+Nhalo*k, recvCounts, recvOffsets);
+
+  //if we recvieved anything via MPI, gather the recv buffer and scatter
+  // it back to to original vector
+  dlong Nrecv = (trans==NoTrans) ? recvOffsetsN[NranksRecvN]
+                                 : recvOffsetsT[NranksRecvT];
+  if (Nrecv) {
+    // gather the recieved nodes on device
+    postmpi.Gather(o_buf, o_buf, k, op, trans);
+  }
+}
+
+void ogsNeighborhood_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsNeighborhood_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+ogsNeighborhood_t::ogsNeighborhood_t(dlong Nshared,
+                                     memory<parallelNode_t> &sharedNodes,
+                                     ogsOperator_t& gatherHalo,
+                                     stream_t _dataStream,
+                                     comm_t _comm,
+                                     platform_t &_platform):
+  ogsPairwise_t(Nshared, sharedNodes, gatherHalo,
+                _dataStream, _comm, _platform) {
+
+  // The pairwise setup gives the list of ranks we send to and
+  // recv from. Every rank we exchange with in the NoTrans direction
+  // is also a neighbor in the Trans direction, so the Trans lists
+  // define the graph topology.
+  graphComm = comm.DistGraphCreateAdjacent(NranksRecvT, recvRanksT,
+                                           NranksSendT, sendRanksT);
+
+  // Pad the NoTrans counts out to the full neighbor lists
+  nbrSendCountsN.calloc(NranksSendT);
+  nbrSendOffsetsN.calloc(NranksSendT);
+  nbrRecvCountsN.calloc(NranksRecvT);
+  nbrRecvOffsetsN.calloc(NranksRecvT);
+
+  int cnt=0;
+  for (int r=0;r<NranksSendT;++r) {
+    nbrSendOffsetsN[r] = sendOffsetsN[cnt];
+    if (cnt<NranksSendN && sendRanksN[cnt]==sendRanksT[r]) {
+      nbrSendCountsN[r] = sendCountsN[cnt];
+      cnt++;
+    }
+  }
+
+  cnt=0;
+  for (int r=0;r<NranksRecvT;++r) {
+    nbrRecvOffsetsN[r] = recvOffsetsN[cnt];
+    if (cnt<NranksRecvN && recvRanksN[cnt]==recvRanksT[r]) {
+      nbrRecvCountsN[r] = recvCountsN[cnt];
+      cnt++;
+    }
+  }
+
+  sendCounts.malloc(NranksSendT);
+  sendOffsets.malloc(NranksSendT);
+  recvCounts.malloc(NranksRecvT);
+  recvOffsets.malloc(NranksRecvT);
+
+  request.malloc(1);
+}
+
+} //namespace ogs
+
+} //namespace libp
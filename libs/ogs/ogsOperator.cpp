@@ -24,7 +24,7 @@ SOFTWARE.
 
 */
 
-#include <limits>
+#include <algorithm>
 #include "ogs.hpp"
 #include "ogs/ogsUtils.hpp"
 #include "ogs/ogsOperator.hpp"
@@ -33,27 +33,6 @@ namespace libp {
 
 namespace ogs {
 
-template<typename T>
-struct Op_Add {
-  inline const T init() const { return T{0}; }
-  inline void operator()(T& gv, const T v) const { gv += v; }
-};
-template<typename T>
-struct Op_Mul {
-  inline const T init() const { return T{1}; }
-  inline void operator()(T& gv, const T v) const { gv *= v; }
-};
-template<typename T>
-struct Op_Max {
-  inline const T init() const { return -std::numeric_limits<T>::max(); }
-  inline void operator()(T& gv, const T v) const { gv = (v>gv) ? v : gv; }
-};
-template<typename T>
-struct Op_Min {
-  inline const T init() const {return  std::numeric_limits<T>::max(); }
-  inline void operator()(T& gv, const T v) const { gv = (v<gv) ? v : gv; }
-};
-
 /********************************
  * Gather Operation
  ********************************/
@@ -78,35 +57,71 @@ void ogsOperator_t::Gather(U<T> gv,
     colIds = colIdsT.ptr();
   }
 
-  const T*__restrict__ v_ptr  = v.ptr();
-  T*__restrict__ gv_ptr = gv.ptr();
+  //gv may alias v (the exchanges gather their recv buffers in place)
+  const T* v_ptr  = v.ptr();
+  T* gv_ptr = gv.ptr();
 
   const Op<T> op;
 
   if (K==1) {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong start = rowStarts[n];
-      const dlong end   = rowStarts[n+1];
-
-      T val = op.init();
-      for(dlong g=start;g<end;++g){
-        op(val, v_ptr[colIds[g]]);
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
+
+        if (end-start==1) { //unit degree rows are straight copies
+          gv_ptr[n] = v_ptr[colIds[start]];
+          continue;
+        }
+
+        T val = op.init();
+        for(dlong g=start;g<end;++g){
+          op(val, v_ptr[colIds[g]]);
+        }
+        gv_ptr[n] = val;
       }
-      gv_ptr[n] = val;
     }
   } else {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong start = rowStarts[n];
-      const dlong end   = rowStarts[n+1];
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
+
+        if (end-start==1) { //unit degree rows are straight copies
+          const T* v_row = v_ptr + colIds[start]*K;
+          #pragma omp simd
+          for (int k=0;k<K;++k) {
+            gv_ptr[k+n*K] = v_row[k];
+          }
+          continue;
+        }
 
-      for (int k=0;k<K;++k) {
-        T val = op.init();
-        for(dlong g=start;g<end;++g){
-          op(val, v_ptr[k+colIds[g]*K]);
+        //gather in short SIMD-width chunks of k
+        for (int k0=0;k0<K;k0+=simdWidth) {
+          const int Nk = std::min(simdWidth, K-k0);
+
+          T val[simdWidth];
+          for (int k=0;k<simdWidth;++k) val[k] = op.init();
+
+          for(dlong g=start;g<end;++g){
+            const T* v_row = v_ptr + k0 + colIds[g]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              op(val[k], v_row[k]);
+            }
+          }
+          for (int k=0;k<Nk;++k) {
+            gv_ptr[k0+k+n*K] = val[k];
+          }
         }
-        gv_ptr[k+n*K] = val;
       }
     }
   }
@@ -241,24 +256,37 @@ void ogsOperator_t::Scatter(U<T> v, const V<T> gv,
   const T*__restrict__ gv_ptr = gv.ptr();
 
   if (K==1) {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong start = rowStarts[n];
-      const dlong end   = rowStarts[n+1];
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
 
-      for(dlong g=start;g<end;++g){
-        v_ptr[colIds[g]] = gv_ptr[n];
+        for(dlong g=start;g<end;++g){
+          v_ptr[colIds[g]] = gv_ptr[n];
+        }
       }
     }
   } else {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong start = rowStarts[n];
-      const dlong end   = rowStarts[n+1];
-
-      for(dlong g=start;g<end;++g){
-        for (int k=0;k<K;++k) {
-          v_ptr[k+colIds[g]*K] = gv_ptr[k+n*K];
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong start = rowStarts[n];
+        const dlong end   = rowStarts[n+1];
+
+        const T* gv_row = gv_ptr + n*K;
+        for(dlong g=start;g<end;++g){
+          T* v_row = v_ptr + colIds[g]*K;
+          #pragma omp simd
+          for (int k=0;k<K;++k) {
+            v_row[k] = gv_row[k];
+          }
         }
       }
     }
@@ -371,36 +399,81 @@ void ogsOperator_t::GatherScatter(U<T> v, const int K,
   const Op<T> op;
 
   if (K==1) {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong gstart = gRowStarts[n];
-      const dlong gend   = gRowStarts[n+1];
-      const dlong sstart = sRowStarts[n];
-      const dlong send   = sRowStarts[n+1];
-
-      T val = op.init();
-      for(dlong g=gstart;g<gend;++g){
-        op(val, v_ptr[gColIds[g]]);
-      }
-      for(dlong s=sstart;s<send;++s){
-        v_ptr[sColIds[s]] = val;
-      }
-    }
-  } else {
-    #pragma omp parallel for
-    for(dlong n=0;n<Nrows;++n){
-      const dlong gstart = gRowStarts[n];
-      const dlong gend   = gRowStarts[n+1];
-      const dlong sstart = sRowStarts[n];
-      const dlong send   = sRowStarts[n+1];
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong gstart = gRowStarts[n];
+        const dlong gend   = gRowStarts[n+1];
+        const dlong sstart = sRowStarts[n];
+        const dlong send   = sRowStarts[n+1];
+
+        if (gend-gstart==1) { //unit degree rows are straight copies
+          const dlong gid = gColIds[gstart];
+          for(dlong s=sstart;s<send;++s){
+            if (sColIds[s]!=gid) v_ptr[sColIds[s]] = v_ptr[gid];
+          }
+          continue;
+        }
 
-      for (int k=0;k<K;++k) {
         T val = op.init();
         for(dlong g=gstart;g<gend;++g){
-          op(val, v_ptr[k+gColIds[g]*K]);
+          op(val, v_ptr[gColIds[g]]);
         }
         for(dlong s=sstart;s<send;++s){
-          v_ptr[k+sColIds[s]*K] = val;
+          v_ptr[sColIds[s]] = val;
+        }
+      }
+    }
+  } else {
+    #pragma omp parallel for schedule(static)
+    for(dlong b=0;b<NrowBlocksHost;++b){
+      const dlong rowStart = blockRowStartsHost[b];
+      const dlong rowEnd   = std::min(blockRowStartsHost[b+1], Nrows);
+
+      for(dlong n=rowStart;n<rowEnd;++n){
+        const dlong gstart = gRowStarts[n];
+        const dlong gend   = gRowStarts[n+1];
+        const dlong sstart = sRowStarts[n];
+        const dlong send   = sRowStarts[n+1];
+
+        if (gend-gstart==1) { //unit degree rows are straight copies
+          const dlong gid = gColIds[gstart];
+          for(dlong s=sstart;s<send;++s){
+            if (sColIds[s]==gid) continue;
+            const T* g_row = v_ptr + gid*K;
+            T* v_row = v_ptr + sColIds[s]*K;
+            #pragma omp simd
+            for (int k=0;k<K;++k) {
+              v_row[k] = g_row[k];
+            }
+          }
+          continue;
+        }
+
+        //gather-scatter in short SIMD-width chunks of k
+        for (int k0=0;k0<K;k0+=simdWidth) {
+          const int Nk = std::min(simdWidth, K-k0);
+
+          T val[simdWidth];
+          for (int k=0;k<simdWidth;++k) val[k] = op.init();
+
+          for(dlong g=gstart;g<gend;++g){
+            const T* v_row = v_ptr + k0 + gColIds[g]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              op(val[k], v_row[k]);
+            }
+          }
+          for(dlong s=sstart;s<send;++s){
+            T* v_row = v_ptr + k0 + sColIds[s]*K;
+            #pragma omp simd
+            for (int k=0;k<Nk;++k) {
+              v_row[k] = val[k];
+            }
+          }
         }
       }
     }
@@ -557,6 +630,80 @@ void ogsOperator_t::setupRowBlocks() {
 
   o_blockRowStartsN = platform.malloc(blockRowStartsN);
   o_blockRowStartsT = platform.malloc(blockRowStartsT);
+
+  setupHostRowBlocks();
+}
+
+// Partition rows into host blocks of roughly hostGatherNodesPerBlock
+// nonzeros. Rows bigger than a whole block just get a block of their own.
+void setupHostRowBlocks(const dlong Nrows,
+                        const memory<dlong> rowStarts,
+                        dlong &NrowBlocks,
+                        memory<dlong> &blockRowStarts) {
+
+  constexpr dlong hostGatherNodesPerBlock = ogsOperator_t::hostGatherNodesPerBlock;
+
+  dlong blockSum=0;
+  NrowBlocks=0;
+  if (Nrows) NrowBlocks++;
+
+  for (dlong i=0;i<Nrows;i++) {
+    const dlong rowSize = rowStarts[i+1]-rowStarts[i];
+    if (blockSum+rowSize > hostGatherNodesPerBlock && blockSum>0) {
+      NrowBlocks++; //count the previous block
+      blockSum=rowSize; //start a new row block
+    } else {
+      blockSum+=rowSize; //add this row to the block
+    }
+  }
+
+  blockRowStarts.calloc(NrowBlocks+1);
+
+  blockSum=0;
+  NrowBlocks=0;
+  if (Nrows) NrowBlocks++;
+
+  for (dlong i=0;i<Nrows;i++) {
+    const dlong rowSize = rowStarts[i+1]-rowStarts[i];
+    if (blockSum+rowSize > hostGatherNodesPerBlock && blockSum>0) {
+      blockRowStarts[NrowBlocks++] = i; //mark the previous block
+      blockSum=rowSize; //start a new row block
+    } else {
+      blockSum+=rowSize; //add this row to the block
+    }
+  }
+  blockRowStarts[NrowBlocks] = Nrows;
+}
+
+void ogsOperator_t::setupHostRowBlocks() {
+
+  //block the rows on the T sizes, which also bounds the N rows
+  ogs::setupHostRowBlocks(NrowsT, rowStartsT, NrowBlocksHost, blockRowStartsHost);
+
+  //Re-home the column ids so that the pages of each row block are
+  // first-touched by the thread which will process that block
+  const bool sharedIds = (colIdsN.ptr()==colIdsT.ptr());
+
+  memory<dlong> newColIdsN(sharedIds ? 0 : nnzN);
+  memory<dlong> newColIdsT(nnzT);
+
+  #pragma omp parallel for schedule(static)
+  for(dlong b=0;b<NrowBlocksHost;++b){
+    const dlong rowStart = blockRowStartsHost[b];
+    const dlong rowEnd   = blockRowStartsHost[b+1];
+
+    if (!sharedIds) {
+      for (dlong g=rowStartsN[rowStart];g<rowStartsN[rowEnd];++g) {
+        newColIdsN[g] = colIdsN[g];
+      }
+    }
+    for (dlong g=rowStartsT[rowStart];g<rowStartsT[rowEnd];++g) {
+      newColIdsT[g] = colIdsT[g];
+    }
+  }
+
+  colIdsT = newColIdsT;
+  colIdsN = sharedIds ? newColIdsT : newColIdsN;
 }
 
 void ogsOperator_t::Free() {
@@ -582,6 +729,9 @@ void ogsOperator_t::Free() {
   Ncols=0;
   NrowBlocksN=0;
   NrowBlocksT=0;
+
+  blockRowStartsHost.free();
+  NrowBlocksHost=0;
 }
 
 
@@ -80,6 +80,8 @@ inline void ogsPairwise_t::Start(pinnedMemory<T> &buf, const int k,
               rank,
               requests[NranksRecv+r]);
   }
+
+  ProgressStart(NranksRecv+NranksSend, requests);
 }
 
 template<typename T>
@@ -90,6 +92,7 @@ inline void ogsPairwise_t::Finish(pinnedMemory<T> &buf, const int k,
   const int NranksRecv  = (trans==NoTrans) ? NranksRecvN  : NranksRecvT;
   const int *recvOffsets= (trans==NoTrans) ? recvOffsetsN.ptr() : recvOffsetsT.ptr();
 
+  ProgressStop();
   comm.Waitall(NranksRecv+NranksSend, requests);
 
   //if we recvieved anything via MPI, gather the recv buffer and scatter
@@ -0,0 +1,260 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+/**********************************
+* Persistent requests
+***********************************/
+// Persistent requests are bound to the buffer addresses, message
+// sizes, and exchange direction. Look up a set of requests matching
+// the current exchange, initializing a new set the first time a
+// (word size, direction, buffer) combination is seen.
+template<template<typename> class mem>
+ogsPersistent_t::persistentRequests_t&
+ogsPersistent_t::GetRequests(mem<char> buf,
+                             mem<char> sendBuf,
+                             const size_t Nbytes,
+                             const Transpose trans) {
+
+  constexpr bool device = std::is_same<mem<char>, deviceMemory<char>>::value;
+
+  size_t n=0;
+  for (;n<persistent.size();n++) {
+    if (persistent[n].trans==trans
+        && persistent[n].Nbytes==Nbytes
+        && persistent[n].device==device) break;
+  }
+
+  if (n<persistent.size()) {
+    persistentRequests_t &p = persistent[n];
+    active = n;
+    if (p.recvBuf==buf.ptr() && p.sendBuf==sendBuf.ptr()) {
+      return p;
+    } else {
+      //buffers have been reallocated since these requests were made
+      FreeRequests(p);
+    }
+  } else {
+    persistent.push_back(persistentRequests_t());
+    active = n;
+  }
+
+  persistentRequests_t &p = persistent[n];
+  p.trans   = trans;
+  p.Nbytes  = Nbytes;
+  p.device  = device;
+  p.recvBuf = buf.ptr();
+  p.sendBuf = sendBuf.ptr();
+
+  const int NranksSend  = (trans==NoTrans) ? NranksSendN  : NranksSendT;
+  const int NranksRecv  = (trans==NoTrans) ? NranksRecvN  : NranksRecvT;
+  const int *sendRanks  = (trans==NoTrans) ? sendRanksN.ptr()   : sendRanksT.ptr();
+  const int *recvRanks  = (trans==NoTrans) ? recvRanksN.ptr()   : recvRanksT.ptr();
+  const int *sendCounts = (trans==NoTrans) ? sendCountsN.ptr()  : sendCountsT.ptr();
+  const int *recvCounts = (trans==NoTrans) ? recvCountsN.ptr()  : recvCountsT.ptr();
+  const int *sendOffsets= (trans==NoTrans) ? sendOffsetsN.ptr() : sendOffsetsT.ptr();
+  const int *recvOffsets= (trans==NoTrans) ? recvOffsetsN.ptr() : recvOffsetsT.ptr();
+
+  p.requests.malloc(NranksRecv+NranksSend);
+
+  //persistent recvs
+  for (int r=0;r<NranksRecv;r++) {
+    comm.RecvInit(buf + (Nhalo + recvOffsets[r])*Nbytes,
+                  recvRanks[r],
+                  recvCounts[r]*Nbytes,
+                  recvRanks[r],
+                  p.requests[r]);
+  }
+
+  //persistent sends
+  for (int r=0;r<NranksSend;r++) {
+    comm.SendInit(sendBuf + sendOffsets[r]*Nbytes,
+                  sendRanks[r],
+                  sendCounts[r]*Nbytes,
+                  rank,
+                  p.requests[NranksRecv+r]);
+  }
+
+  return p;
+}
+
+void ogsPersistent_t::FreeRequests(persistentRequests_t &p) {
+  for (size_t r=0;r<p.requests.length();r++) {
+    comm.RequestFree(p.requests[r]);
+  }
+  p.requests.free();
+  p.recvBuf = nullptr;
+  p.sendBuf = nullptr;
+}
+
+/**********************************
+* Host exchange
+***********************************/
+template<typename T>
+inline void ogsPersistent_t::Start(pinnedMemory<T> &buf, const int k,
+                                   const Op op, const Transpose trans){
+
+  pinnedMemory<T> sendBuf = h_sendspace;
+
+  persistentRequests_t &p = GetRequests<pinnedMemory>(buf, sendBuf,
+                                                      k*sizeof(T), trans);
+
+  const int NranksSend  = (trans==NoTrans) ? NranksSendN  : NranksSendT;
+  const int NranksRecv  = (trans==NoTrans) ? NranksRecvN  : NranksRecvT;
+
+  //start recvs
+  comm.Startall(NranksRecv, p.requests);
+
+  // extract the send buffer
+  if (trans == NoTrans)
+    extract(NsendN, k, sendIdsN, buf, sendBuf);
+  else
+    extract(NsendT, k, sendIdsT, buf, sendBuf);
+
+  //start sends
+  memory<Comm::request_t> sendRequests = p.requests + NranksRecv;
+  comm.Startall(NranksSend, sendRequests);
+
+  ProgressStart(NranksRecv+NranksSend, p.requests);
+}
+
+template<typename T>
+inline void ogsPersistent_t::Finish(pinnedMemory<T> &buf, const int k,
+                                    const Op op, const Transpose trans){
+
+  const int NranksSend  = (trans==NoTrans) ? NranksSendN  : NranksSendT;
+  const int NranksRecv  = (trans==NoTrans) ? NranksRecvN  : NranksRecvT;
+  const int *recvOffsets= (trans==NoTrans) ? recvOffsetsN.ptr() : recvOffsetsT.ptr();
+
+  ProgressStop();
+  comm.Waitall(NranksRecv+NranksSend, persistent[active].requests);
+
+  //if we recvieved anything via MPI, gather the recv buffer and scatter
+  // it back to to original vector
+  dlong Nrecv = recvOffsets[NranksRecv];
+  if (Nrecv) {
+    // gather the recieved nodes
+    postmpi.Gather(buf, buf, k, op, trans);
+  }
+}
+
+void ogsPersistent_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsPersistent_t::Start(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsPersistent_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsPersistent_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+/**********************************
+* GPU-aware exchange
+***********************************/
+template<typename T>
+void ogsPersistent_t::Start(deviceMemory<T> &o_buf,
+                            const int k,
+                            const Op op,
+                            const Transpose trans){
+
+  const dlong Nsend = (trans == NoTrans) ? NsendN : NsendT;
+
+  if (Nsend) {
+    deviceMemory<T> o_sendBuf = o_sendspace;
+
+    //  assemble the send buffer on device
+    if (trans == NoTrans) {
+      extractKernel[ogsType<T>::get()](NsendN, k, o_sendIdsN, o_buf, o_sendBuf);
+    } else {
+      extractKernel[ogsType<T>::get()](NsendT, k, o_sendIdsT, o_buf, o_sendBuf);
+    }
+    //wait for kernel to finish on default stream
+    device_t &device = platform.device;
+    device.finish();
+  }
+}
+
+template<typename T>
+void ogsPersistent_t::Finish(deviceMemory<T> &o_buf,
+                             const int k,
+                             const Op op,
+                             const Transpose trans){
+
+  deviceMemory<T> o_sendBuf = o_sendspace;
+
+  persistentRequests_t &p = GetRequests<deviceMemory>(o_buf, o_sendBuf,
+                                                      k*sizeof(T), trans);
+
+  const int NranksSend  = (trans==NoTrans) ? NranksSendN  : NranksSendT;
+  const int NranksRecv  = (trans==NoTrans) ? NranksRecvN  : NranksRecvT;
+  const int *recvOffsets= (trans==NoTrans) ? recvOffsetsN.ptr() : recvOffsetsT.ptr();
+
+  //start recvs and sends together
+  comm.Startall(NranksRecv+NranksSend, p.requests);
+
+  comm.Waitall(NranksRecv+NranksSend, p.requests);
+
+  //if we recvieved anything via MPI, gather the recv buffer and scatter
+  // it back to to original vector
+  dlong Nrecv = recvOffsets[NranksRecv];
+  if (Nrecv) {
+    // gather the recieved nodes on device
+    postmpi.Gather(o_buf, o_buf, k, op, trans);
+  }
+}
+
+void ogsPersistent_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Start<float>(buf, k, op, trans); }
+void ogsPersistent_t::Start(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Start<double>(buf, k, op, trans); }
+void ogsPersistent_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Start<int>(buf, k, op, trans); }
+void ogsPersistent_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Start<long long int>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { Finish<float>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { Finish<double>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { Finish<int>(buf, k, op, trans); }
+void ogsPersistent_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { Finish<long long int>(buf, k, op, trans); }
+
+// The communication pattern is the same as the pairwise exchange,
+// only the requests are initialized once and restarted each exchange.
+ogsPersistent_t::ogsPersistent_t(dlong Nshared,
+                                 memory<parallelNode_t> &sharedNodes,
+                                 ogsOperator_t& gatherHalo,
+                                 stream_t _dataStream,
+                                 comm_t _comm,
+                                 platform_t &_platform):
+  ogsPairwise_t(Nshared, sharedNodes, gatherHalo,
+                _dataStream, _comm, _platform) {}
+
+ogsPersistent_t::~ogsPersistent_t() {
+  for (auto &p: persistent) FreeRequests(p);
+}
+
+} //namespace ogs
+
+} //namespace libp
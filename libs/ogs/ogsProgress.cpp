@@ -0,0 +1,167 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+#include "ogs.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+/**********************************
+* Communication progress
+***********************************/
+// Most MPI implementations only move messages along while inside an MPI
+// call, so requests posted in Start can sit idle while local kernels run.
+// A single progress thread, shared by every exchange which enables it,
+// polls them between Start and Finish. Without it, users can call
+// Progress() between their own kernels instead.
+
+std::vector<ogsExchange_t*> ogsExchange_t::progressExchanges;
+std::thread ogsExchange_t::progressThread;
+std::mutex ogsExchange_t::progressMutex;
+std::condition_variable ogsExchange_t::progressCond;
+bool ogsExchange_t::progressExit=false;
+int ogsExchange_t::NprogressPolling=0;
+
+ogsExchange_t::~ogsExchange_t() {
+  SetProgressThread(false);
+}
+
+void ogsExchange_t::SetProgressThread(const bool enable) {
+  if (enable == progressEnabled) return;
+
+  if (enable && !Comm::ThreadMultiple()) {
+    //once, rather than for every handle
+    static bool warned = false;
+    if (!warned) {
+      LIBP_FORCE_WARNING("MPI does not provide MPI_THREAD_MULTIPLE, ogs progress thread disabled "
+                         "(set LIBP_COMM_PROGRESS_THREAD=TRUE in the environment)");
+      warned = true;
+    }
+    return;
+  }
+
+  std::thread finished;
+  {
+    std::lock_guard<std::mutex> lock(progressMutex);
+    if (enable) {
+      progressExchanges.push_back(this);
+      progressEnabled = true;
+
+      //the first exchange starts the thread
+      if (!progressThread.joinable()) {
+        progressExit = false;
+        progressThread = std::thread(&ogsExchange_t::ProgressLoop);
+      }
+    } else {
+      if (progressPolling) NprogressPolling--;
+      progressPolling = false;
+      NprogressRequests = 0;
+      progressEnabled = false;
+      progressExchanges.erase(std::find(progressExchanges.begin(),
+                                        progressExchanges.end(), this));
+
+      //and the last one stops it
+      if (progressExchanges.empty()) {
+        progressExit = true;
+        finished = std::move(progressThread);
+      }
+    }
+  }
+  if (finished.joinable()) {
+    progressCond.notify_one();
+    finished.join();
+  }
+}
+
+void ogsExchange_t::Progress() {
+  //the progress thread owns the requests while it runs
+  if (NprogressRequests && !progressEnabled) {
+    if (comm.Testall(NprogressRequests, progressRequests))
+      NprogressRequests = 0;
+  }
+}
+
+void ogsExchange_t::ProgressStart(const int count, memory<Comm::request_t> &requests) {
+  if (!progressEnabled) {
+    NprogressRequests = count;
+    progressRequests = requests;
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(progressMutex);
+    NprogressRequests = count;
+    progressRequests = requests;
+    if (count && !progressPolling) {
+      progressPolling = true;
+      NprogressPolling++;
+    }
+  }
+  progressCond.notify_one();
+}
+
+void ogsExchange_t::ProgressStop() {
+  if (!progressEnabled) {
+    NprogressRequests = 0;
+    return;
+  }
+
+  //the thread polls under the lock, so once we hold it the thread is
+  // not in MPI_Testall on the requests the caller is about to wait on
+  std::lock_guard<std::mutex> lock(progressMutex);
+  if (progressPolling) NprogressPolling--;
+  progressPolling = false;
+  NprogressRequests = 0;
+}
+
+void ogsExchange_t::ProgressLoop() {
+  std::unique_lock<std::mutex> lock(progressMutex);
+
+  while (true) {
+    progressCond.wait(lock, []() { return progressExit || NprogressPolling>0; });
+    if (progressExit) break;
+
+    //one pass over every exchange with requests in flight
+    for (ogsExchange_t* exchange : progressExchanges) {
+      if (!exchange->progressPolling) continue;
+      if (exchange->comm.Testall(exchange->NprogressRequests,
+                                 exchange->progressRequests)) {
+        exchange->progressPolling = false;
+        NprogressPolling--;
+      }
+    }
+
+    //let the other threads start and stop their exchanges
+    lock.unlock();
+    std::this_thread::yield();
+    lock.lock();
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -0,0 +1,210 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+kernel_t ogsReducedPrecision_t::packKernel;
+kernel_t ogsReducedPrecision_t::unpackKernel;
+
+/**********************************
+* Host exchange
+***********************************/
+void ogsReducedPrecision_t::Start(pinnedMemory<double> &buf,
+                                  const int k,
+                                  const Op op,
+                                  const Transpose trans){
+
+  const dlong N = ((trans == NoTrans) ? NhaloP : Nhalo)*k;
+
+  pinnedMemory<double> own = h_ownspace;
+  pinnedMemory<float> fbuf = buf;
+
+  //keep the local contributions and narrow the payload
+  const double *buf_ptr = buf.ptr();
+  double *own_ptr = own.ptr();
+  for (dlong n=0;n<N;++n) own_ptr[n] = buf_ptr[n];
+
+  float *fbuf_ptr = fbuf.ptr();
+  for (dlong n=0;n<N;++n) fbuf_ptr[n] = static_cast<float>(own_ptr[n]);
+
+  base->Start(fbuf, k, op, trans);
+  buf = fbuf;
+  SyncBuffers();
+}
+
+void ogsReducedPrecision_t::Finish(pinnedMemory<double> &buf,
+                                   const int k,
+                                   const Op op,
+                                   const Transpose trans){
+
+  pinnedMemory<float> fbuf = buf;
+  base->Finish(fbuf, k, op, trans);
+  buf = fbuf;
+  SyncBuffers();
+
+  const dlong N = ((trans == Trans) ? NhaloP : Nhalo)*k;
+
+  //entries this rank contributed to
+  const dlong Ncomp = (!compensate || op==Mul) ? 0 :
+                      ((trans == Sym) ? Nhalo : NhaloP)*k;
+
+  pinnedMemory<double> own = h_ownspace;
+  pinnedMemory<float> recv = h_recvspace;
+
+  const float *fbuf_ptr = fbuf.ptr();
+  float *recv_ptr = recv.ptr();
+  for (dlong n=0;n<N;++n) recv_ptr[n] = fbuf_ptr[n];
+
+  const double *own_ptr = own.ptr();
+  double *buf_ptr = buf.ptr();
+  for (dlong n=0;n<N;++n) {
+    const float r = recv_ptr[n];
+    double val = r;
+    if (n<Ncomp) {
+      const float ownf = static_cast<float>(own_ptr[n]);
+      if (op==Add) {
+        val = (static_cast<double>(r) - static_cast<double>(ownf)) + own_ptr[n];
+      } else if (r==ownf) { //Max, Min
+        val = own_ptr[n];
+      }
+    }
+    buf_ptr[n] = val;
+  }
+}
+
+void ogsReducedPrecision_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+
+/**********************************
+* GPU-aware exchange
+***********************************/
+void ogsReducedPrecision_t::Start(deviceMemory<double> &o_buf,
+                                  const int k,
+                                  const Op op,
+                                  const Transpose trans){
+
+  const dlong N = ((trans == NoTrans) ? NhaloP : Nhalo)*k;
+
+  deviceMemory<double> o_own = o_ownspace;
+  deviceMemory<float> o_fbuf = o_buf;
+
+  //keep the local contributions and narrow the payload
+  if (N) {
+    o_own.copyFrom(o_buf, N);
+    packKernel(N, o_own, o_fbuf);
+  }
+
+  base->Start(o_fbuf, k, op, trans);
+  o_buf = o_fbuf;
+  SyncBuffers();
+}
+
+void ogsReducedPrecision_t::Finish(deviceMemory<double> &o_buf,
+                                   const int k,
+                                   const Op op,
+                                   const Transpose trans){
+
+  deviceMemory<float> o_fbuf = o_buf;
+  base->Finish(o_fbuf, k, op, trans);
+  o_buf = o_fbuf;
+  SyncBuffers();
+
+  const dlong N = ((trans == Trans) ? NhaloP : Nhalo)*k;
+
+  //entries this rank contributed to
+  const dlong Ncomp = (!compensate || op==Mul) ? 0 :
+                      ((trans == Sym) ? Nhalo : NhaloP)*k;
+
+  deviceMemory<double> o_own = o_ownspace;
+  deviceMemory<float> o_recv = o_recvspace;
+
+  if (N) {
+    o_recv.copyFrom(o_fbuf, N);
+    unpackKernel(N, Ncomp, static_cast<int>(op), o_recv, o_own, o_buf);
+  }
+}
+
+void ogsReducedPrecision_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { base->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsReducedPrecision_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { base->Finish(buf, k, op, trans); SyncBuffers(); }
+
+ogsReducedPrecision_t::ogsReducedPrecision_t(std::shared_ptr<ogsExchange_t> _base,
+                                             const bool _compensate):
+  ogsExchange_t(_base->platform, _base->comm, _base->dataStream),
+  base(_base),
+  compensate(_compensate) {
+
+  Nhalo  = base->Nhalo;
+  NhaloP = base->NhaloP;
+  gpu_aware = base->gpu_aware;
+
+  SyncBuffers();
+
+  if (!packKernel.isInitialized()) {
+    InitializeKernels(platform, Double, Add);
+  }
+}
+
+//the wrapped exchange owns the workspaces, and may swap them while exchanging
+void ogsReducedPrecision_t::SyncBuffers() {
+  h_workspace = base->h_workspace;
+  o_workspace = base->o_workspace;
+  h_sendspace = base->h_sendspace;
+  o_sendspace = base->o_sendspace;
+}
+
+void ogsReducedPrecision_t::SetProgressThread(const bool enable) { base->SetProgressThread(enable); }
+bool ogsReducedPrecision_t::ProgressThreadActive() const { return base->ProgressThreadActive(); }
+void ogsReducedPrecision_t::Progress() { base->Progress(); }
+
+void ogsReducedPrecision_t::AllocBuffer(size_t Nbytes) {
+  base->AllocBuffer(Nbytes);
+  SyncBuffers();
+
+  if (o_ownspace.size() < Nhalo*Nbytes) {
+    h_ownspace = platform.hostMalloc<char>(Nhalo*Nbytes);
+    o_ownspace = platform.malloc<char>(Nhalo*Nbytes);
+    h_recvspace = platform.hostMalloc<char>(Nhalo*Nbytes);
+    o_recvspace = platform.malloc<char>(Nhalo*Nbytes);
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -28,6 +28,7 @@ SOFTWARE.
 #include "ogs/ogsUtils.hpp"
 #include "ogs/ogsOperator.hpp"
 #include "ogs/ogsExchange.hpp"
+#include "ogs/ogsStats.hpp"
 #include "timer.hpp"
 
 #ifdef GLIBCXX_PARALLEL
@@ -50,6 +51,9 @@ void ogs_t::Setup(const dlong _N,
                   const bool verbose,
                   platform_t& _platform){
   ogsBase_t::Setup(_N, ids, _comm, _kind, method, _unique, verbose, _platform);
+
+  //fuse the local and halo operators for the post-exchange pass
+  gatherFused = std::make_shared<ogsFusedOperator_t>(platform, *gatherLocal, *gatherHalo);
 }
 
 void halo_t::Setup(const dlong _N,
@@ -75,6 +79,8 @@ void ogsBase_t::Setup(const dlong _N,
                       const bool verbose,
                       platform_t& _platform){
 
+  LIBP_PROFILE("ogs setup");
+
   //release resources if this ogs was setup before
   Free();
 
@@ -104,42 +110,67 @@ void ogsBase_t::Setup(const dlong _N,
   for (dlong n=0;n<N;n++)
     if (ids[n]!=0) Nids++;
 
-  // make list of nodes
-  memory<parallelNode_t> nodes(Nids);
-
-  //fill the data (squeezing out zero ids)
-  Nids=0;
-  for (dlong n=0;n<N;n++) {
-    if (ids[n]!=0) {
-      nodes[Nids].localId = Nids; //record a compressed id first (useful for ordering)
-      nodes[Nids].baseId = (kind==Unsigned) ?
-                            abs(ids[n]) : ids[n]; //record global id
-      nodes[Nids].rank = rank;
-      nodes[Nids].destRank = abs(ids[n]) % size;
-      Nids++;
-    }
-  }
-
-  //flag which nodes are shared via MPI
-  FindSharedNodes(Nids, nodes, verbose);
+  //look for a setup plan from a previous run with the same ids
+  const bool useCache = platform.settings().compareSetting("OGS SETUP CACHE", "TRUE");
 
-  //Index the local and halo baseIds on this rank and
-  // construct sharedNodes which contains all the info
-  // we need to setup the MPI exchange.
+  std::string cacheFile;
+  memory<parallelNode_t> nodes;
   dlong Nshared=0;
   memory<parallelNode_t> sharedNodes;
-  ConstructSharedNodes(Nids, nodes, Nshared, sharedNodes);
+  Method exchangeMethod = method;
+  double cachedSetupTime=0.0;
+  bool cached = false;
+
+  if (useCache) {
+    cacheFile = SetupCacheFile(Nids, ids, method);
+    cached = LoadSetupCache(cacheFile, Nids, nodes,
+                            Nshared, sharedNodes,
+                            exchangeMethod, cachedSetupTime);
+  }
+
+  if (cached) {
+    //if the signs of ids were altered, write them back
+    if (unique) {
+      for (dlong n=0;n<Nids;n++) {
+        ids[nodes[n].localId] = nodes[n].baseId;
+      }
+    }
+  } else {
+    // make list of nodes
+    nodes.malloc(Nids);
+
+    //fill the data (squeezing out zero ids)
+    Nids=0;
+    for (dlong n=0;n<N;n++) {
+      if (ids[n]!=0) {
+        nodes[Nids].localId = Nids; //record a compressed id first (useful for ordering)
+        nodes[Nids].baseId = (kind==Unsigned) ?
+                              abs(ids[n]) : ids[n]; //record global id
+        nodes[Nids].rank = rank;
+        nodes[Nids].destRank = abs(ids[n]) % size;
+        Nids++;
+      }
+    }
+
+    //flag which nodes are shared via MPI
+    FindSharedNodes(Nids, nodes, verbose);
 
-  Nids=0;
-  for (dlong n=0;n<N;n++) {
-    if (ids[n]!=0) {
-      nodes[Nids].localId = n; //record the real id now
+    //Index the local and halo baseIds on this rank and
+    // construct sharedNodes which contains all the info
+    // we need to setup the MPI exchange.
+    ConstructSharedNodes(Nids, nodes, Nshared, sharedNodes);
 
-      //if we altered the signs of ids, write them back
-      if (unique)
-        ids[n] = nodes[Nids].baseId;
+    Nids=0;
+    for (dlong n=0;n<N;n++) {
+      if (ids[n]!=0) {
+        nodes[Nids].localId = n; //record the real id now
 
-      Nids++;
+        //if we altered the signs of ids, write them back
+        if (unique)
+          ids[n] = nodes[Nids].baseId;
+
+        Nids++;
+      }
     }
   }
 
@@ -151,25 +182,37 @@ void ogsBase_t::Setup(const dlong _N,
   else
     LocalHaloSetup(Nids, nodes);
 
-  //with that, we're done with the local nodes list
-  nodes.free();
-
   // At this point, we've setup gs operators to gather/scatter the purely local nodes,
   // and gather/scatter the shared halo nodes to/from a coalesced ordering. We now
   // need gs operators to scatter/gather the coalesced halo nodes to/from the expected
   // orderings for MPI communications.
 
-  if (method == AllToAll) {
+  if (exchangeMethod == AllToAll) {
     exchange = std::shared_ptr<ogsExchange_t>(
                   new ogsAllToAll_t(Nshared, sharedNodes,
                                     *gatherHalo, dataStream,
                                     comm, platform));
-  } else if (method == Pairwise) {
+  } else if (exchangeMethod == Pairwise) {
     exchange = std::shared_ptr<ogsExchange_t>(
                   new ogsPairwise_t(Nshared, sharedNodes,
                                     *gatherHalo, dataStream,
                                     comm, platform));
-  } else if (method == CrystalRouter) {
+  } else if (exchangeMethod == Persistent) {
+    exchange = std::shared_ptr<ogsExchange_t>(
+                  new ogsPersistent_t(Nshared, sharedNodes,
+                                      *gatherHalo, dataStream,
+                                      comm, platform));
+  } else if (exchangeMethod == Neighborhood) {
+    exchange = std::shared_ptr<ogsExchange_t>(
+                  new ogsNeighborhood_t(Nshared, sharedNodes,
+                                        *gatherHalo, dataStream,
+                                        comm, platform));
+  } else if (exchangeMethod == Hierarchical) {
+    exchange = std::shared_ptr<ogsExchange_t>(
+                  new ogsHierarchical_t(Nshared, sharedNodes,
+                                        *gatherHalo, dataStream,
+                                        comm, platform));
+  } else if (exchangeMethod == CrystalRouter) {
     exchange = std::shared_ptr<ogsExchange_t>(
                   new ogsCrystalRouter_t(Nshared, sharedNodes,
                                          *gatherHalo, dataStream,
@@ -178,14 +221,35 @@ void ogsBase_t::Setup(const dlong _N,
     exchange = std::shared_ptr<ogsExchange_t>(
                   AutoSetup(Nshared, sharedNodes,
                             *gatherHalo, comm,
-                            platform, verbose));
+                            platform, verbose,
+                            exchangeMethod));
+  }
+
+  if (platform.settings().compareSetting("COMM PROGRESS THREAD", "TRUE")) {
+    exchange->SetProgressThread(true);
+  }
+
+  if (platform.settings().compareSetting("OGS STATS", "TRUE")) {
+    stats = ogsStats_t::Create(platform, comm, kind, Nshared, sharedNodes);
   }
 
   timePoint_t end = GlobalPlatformTime(platform, comm);
   double elapsedTime = ElapsedTime(start, end);
 
+  //store the plan, along with the time it took to make, for the next run
+  if (useCache && !cached) {
+    SaveSetupCache(cacheFile, Nids, nodes,
+                   Nshared, sharedNodes,
+                   exchangeMethod, elapsedTime);
+  }
+
   if (!rank && verbose) {
-    std::cout << "ogs Setup Time: " << elapsedTime << " seconds." << std::endl;
+    if (cached) {
+      std::cout << "ogs Setup Time: " << elapsedTime << " seconds (loaded from cache, "
+                << cachedSetupTime - elapsedTime << " seconds saved)." << std::endl;
+    } else {
+      std::cout << "ogs Setup Time: " << elapsedTime << " seconds." << std::endl;
+    }
   }
 }
 
@@ -442,9 +506,6 @@ void ogsBase_t::ConstructSharedNodes(const dlong Nids,
   indexMap.free();
 
   memory<int> sendCounts(size,0);
-  memory<int> recvCounts(size);
-  memory<int> sendOffsets(size+1);
-  memory<int> recvOffsets(size+1);
 
   // sort based on destination rank
   sort(sendSharedNodes.ptr(), sendSharedNodes.ptr()+NhaloT,
@@ -457,28 +518,14 @@ void ogsBase_t::ConstructSharedNodes(const dlong Nids,
     sendCounts[sendSharedNodes[n].destRank]++;
   }
 
-  comm.Alltoall(sendCounts, recvCounts);
-
-  sendOffsets[0] = 0;
-  recvOffsets[0] = 0;
-  for (int r=0;r<size;r++) {
-    sendOffsets[r+1] = sendOffsets[r]+sendCounts[r];
-    recvOffsets[r+1] = recvOffsets[r]+recvCounts[r];
-  }
-  dlong recvN = recvOffsets[size]; //total ids to recv
-
-  memory<parallelNode_t> recvSharedNodes(recvN);
-
   //Send all the nodes to their destination rank.
-  comm.Alltoallv(sendSharedNodes, sendCounts, sendOffsets,
-                 recvSharedNodes, recvCounts, recvOffsets);
+  memory<parallelNode_t> recvSharedNodes;
+  comm.Alltoallv(sendSharedNodes, sendCounts, recvSharedNodes);
+  dlong recvN = recvSharedNodes.length(); //total ids recv'd
 
   //free up some space
   sendSharedNodes.free();
   sendCounts.free();
-  recvCounts.free();
-  sendOffsets.free();
-  recvOffsets.free();
 
   // sort based on base ids
   sort(recvSharedNodes.ptr(), recvSharedNodes.ptr()+recvN,
@@ -614,8 +661,8 @@ void ogsBase_t::LocalSignedSetup(const dlong Nids, memory<parallelNode_t> &nodes
   }
   gatherLocal->nnzN = gatherLocal->rowStartsN[gatherLocal->NrowsT];
   gatherLocal->nnzT = gatherLocal->rowStartsT[gatherLocal->NrowsT];
-  gatherLocal->colIdsN.malloc(gatherLocal->nnzN);
-  gatherLocal->colIdsT.malloc(gatherLocal->nnzT);
+  gatherLocal->colIdsN.malloc(gatherLocal->nnzN, Memory::ParallelFirstTouch);
+  gatherLocal->colIdsT.malloc(gatherLocal->nnzT, Memory::ParallelFirstTouch);
 
   //make halo row offsets
   gatherHalo->rowStartsN.malloc(gatherHalo->NrowsT+1);
@@ -630,8 +677,8 @@ void ogsBase_t::LocalSignedSetup(const dlong Nids, memory<parallelNode_t> &nodes
   }
   gatherHalo->nnzN = gatherHalo->rowStartsN[gatherHalo->NrowsT];
   gatherHalo->nnzT = gatherHalo->rowStartsT[gatherHalo->NrowsT];
-  gatherHalo->colIdsN.malloc(gatherHalo->nnzN);
-  gatherHalo->colIdsT.malloc(gatherHalo->nnzT);
+  gatherHalo->colIdsN.malloc(gatherHalo->nnzN, Memory::ParallelFirstTouch);
+  gatherHalo->colIdsT.malloc(gatherHalo->nnzT, Memory::ParallelFirstTouch);
 
 
   for (dlong i=0;i<Nids;i++) {
@@ -724,7 +771,7 @@ void ogsBase_t::LocalUnsignedSetup(const dlong Nids, memory<parallelNode_t> &nod
   }
   gatherLocal->nnzT = gatherLocal->rowStartsT[gatherLocal->NrowsT];
   gatherLocal->nnzN = gatherLocal->nnzT;
-  gatherLocal->colIdsT.malloc(gatherLocal->nnzT);
+  gatherLocal->colIdsT.malloc(gatherLocal->nnzT, Memory::ParallelFirstTouch);
   gatherLocal->colIdsN = gatherLocal->colIdsT;
 
   //make halo row offsets
@@ -737,7 +784,7 @@ void ogsBase_t::LocalUnsignedSetup(const dlong Nids, memory<parallelNode_t> &nod
   }
   gatherHalo->nnzT = gatherHalo->rowStartsT[gatherHalo->NrowsT];
   gatherHalo->nnzN = gatherHalo->nnzT;
-  gatherHalo->colIdsT.malloc(gatherHalo->nnzT);
+  gatherHalo->colIdsT.malloc(gatherHalo->nnzT, Memory::ParallelFirstTouch);
   gatherHalo->colIdsN = gatherHalo->colIdsT;
 
 
@@ -813,8 +860,8 @@ void ogsBase_t::LocalHaloSetup(const dlong Nids, memory<parallelNode_t> &nodes){
   }
   gatherHalo->nnzN = gatherHalo->rowStartsN[gatherHalo->NrowsT];
   gatherHalo->nnzT = gatherHalo->rowStartsT[gatherHalo->NrowsT];
-  gatherHalo->colIdsN.malloc(gatherHalo->nnzN);
-  gatherHalo->colIdsT.malloc(gatherHalo->nnzT);
+  gatherHalo->colIdsN.malloc(gatherHalo->nnzN, Memory::ParallelFirstTouch);
+  gatherHalo->colIdsT.malloc(gatherHalo->nnzT, Memory::ParallelFirstTouch);
 
 
   for (dlong i=0;i<Nids;i++) {
@@ -850,7 +897,9 @@ void ogsBase_t::Free() {
   comm.Free();
   gatherLocal = nullptr;
   gatherHalo = nullptr;
+  gatherFused = nullptr;
   exchange = nullptr;
+  stats = nullptr;
   N=0;
   NlocalT=0;
   NhaloT=0;
@@ -858,6 +907,50 @@ void ogsBase_t::Free() {
   NgatherGlobal=0;
 }
 
+void ogsBase_t::SetPrecision(const Precision precision) {
+
+  LIBP_ABORT("ogs handle is not set up.",
+             exchange==nullptr);
+
+  //unwrap any existing reduced precision exchange
+  std::shared_ptr<ogsReducedPrecision_t> reduced =
+            std::dynamic_pointer_cast<ogsReducedPrecision_t>(exchange);
+  if (reduced) exchange = reduced->base;
+
+  if (precision != Full) {
+    exchange = std::make_shared<ogsReducedPrecision_t>(exchange,
+                                        precision==SingleCompensated);
+  }
+}
+
+void ogsBase_t::SetProgressThread(const bool enable) {
+
+  LIBP_ABORT("ogs handle is not set up.",
+             exchange==nullptr);
+
+  exchange->SetProgressThread(enable);
+}
+
+void ogsBase_t::Progress() {
+  if (exchange) exchange->Progress();
+}
+
+void ogsBase_t::SetAutoTuneSizes(const std::vector<int> k) {
+  autoTuneSizes = k;
+}
+
+void ogsBase_t::ResetStats() {
+  if (stats) stats->Reset();
+}
+
+void ogsBase_t::ReportStats(const std::string name) const {
+  if (stats) stats->Report(name);
+}
+
+void ReportStats(comm_t comm) {
+  ogsStats_t::ReportAll(comm);
+}
+
 void ogsBase_t::AssertGatherDefined() {
   LIBP_ABORT("Gather operation not well-defined.",
              !gather_defined);
@@ -913,6 +1006,8 @@ void halo_t::SetupFromGather(ogs_t& ogs) {
   gathered_halo=true;
 
   exchange = ogs.exchange;
+
+  if (ogs.stats) stats = ogs.stats->Clone(Halo);
 }
 
 } //namespace ogs
@@ -0,0 +1,215 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <sstream>
+
+namespace libp {
+
+namespace ogs {
+
+/********************************
+ * Setup cache
+ ********************************/
+// A finished setup is fully described by the local node list (from which
+// the local/halo gather operators are rebuilt), the shared node list
+// (from which the exchange is rebuilt), and the exchange method Auto
+// picked. These are what the global sorts, shuffles and autotuning in
+// Setup produce, so each rank stores them in
+//   <cache dir>/ogs/<key>/<rank>.bin
+// where the key hashes every rank's ids together with the comm size
+// and setup options.
+
+namespace {
+
+struct setupCacheHeader_t {
+  char magic[8];
+  int version;
+  int size, rank;
+  int kind, unique, method;
+  int nodeBytes;
+  dlong N, Nids, Nshared;
+  dlong NlocalT, NlocalP, NhaloT, NhaloP, Ngather;
+  hlong NgatherGlobal;
+  int gather_defined;
+  double setupTime;
+};
+
+constexpr char setupCacheMagic[8] = "LIBPOGS";
+
+} //namespace
+
+std::string ogsBase_t::SetupCacheFile(const dlong Nids,
+                                      memory<hlong> ids,
+                                      const Method method) {
+
+  int rank = comm.rank();
+  int size = comm.size();
+
+  //hash this rank's ids
+  uint64_t h = hashSeed;
+  h = hashBytes(&N, sizeof(dlong), h);
+  h = hashBytes(&Nids, sizeof(dlong), h);
+  h = hashBytes(ids.ptr(), N*sizeof(hlong), h);
+
+  //combine the hashes of all ranks
+  memory<long long int> hashes(size);
+  hashes[rank] = static_cast<long long int>(h);
+  comm.Allgather(hashes, 1);
+
+  const int options[6] = {LIBP_VERSION, size, static_cast<int>(kind), unique,
+                          static_cast<int>(method),
+                          static_cast<int>(sizeof(parallelNode_t))};
+  uint64_t key = hashBytes(options, sizeof(options), hashSeed);
+  key = hashBytes(hashes.ptr(), size*sizeof(long long int), key);
+
+  std::stringstream ss;
+  ss << platform.getCacheDir() << "/ogs/"
+     << std::hex << std::setw(16) << std::setfill('0') << key
+     << "/" << std::dec << rank << ".bin";
+  return ss.str();
+}
+
+bool ogsBase_t::LoadSetupCache(const std::string fileName,
+                               const dlong Nids,
+                               memory<parallelNode_t> &nodes,
+                               dlong &Nshared,
+                               memory<parallelNode_t> &sharedNodes,
+                               Method &method,
+                               double &setupTime) {
+
+  int found = 0;
+  setupCacheHeader_t header;
+
+  FILE *fp = fopen(fileName.c_str(), "rb");
+  if (fp) {
+    if (fread(&header, sizeof(setupCacheHeader_t), 1, fp) == 1
+        && !std::strncmp(header.magic, setupCacheMagic, 8)
+        && header.version == LIBP_VERSION
+        && header.size == comm.size()
+        && header.rank == comm.rank()
+        && header.kind == static_cast<int>(kind)
+        && header.unique == unique
+        && header.nodeBytes == static_cast<int>(sizeof(parallelNode_t))
+        && header.N == N
+        && header.Nids == Nids) {
+
+      nodes.malloc(header.Nids);
+      sharedNodes.malloc(header.Nshared);
+
+      found = (fread(nodes.ptr(), sizeof(parallelNode_t), header.Nids, fp)
+                  == static_cast<size_t>(header.Nids))
+           && (fread(sharedNodes.ptr(), sizeof(parallelNode_t), header.Nshared, fp)
+                  == static_cast<size_t>(header.Nshared));
+    }
+    fclose(fp);
+  }
+
+  //every rank must have its part of the plan
+  comm.Allreduce(found, Comm::Min);
+
+  if (!found) {
+    nodes.free();
+    sharedNodes.free();
+    return false;
+  }
+
+  Nshared = header.Nshared;
+  NlocalT = header.NlocalT;
+  NlocalP = header.NlocalP;
+  NhaloT = header.NhaloT;
+  NhaloP = header.NhaloP;
+  Ngather = header.Ngather;
+  NgatherGlobal = header.NgatherGlobal;
+  gather_defined = header.gather_defined;
+  method = static_cast<Method>(header.method);
+  setupTime = header.setupTime;
+  return true;
+}
+
+void ogsBase_t::SaveSetupCache(const std::string fileName,
+                               const dlong Nids,
+                               memory<parallelNode_t> &nodes,
+                               const dlong Nshared,
+                               memory<parallelNode_t> &sharedNodes,
+                               const Method method,
+                               const double setupTime) {
+
+  setupCacheHeader_t header;
+  std::memset(&header, 0, sizeof(setupCacheHeader_t));
+  std::memcpy(header.magic, setupCacheMagic, 8);
+  header.version = LIBP_VERSION;
+  header.size = comm.size();
+  header.rank = comm.rank();
+  header.kind = static_cast<int>(kind);
+  header.unique = unique;
+  header.method = static_cast<int>(method);
+  header.nodeBytes = static_cast<int>(sizeof(parallelNode_t));
+  header.N = N;
+  header.Nids = Nids;
+  header.Nshared = Nshared;
+  header.NlocalT = NlocalT;
+  header.NlocalP = NlocalP;
+  header.NhaloT = NhaloT;
+  header.NhaloP = NhaloP;
+  header.Ngather = Ngather;
+  header.NgatherGlobal = NgatherGlobal;
+  header.gather_defined = gather_defined;
+  header.setupTime = setupTime;
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(fileName).parent_path(), ec);
+
+  //write to a temporary file and move it into place, so a concurrent
+  // run never reads a partial plan
+  const std::string tmpName = fileName + ".tmp";
+  FILE *fp = fopen(tmpName.c_str(), "wb");
+  LIBP_WARNING("Unable to write ogs setup cache file " << tmpName,
+               fp == nullptr);
+  if (!fp) return;
+
+  bool ok = (fwrite(&header, sizeof(setupCacheHeader_t), 1, fp) == 1)
+         && (fwrite(nodes.ptr(), sizeof(parallelNode_t), Nids, fp)
+                == static_cast<size_t>(Nids))
+         && (fwrite(sharedNodes.ptr(), sizeof(parallelNode_t), Nshared, fp)
+                == static_cast<size_t>(Nshared));
+  ok = (fclose(fp) == 0) && ok;
+
+  if (ok) {
+    std::filesystem::rename(tmpName, fileName, ec);
+  } else {
+    std::filesystem::remove(tmpName, ec);
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -0,0 +1,92 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsExchange.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+void ogsSizeDispatch_t::Start(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(pinnedMemory<float> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(pinnedMemory<double> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(pinnedMemory<int> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(pinnedMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+
+void ogsSizeDispatch_t::Start(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Start(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { selected->Start(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(deviceMemory<float> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(deviceMemory<double> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(deviceMemory<int> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+void ogsSizeDispatch_t::Finish(deviceMemory<long long int> &buf, const int k, const Op op, const Transpose trans) { selected->Finish(buf, k, op, trans); SyncBuffers(); }
+
+ogsSizeDispatch_t::ogsSizeDispatch_t(std::vector<size_t> &_sizes,
+                                     std::vector<std::shared_ptr<ogsExchange_t>> &_exchanges):
+  ogsExchange_t(_exchanges[0]->platform, _exchanges[0]->comm, _exchanges[0]->dataStream),
+  sizes(_sizes),
+  exchanges(_exchanges) {
+
+  Nhalo  = exchanges[0]->Nhalo;
+  NhaloP = exchanges[0]->NhaloP;
+
+  selected = exchanges[0];
+  SyncBuffers();
+}
+
+//the selected exchange owns the workspaces, and may swap them while exchanging
+void ogsSizeDispatch_t::SyncBuffers() {
+  h_workspace = selected->h_workspace;
+  o_workspace = selected->o_workspace;
+  h_sendspace = selected->h_sendspace;
+  o_sendspace = selected->o_sendspace;
+  gpu_aware = selected->gpu_aware;
+}
+
+void ogsSizeDispatch_t::SetProgressThread(const bool enable) {
+  for (auto &exchange : exchanges) exchange->SetProgressThread(enable);
+}
+bool ogsSizeDispatch_t::ProgressThreadActive() const { return selected->ProgressThreadActive(); }
+void ogsSizeDispatch_t::Progress() { selected->Progress(); }
+
+void ogsSizeDispatch_t::AllocBuffer(size_t Nbytes) {
+  //pick the exchange tuned for the largest size not exceeding Nbytes
+  size_t s = 0;
+  while (s+1<sizes.size() && sizes[s+1]<=Nbytes) s++;
+
+  selected = exchanges[s];
+  selected->AllocBuffer(Nbytes);
+  SyncBuffers();
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -0,0 +1,201 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include "ogs/ogsStats.hpp"
+
+namespace libp {
+
+namespace ogs {
+
+std::vector<std::weak_ptr<ogsStats_t>> ogsStats_t::registry;
+
+ogsStats_t::ogsStats_t(platform_t &_platform, comm_t _comm, const Kind _kind,
+                       const dlong Nshared, memory<parallelNode_t> &sharedNodes):
+  platform(_platform),
+  comm(_comm),
+  kind(_kind) {
+
+  int size = comm.size();
+
+  //count the halo entries sent to each rank, and share the counts so we
+  // know what we'll receive
+  memory<int> mpiSendCountsN(size,0);
+  memory<int> mpiSendCountsT(size,0);
+  memory<int> mpiRecvCountsN(size);
+  memory<int> mpiRecvCountsT(size);
+
+  for (dlong n=0;n<Nshared;n++) {
+    const int r = sharedNodes[n].rank;
+    if (sharedNodes[n].sign>0) mpiSendCountsN[r]++;
+    mpiSendCountsT[r]++;
+  }
+
+  comm.Alltoall(mpiSendCountsT, mpiRecvCountsT);
+  comm.Alltoall(mpiSendCountsN, mpiRecvCountsN);
+
+  Nneighbours=0;
+  for (int r=0;r<size;r++) {
+    if (mpiSendCountsT[r] || mpiRecvCountsT[r]) Nneighbours++;
+  }
+
+  neighbours.malloc(Nneighbours);
+  sendCountsN.malloc(Nneighbours);
+  sendCountsT.malloc(Nneighbours);
+  recvCountsN.malloc(Nneighbours);
+  recvCountsT.malloc(Nneighbours);
+
+  Nneighbours=0;
+  for (int r=0;r<size;r++) {
+    if (mpiSendCountsT[r] || mpiRecvCountsT[r]) {
+      neighbours[Nneighbours]  = r;
+      sendCountsN[Nneighbours] = mpiSendCountsN[r];
+      sendCountsT[Nneighbours] = mpiSendCountsT[r];
+      recvCountsN[Nneighbours] = mpiRecvCountsN[r];
+      recvCountsT[Nneighbours] = mpiRecvCountsT[r];
+      Nneighbours++;
+    }
+  }
+
+  bytesSent.malloc(Nneighbours);
+  bytesRecv.malloc(Nneighbours);
+
+  Reset();
+}
+
+std::shared_ptr<ogsStats_t> ogsStats_t::Create(platform_t &_platform, comm_t _comm,
+                                               const Kind _kind, const dlong Nshared,
+                                               memory<parallelNode_t> &sharedNodes) {
+  std::shared_ptr<ogsStats_t> stats =
+          std::make_shared<ogsStats_t>(_platform, _comm, _kind, Nshared, sharedNodes);
+  registry.push_back(stats);
+
+  //print the counters in platform_t::Report
+  _platform.addReport("ogs", [](comm_t comm) { ReportAll(comm); });
+  return stats;
+}
+
+std::shared_ptr<ogsStats_t> ogsStats_t::Clone(const Kind _kind) const {
+  std::shared_ptr<ogsStats_t> stats = std::make_shared<ogsStats_t>(*this);
+  stats->kind = _kind;
+  stats->bytesSent.malloc(Nneighbours);
+  stats->bytesRecv.malloc(Nneighbours);
+  stats->Reset();
+  registry.push_back(stats);
+  return stats;
+}
+
+void ogsStats_t::Message(const size_t Nbytes, const Transpose trans) {
+  const int *sendCounts = (trans==NoTrans) ? sendCountsN.ptr() : sendCountsT.ptr();
+  const int *recvCounts = (trans==NoTrans) ? recvCountsN.ptr() : recvCountsT.ptr();
+  for (int n=0;n<Nneighbours;n++) {
+    bytesSent[n] += Nbytes*sendCounts[n];
+    bytesRecv[n] += Nbytes*recvCounts[n];
+  }
+}
+
+void ogsStats_t::Reset() {
+  for (int n=0;n<Noperations;n++) calls[n] = 0;
+  for (int n=0;n<Nphases;n++) time[n] = 0.0;
+  for (int n=0;n<Nneighbours;n++) {
+    bytesSent[n] = 0;
+    bytesRecv[n] = 0;
+  }
+}
+
+void ogsStats_t::Report(const std::string name) const {
+
+  int rank = comm.rank();
+  int size = comm.size();
+
+  //per-rank quantities to aggregate
+  constexpr int Nvals = Nphases+3;
+  memory<double> vals(Nvals);
+  for (int n=0;n<Nphases;n++) vals[n] = time[n];
+
+  double sent=0.0, recv=0.0;
+  for (int n=0;n<Nneighbours;n++) {
+    sent += bytesSent[n];
+    recv += bytesRecv[n];
+  }
+  vals[Nphases+0] = sent;
+  vals[Nphases+1] = recv;
+  vals[Nphases+2] = Nneighbours;
+
+  memory<double> minVals(Nvals), maxVals(Nvals), sumVals(Nvals);
+  comm.Allreduce(vals, minVals, Comm::Min);
+  comm.Allreduce(vals, maxVals, Comm::Max);
+  comm.Allreduce(vals, sumVals, Comm::Sum);
+
+  if (rank==0) {
+    const char* kindNames[3] = {"Unsigned", "Signed", "Halo"};
+    const char* valNames[Nvals] = {"pack time (s)", "MPI wait time (s)",
+                                   "unpack time (s)", "staging time (s)",
+                                   "bytes sent", "bytes received",
+                                   "neighbours"};
+
+    printf("ogs stats: %s (%s, %d ranks)\n", name.c_str(), kindNames[kind], size);
+    printf("   calls: GatherScatter %lld, Gather %lld, Scatter %lld, Exchange %lld, Combine %lld\n",
+           static_cast<long long int>(calls[GatherScatter]),
+           static_cast<long long int>(calls[Gather]),
+           static_cast<long long int>(calls[Scatter]),
+           static_cast<long long int>(calls[Exchange]),
+           static_cast<long long int>(calls[Combine]));
+    printf("                          min          avg          max\n");
+    for (int n=0;n<Nvals;n++) {
+      printf("   %-18s %5.3e    %5.3e    %5.3e\n", valNames[n],
+             minVals[n], sumVals[n]/size, maxVals[n]);
+    }
+  }
+}
+
+void ogsStats_t::ReportAll(comm_t comm) {
+  //forget the handles which have been destroyed
+  registry.erase(std::remove_if(registry.begin(), registry.end(),
+                                [](const std::weak_ptr<ogsStats_t> &entry) {
+                                  return entry.expired();
+                                }),
+                 registry.end());
+
+  //every rank sets up the same handles, so the registries should match
+  int Nhandles = static_cast<int>(registry.size());
+  int minNhandles = Nhandles, maxNhandles = Nhandles;
+  comm.Allreduce(minNhandles, Comm::Min);
+  comm.Allreduce(maxNhandles, Comm::Max);
+  if (minNhandles != maxNhandles) {
+    LIBP_FORCE_WARNING("Ranks set up different ogs handles, not reporting ogs stats");
+    return;
+  }
+
+  for (int handle=0;handle<Nhandles;handle++) {
+    registry[handle].lock()->Report("handle " + std::to_string(handle));
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
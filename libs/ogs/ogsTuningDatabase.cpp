@@ -0,0 +1,195 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "ogs.hpp"
+#include "ogs/ogsUtils.hpp"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+namespace libp {
+
+namespace ogs {
+
+/********************************
+ * Auto tuning database
+ ********************************/
+// The exchange methods Auto selects depend on the network, the number of
+// ranks, and how much each rank sends to whom, not on the ids themselves.
+// The selections are kept as plain text in
+//   <cache dir>/ogs/tuning/<host>-<size>-<key>.txt
+// one line per payload size, where the key hashes the thread model and
+// every rank's halo counts per neighbour. Rank 0 reads and writes the
+// file and broadcasts its contents.
+
+namespace {
+
+const char* tuningMethodNames[] = {"Auto", "Pairwise", "CrystalRouter", "AllToAll",
+                                   "Persistent", "Neighborhood", "Hierarchical"};
+constexpr int NtuningMethods = 7;
+
+} //namespace
+
+std::string ogsBase_t::TuningDatabaseFile(dlong Nshared,
+                                          memory<parallelNode_t> &sharedNodes) {
+
+  int rank = comm.rank();
+  int size = comm.size();
+
+  //count the halo entries this rank shares with each neighbour
+  memory<int> countsN(size, 0);
+  memory<int> countsT(size, 0);
+  for (dlong n=0;n<Nshared;n++) {
+    const int r = sharedNodes[n].rank;
+    if (sharedNodes[n].sign>0) countsN[r]++;
+    countsT[r]++;
+  }
+
+  uint64_t h = hashSeed;
+  h = hashBytes(&NhaloP, sizeof(dlong), h);
+  h = hashBytes(&NhaloT, sizeof(dlong), h);
+  for (int r=0;r<size;r++) {
+    if (countsT[r]) {
+      h = hashBytes(&r, sizeof(int), h);
+      h = hashBytes(&countsN[r], sizeof(int), h);
+      h = hashBytes(&countsT[r], sizeof(int), h);
+    }
+  }
+
+  //combine the halo signatures of all ranks
+  memory<long long int> hashes(size);
+  hashes[rank] = static_cast<long long int>(h);
+  comm.Allgather(hashes, 1);
+
+  std::string threadModel;
+  platform.settings().getSetting("THREAD MODEL", threadModel);
+
+  const int options[3] = {LIBP_VERSION, size, static_cast<int>(sizeof(dfloat))};
+  uint64_t key = hashBytes(options, sizeof(options), hashSeed);
+  key = hashBytes(threadModel.c_str(), threadModel.length(), key);
+  key = hashBytes(hashes.ptr(), size*sizeof(long long int), key);
+
+  //name the machine after the host of rank 0
+  memory<char> hostname(MAX_PROCESSOR_NAME);
+  std::memset(hostname.ptr(), 0, MAX_PROCESSOR_NAME);
+  int namelen;
+  Comm::GetProcessorName(hostname.ptr(), namelen);
+  comm.Bcast(hostname, 0);
+
+  std::stringstream ss;
+  ss << platform.getCacheDir() << "/ogs/tuning/"
+     << hostname.ptr() << "-" << size << "-"
+     << std::hex << std::setw(16) << std::setfill('0') << key << ".txt";
+  return ss.str();
+}
+
+void ogsBase_t::LoadTuningDatabase(const std::string fileName,
+                                   std::vector<tuningEntry_t> &entries) {
+
+  entries.clear();
+
+  //rank 0 reads the entries, as (bytes, method, gpu-aware) triples
+  memory<long long int> data;
+  int Nentries = 0;
+
+  if (comm.rank()==0) {
+    std::vector<long long int> values;
+    std::ifstream file(fileName);
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty() || line[0]=='#') continue;
+
+      std::istringstream iss(line);
+      long long int Nbytes;
+      std::string name;
+      int gpu_aware;
+      if (!(iss >> Nbytes >> name >> gpu_aware) || Nbytes<=0) continue;
+
+      int m = NtuningMethods;
+      for (int i=1;i<NtuningMethods;i++) {
+        if (name == tuningMethodNames[i]) m = i;
+      }
+      if (m == NtuningMethods) continue;
+
+      values.push_back(Nbytes);
+      values.push_back(m);
+      values.push_back(gpu_aware);
+    }
+    Nentries = static_cast<int>(values.size()/3);
+    data.malloc(3*Nentries);
+    for (int n=0;n<3*Nentries;n++) data[n] = values[n];
+  }
+
+  comm.Bcast(Nentries, 0);
+  if (Nentries==0) return;
+
+  if (comm.rank()!=0) data.malloc(3*Nentries);
+  comm.Bcast(data, 0);
+
+  for (int n=0;n<Nentries;n++) {
+    entries.push_back({static_cast<size_t>(data[3*n+0]),
+                       static_cast<Method>(data[3*n+1]),
+                       data[3*n+2]!=0});
+  }
+}
+
+void ogsBase_t::SaveTuningDatabase(const std::string fileName,
+                                   const std::vector<tuningEntry_t> &entries) {
+
+  if (comm.rank()!=0) return;
+
+  std::error_code ec;
+  std::filesystem::create_directories(std::filesystem::path(fileName).parent_path(), ec);
+
+  //write to a temporary file and move it into place, so a concurrent
+  // run never reads a partial database
+  const std::string tmpName = fileName + ".tmp";
+  std::ofstream file(tmpName);
+  LIBP_WARNING("Unable to write ogs tuning database " << tmpName,
+               !file.is_open());
+  if (!file.is_open()) return;
+
+  file << "# libParanumal ogs::Auto selections" << std::endl;
+  file << "# bytes per entry, exchange method, GPU-aware" << std::endl;
+  for (const tuningEntry_t &entry : entries) {
+    file << entry.Nbytes << " "
+         << tuningMethodNames[static_cast<int>(entry.method)] << " "
+         << (entry.gpu_aware ? 1 : 0) << std::endl;
+  }
+  file.close();
+
+  if (file) {
+    std::filesystem::rename(tmpName, fileName, ec);
+  } else {
+    std::filesystem::remove(tmpName, ec);
+  }
+}
+
+} //namespace ogs
+
+} //namespace libp
@@ -40,6 +40,9 @@ kernel_t ogsOperator_t::gatherScatterKernel[4][4];
 kernel_t ogsOperator_t::gatherKernel[4][4];
 kernel_t ogsOperator_t::scatterKernel[4];
 
+kernel_t ogsFusedOperator_t::gatherScatterKernel[4][4];
+kernel_t ogsFusedOperator_t::gatherKernel[4][4];
+
 kernel_t ogsExchange_t::extractKernel[4];
 
 
@@ -111,6 +114,14 @@ void InitializeKernels(platform_t& platform, const Type type, const Op op) {
                                                 "gather",
                                                 kernelInfo);
 
+    ogsFusedOperator_t::gatherScatterKernel[type][op] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                              "fusedGatherScatter",
+                                                              kernelInfo);
+
+    ogsFusedOperator_t::gatherKernel[type][op] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
+                                                       "fusedGather",
+                                                       kernelInfo);
+
     if (!ogsOperator_t::scatterKernel[type].isInitialized()) {
       ogsOperator_t::scatterKernel[type] = platform.buildKernel(OGS_DIR "/okl/ogsKernels.okl",
                                                  "scatter",
@@ -120,6 +131,18 @@ void InitializeKernels(platform_t& platform, const Type type, const Op op) {
                                                 "extract", kernelInfo);\
     }
   }
+
+  //reduced precision payload conversions
+  if (type==Double && !ogsReducedPrecision_t::packKernel.isInitialized()) {
+    properties_t kernelInfo = platform.props();
+
+    kernelInfo["defines/p_blockSize"] = ogsOperator_t::blockSize;
+
+    ogsReducedPrecision_t::packKernel = platform.buildKernel(OGS_DIR "/okl/ogsReducedPrecision.okl",
+                                                "packFloat", kernelInfo);
+    ogsReducedPrecision_t::unpackKernel = platform.buildKernel(OGS_DIR "/okl/ogsReducedPrecision.okl",
+                                                  "unpackFloat", kernelInfo);
+  }
 }
 
 } //namespace ogs
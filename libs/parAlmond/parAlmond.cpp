@@ -41,7 +41,7 @@ void parAlmond_t::Setup(platform_t& _platform, settings_t& _settings, comm_t com
                                 "axpy", "zaxpy",
                                 "amx", "amxpy", "zamxpy",
                                 "adx", "adxpy", "zadxpy",
-                                "innerProd", "norm2"});
+                                "innerProd", "innerProds", "norm2"});
 
   multigrid = std::make_shared<multigrid_t>(platform, settings, comm);
 
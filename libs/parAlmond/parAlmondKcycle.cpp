@@ -25,7 +25,6 @@ SOFTWARE.
 */
 
 #include "parAlmond.hpp"
-#include "parAlmond/parAlmondKernels.hpp"
 #include "parAlmond/parAlmondCoarseSolver.hpp"
 
 namespace libp {
@@ -36,10 +35,13 @@ void multigrid_t::kcycle(const int k, deviceMemory<dfloat>& o_RHS, deviceMemory<
 
   //check for base level
   if(k==baseLevel) {
+    LIBP_PROFILE("coarse solve");
     coarseSolver->solve(o_RHS, o_X);
     return;
   }
 
+  LIBP_PROFILE(Profiler::Enabled() ? "level " + std::to_string(k) : std::string());
+
   multigridLevel& level  = *levels[k];
   multigridLevel& levelC = *levels[k+1];
   deviceMemory<dfloat>& o_RHSC = o_rhs[k+1];
@@ -103,24 +105,46 @@ void multigrid_t::kcycleOp1(multigridLevel& level,
                            dfloat& alpha1, dfloat& rho1,
                            dfloat& norm_rhs, dfloat& norm_rhstilde) {
 
+  linAlg_t& linAlg = platform.linAlg();
+  const dlong N = level.Nrows;
+
   //ck = x
-  platform.linAlg().axpy(level.Nrows, 1.0, o_X, 0.0, o_CK);
+  linAlg.axpy(N, 1.0, o_X, 0.0, o_CK);
 
   // vk = A*ck
   level.Operator(o_CK,o_VK);
 
-  // alpha1=ck*rhsC, rho1=ck*Ack, norm_rhs=sqrt(rhsC*rhsC)
-  if(ktype == PCG)
-    kcycleCombinedOp1(level, o_CK, o_RHS, o_VK, alpha1, rho1, norm_rhs);
-
-  if(ktype == GMRES)
-    kcycleCombinedOp1(level, o_VK, o_RHS, o_VK, alpha1, rho1, norm_rhs);
+  // alpha1=ck*rhsC, rho1=ck*Ack, norm_rhs=sqrt(rhsC*rhsC), along with
+  // vk*rhsC and vk*vk for the norm of the updated rhs, in one reduction
+  dfloat rhsDotrhs, vkDotrhs, vkDotvk;
+  if(ktype == PCG) {
+    linAlg.innerProds(N, {{o_CK, o_RHS}, {o_CK, o_VK}, {o_RHS, o_RHS},
+                          {o_VK, o_RHS}, {o_VK, o_VK}},
+                      reductionScratch, comm);
+    alpha1    = reductionScratch[0];
+    rho1      = reductionScratch[1];
+    rhsDotrhs = reductionScratch[2];
+    vkDotrhs  = reductionScratch[3];
+    vkDotvk   = reductionScratch[4];
+  } else {
+    linAlg.innerProds(N, {{o_VK, o_RHS}, {o_VK, o_VK}, {o_RHS, o_RHS}},
+                      reductionScratch, comm);
+    alpha1    = reductionScratch[0];
+    rho1      = reductionScratch[1];
+    rhsDotrhs = reductionScratch[2];
+    vkDotrhs  = alpha1;
+    vkDotvk   = rho1;
+  }
 
-  norm_rhs = sqrt(norm_rhs);
+  norm_rhs = sqrt(rhsDotrhs);
 
   // rhs = rhs - (alpha1/rho1)*vk
   const dfloat a = -(alpha1)/(rho1);
-  norm_rhstilde = sqrt(vectorAddInnerProd(level, a, o_VK, 1.0, o_RHS));
+  linAlg.axpy(N, a, o_VK, 1.0, o_RHS);
+
+  // ||rhs + a*vk||^2 = rhs*rhs + 2a vk*rhs + a^2 vk*vk
+  const dfloat rhstildeDotrhstilde = rhsDotrhs + 2*a*vkDotrhs + a*a*vkDotvk;
+  norm_rhstilde = sqrt(std::max(rhstildeDotrhstilde, static_cast<dfloat>(0.0)));
 }
 
 void multigrid_t::kcycleOp2(multigridLevel& level,
@@ -133,13 +157,16 @@ void multigrid_t::kcycleOp2(multigridLevel& level,
     level.Operator(o_X,o_WK);
 
     // gamma=xC*Ack, beta=xC*AxC, alpha2=xC*rhsC
-    dfloat gamma, beta, alpha2;
-
     if(ktype == PCG)
-      kcycleCombinedOp2(level, o_X, o_VK, o_WK, o_RHS, gamma, beta, alpha2);
+      platform.linAlg().innerProds(level.Nrows, {{o_X, o_VK}, {o_X, o_WK}, {o_X, o_RHS}},
+                                   reductionScratch, comm);
+    else
+      platform.linAlg().innerProds(level.Nrows, {{o_WK, o_VK}, {o_WK, o_WK}, {o_WK, o_RHS}},
+                                   reductionScratch, comm);
 
-    if(ktype == GMRES)
-      kcycleCombinedOp2(level, o_WK, o_VK, o_WK, o_RHS, gamma, beta, alpha2);
+    const dfloat gamma  = reductionScratch[0];
+    const dfloat beta   = reductionScratch[1];
+    const dfloat alpha2 = reductionScratch[2];
 
     const dfloat rho2 = beta - gamma*gamma/rho1;
 
@@ -153,97 +180,6 @@ void multigrid_t::kcycleOp2(multigridLevel& level,
   }
 }
 
-// returns aDotbc[0] = a\dot b, aDotbc[1] = a\dot c, aDotbc[2] = b\dot b,
-void multigrid_t::kcycleCombinedOp1(multigridLevel& level,
-                                    deviceMemory<dfloat>& o_a,
-                                    deviceMemory<dfloat>& o_b,
-                                    deviceMemory<dfloat>& o_c,
-                                    dfloat& aDotb,
-                                    dfloat& aDotc,
-                                    dfloat& bDotb) {
-
-  const dlong N = level.Nrows;
-  dlong numBlocks = std::min(N, PARALMOND_NBLOCKS);
-
-  kcycleCombinedOp1Kernel(numBlocks,N,o_a,o_b,o_c,o_reductionScratch);
-
-  if (numBlocks>0) {
-    reductionScratch.copyFrom(o_reductionScratch,3*numBlocks);
-  } else {
-    reductionScratch[0] = 0.0;
-    reductionScratch[1] = 0.0;
-    reductionScratch[2] = 0.0;
-  }
-
-  for(dlong i=1; i<numBlocks; i++) {
-    reductionScratch[0] += reductionScratch[3*i+0];
-    reductionScratch[1] += reductionScratch[3*i+1];
-    reductionScratch[2] += reductionScratch[3*i+2];
-  }
-  comm.Allreduce(reductionScratch, Comm::Sum, 3);
-  aDotb = reductionScratch[0];
-  aDotc = reductionScratch[1];
-  bDotb = reductionScratch[2];
-}
-
-// returns aDotbcd[0] = a\dot b, aDotbcd[1] = a\dot c, aDotbcd[2] = a\dot d,
-void multigrid_t::kcycleCombinedOp2(multigridLevel& level,
-                                    deviceMemory<dfloat>& o_a,
-                                    deviceMemory<dfloat>& o_b,
-                                    deviceMemory<dfloat>& o_c,
-                                    deviceMemory<dfloat>& o_d,
-                                    dfloat& aDotb,
-                                    dfloat& aDotc,
-                                    dfloat& aDotd) {
-
-  const dlong N = level.Nrows;
-  dlong numBlocks = std::min(N, PARALMOND_NBLOCKS);
-
-  kcycleCombinedOp2Kernel(numBlocks,N,o_a,o_b,o_c,o_d,o_reductionScratch);
-
-  if (numBlocks>0) {
-    reductionScratch.copyFrom(o_reductionScratch,3*numBlocks);
-  } else {
-    reductionScratch[0] = 0.0;
-    reductionScratch[1] = 0.0;
-    reductionScratch[2] = 0.0;
-  }
-
-  for(dlong i=1; i<numBlocks; i++) {
-    reductionScratch[0] += reductionScratch[3*i+0];
-    reductionScratch[1] += reductionScratch[3*i+1];
-    reductionScratch[2] += reductionScratch[3*i+2];
-  }
-  comm.Allreduce(reductionScratch, Comm::Sum, 3);
-  aDotb = reductionScratch[0];
-  aDotc = reductionScratch[1];
-  aDotd = reductionScratch[2];
-}
-
-// y = beta*y + alpha*x, and return y\dot y
-dfloat multigrid_t::vectorAddInnerProd(multigridLevel& level,
-                                      const dfloat alpha, deviceMemory<dfloat>& o_X,
-                                      const dfloat beta,  deviceMemory<dfloat>& o_Y){
-
-  const dlong N = level.Nrows;
-  dlong numBlocks = std::min(N, PARALMOND_NBLOCKS);
-
-  vectorAddInnerProdKernel(numBlocks,N,alpha,beta,o_X,o_Y,o_reductionScratch);
-
-  if (numBlocks>0) {
-    reductionScratch.copyFrom(o_reductionScratch,numBlocks);
-  } else {
-    reductionScratch[0] = 0.0;
-  }
-
-  // #pragma omp parallel for reduction(+:result)
-  for (dlong i=1; i<numBlocks; i++) {
-    reductionScratch[0] += reductionScratch[i];
-  }
-  comm.Allreduce(reductionScratch, Comm::Sum, 1);
-  return reductionScratch[0];
-}
-
 } //namespace parAlmond
 
 } //namespace libp
@@ -43,10 +43,6 @@ kernel_t SmoothChebyshevCSRKernel;
 kernel_t SmoothChebyshevMCSRKernel;
 kernel_t SmoothChebyshevUpdateKernel;
 
-kernel_t kcycleCombinedOp1Kernel;
-kernel_t kcycleCombinedOp2Kernel;
-kernel_t vectorAddInnerProdKernel;
-
 kernel_t dGEMVKernel;
 
 void buildParAlmondKernels(platform_t& platform){
@@ -77,11 +73,6 @@ void buildParAlmondKernels(platform_t& platform){
     SmoothChebyshevMCSRKernel = platform.buildKernel(PARALMOND_DIR"/okl/SmoothChebyshev.okl", "SmoothChebyshevMCSR", kernelInfo);
     SmoothChebyshevUpdateKernel = platform.buildKernel(PARALMOND_DIR"/okl/SmoothChebyshev.okl", "SmoothChebyshevUpdate", kernelInfo);
 
-    vectorAddInnerProdKernel = platform.buildKernel(PARALMOND_DIR"/okl/vectorAddInnerProd.okl", "vectorAddInnerProd", kernelInfo);
-
-    kcycleCombinedOp1Kernel = platform.buildKernel(PARALMOND_DIR"/okl/kcycleCombinedOp.okl", "kcycleCombinedOp1", kernelInfo);
-    kcycleCombinedOp2Kernel = platform.buildKernel(PARALMOND_DIR"/okl/kcycleCombinedOp.okl", "kcycleCombinedOp2", kernelInfo);
-
     dGEMVKernel = platform.buildKernel(PARALMOND_DIR"/okl/dGEMV.okl", "dGEMV", kernelInfo);
 
     if(rank==0) printf("done.\n");
@@ -33,6 +33,8 @@ namespace libp {
 namespace parAlmond {
 
 void multigrid_t::Operator(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_X) {
+  LIBP_PROFILE("multigrid");
+
   if (ctype == KCYCLE) {
     kcycle(0, o_RHS, o_X);
   } else {
@@ -105,11 +107,8 @@ void multigrid_t::AllocateLevelWorkSpace(const int k){
 
   if (ctype==KCYCLE) {
     //first level
-    if (NreductionScratch==0) {
-      NreductionScratch = 3*PARALMOND_NBLOCKS;
-      memory<dfloat> dummy(3*PARALMOND_NBLOCKS, 0.0);
-      reductionScratch = platform.hostMalloc<dfloat>(NreductionScratch, dummy);
-      o_reductionScratch = platform.malloc<dfloat>(NreductionScratch, dummy);
+    if (reductionScratch.length()==0) {
+      reductionScratch.malloc(5);
     }
 
     //extra stroage for kcycle vectors
@@ -35,10 +35,13 @@ void multigrid_t::vcycle(const int k, deviceMemory<dfloat>& o_RHS, deviceMemory<
 
   //check for base level
   if(k==baseLevel) {
+    LIBP_PROFILE("coarse solve");
     coarseSolver->solve(o_RHS, o_X);
     return;
   }
 
+  LIBP_PROFILE(Profiler::Enabled() ? "level " + std::to_string(k) : std::string());
+
   multigridLevel& level = *levels[k];
   deviceMemory<dfloat>& o_RHSC = o_rhs[k+1];
   deviceMemory<dfloat>& o_XC   = o_x[k+1];
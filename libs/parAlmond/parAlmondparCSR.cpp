@@ -212,11 +212,12 @@ parCSR::parCSR(parCOO& A):       // number of nonzeros on this rank
   }
   haloSetup(colIds); //setup halo, and transform colIds to a local indexing
 
-  //fill the CSR matrices
-  diag.cols.malloc(diag.nnz);
-  offd.cols.malloc(offd.nnz);
-  diag.vals.malloc(diag.nnz);
-  offd.vals.malloc(offd.nnz);
+  //fill the CSR matrices. The fill is serial, so place the pages for the
+  //threaded SpMV first
+  diag.cols.malloc(diag.nnz, Memory::ParallelFirstTouch);
+  offd.cols.malloc(offd.nnz, Memory::ParallelFirstTouch);
+  diag.vals.malloc(diag.nnz, Memory::ParallelFirstTouch);
+  offd.vals.malloc(offd.nnz, Memory::ParallelFirstTouch);
   dlong diagCnt = 0;
   dlong offdCnt = 0;
   for (dlong n=0;n<A.nnz;n++) {
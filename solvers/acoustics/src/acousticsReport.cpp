@@ -27,6 +27,7 @@ SOFTWARE.
 #include "acoustics.hpp"
 
 void acoustics_t::Report(dfloat time, int tstep){
+  LIBP_PROFILE("Report");
 
   static int frame=0;
 
@@ -34,10 +35,9 @@ void acoustics_t::Report(dfloat time, int tstep){
   mesh.MassMatrixApply(o_q, o_Mq);
 
   dlong Nentries = mesh.Nelements*mesh.Np*Nfields;
-  dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
-  if(mesh.rank==0)
-    printf("%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
+  //the norm's reduction completes behind the output work below
+  linAlgReduction_t normReduction = platform.linAlg().innerProdAsync(Nentries, o_q, o_Mq, mesh.comm);
 
   if (settings.compareSetting("OUTPUT TO FILE","TRUE")) {
 
@@ -52,4 +52,9 @@ void acoustics_t::Report(dfloat time, int tstep){
 
     PlotFields(q, std::string(fname));
   }
+
+  dfloat norm2 = sqrt(normReduction.Wait());
+
+  if(mesh.rank==0)
+    printf("%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
 }
@@ -48,6 +48,13 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(Nfields);
 
+  //FLOAT-COMPENSATED contains FLOAT, so test it first
+  if (settings.compareSetting("HALO PRECISION","FLOAT-COMPENSATED")) {
+    traceHalo.SetPrecision(ogs::SingleCompensated);
+  } else if (settings.compareSetting("HALO PRECISION","FLOAT")) {
+    traceHalo.SetPrecision(ogs::Single);
+  }
+
   //setup timeStepper
   if (settings.compareSetting("TIME INTEGRATOR","AB3")){
     timeStepper.Setup<TimeStepper::ab3>(mesh.Nelements,
@@ -117,18 +124,40 @@ void acoustics_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   std::string fileName, kernelName;
 
+  //scratch rhs and time for timing the tuned kernels
+  deviceMemory<dfloat> o_tuneRHS = platform.malloc<dfloat>(Nlocal);
+  const dfloat tuneT = 0.0;
+
   // kernels from volume file
   fileName   = oklFilePrefix + "acousticsVolume" + suffix + oklFileSuffix;
   kernelName = "acousticsVolume" + suffix;
 
-  volumeKernel =  platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  tuningSpace_t volumeSpace;
+  volumeSpace.addBlockDefine("p_NblockV", NblockV, mesh.Np);
+
+  volumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, volumeSpace,
+    [&](kernel_t& kernel) {
+      kernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D, o_q, o_tuneRHS);
+    }, o_tuneRHS);
+
   // kernels from surface file
   fileName   = oklFilePrefix + "acousticsSurface" + suffix + oklFileSuffix;
   kernelName = "acousticsSurface" + suffix;
 
-  surfaceKernel = platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  tuningSpace_t surfaceSpace;
+  surfaceSpace.addBlockDefine("p_NblockS", NblockS, maxNodes);
+
+  surfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, surfaceSpace,
+    [&](kernel_t& kernel) {
+      if (mesh.NinternalElements)
+        kernel(mesh.NinternalElements, mesh.o_internalElementIds,
+               mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM, mesh.o_vmapP, mesh.o_EToB,
+               tuneT, mesh.o_x, mesh.o_y, mesh.o_z, o_q, o_tuneRHS);
+      if (mesh.NhaloElements)
+        kernel(mesh.NhaloElements, mesh.o_haloElementIds,
+               mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM, mesh.o_vmapP, mesh.o_EToB,
+               tuneT, mesh.o_x, mesh.o_y, mesh.o_z, o_q, o_tuneRHS);
+    }, o_tuneRHS);
 
   if (mesh.dim==2) {
     fileName   = oklFilePrefix + "acousticsInitialCondition2D" + oklFileSuffix;
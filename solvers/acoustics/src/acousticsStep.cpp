@@ -34,6 +34,7 @@ dfloat acoustics_t::MaxWaveSpeed(){
 
 //evaluate ODE rhs = f(q,t)
 void acoustics_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
 
   // extract q halo on DEVICE
   traceHalo.ExchangeStart(o_Q, 1);
@@ -28,6 +28,7 @@ SOFTWARE.
 
 // interpolate data to plot nodes and save to file (one per process
 void advection_t::PlotFields(memory<dfloat> Q, const std::string fileName){
+  LIBP_PROFILE("I/O");
 
   FILE *fp;
 
@@ -105,17 +105,36 @@ void advection_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   std::string fileName, kernelName;
 
+  //scratch rhs and time for timing the tuned kernels
+  deviceMemory<dfloat> o_tuneRHS = platform.malloc<dfloat>(Nlocal);
+  const dfloat tuneT = 0.0;
+
   // kernels from volume file
   fileName   = oklFilePrefix + "advectionVolume" + suffix + oklFileSuffix;
   kernelName = "advectionVolume" + suffix;
 
-  volumeKernel =  platform.buildKernel(fileName, kernelName, kernelInfo);
+  tuningSpace_t volumeSpace;
+  volumeSpace.addBlockDefine("p_NblockV", NblockV, mesh.Np);
+
+  volumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, volumeSpace,
+    [&](kernel_t& kernel) {
+      kernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D, tuneT,
+             mesh.o_x, mesh.o_y, mesh.o_z, o_q, o_tuneRHS);
+    }, o_tuneRHS);
 
   // kernels from surface file
   fileName   = oklFilePrefix + "advectionSurface" + suffix + oklFileSuffix;
   kernelName = "advectionSurface" + suffix;
 
-  surfaceKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+  tuningSpace_t surfaceSpace;
+  surfaceSpace.addBlockDefine("p_NblockS", NblockS, maxNodes);
+
+  surfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, surfaceSpace,
+    [&](kernel_t& kernel) {
+      kernel(mesh.Nelements, mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM,
+             mesh.o_vmapP, mesh.o_EToB, tuneT, mesh.o_x, mesh.o_y, mesh.o_z,
+             o_q, o_tuneRHS);
+    }, o_tuneRHS);
 
   if (mesh.dim==2) {
     fileName   = oklFilePrefix + "advectionInitialCondition2D" + oklFileSuffix;
@@ -50,6 +50,7 @@ dfloat advection_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
 
 //evaluate ODE rhs = f(q,t)
 void advection_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
 
   // extract q halo on DEVICE
   traceHalo.ExchangeStart(o_Q, 1);
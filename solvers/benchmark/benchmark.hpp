@@ -0,0 +1,80 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#ifndef BENCHMARK_HPP
+#define BENCHMARK_HPP 1
+
+#include "elliptic.hpp"
+
+#define DBENCHMARK LIBP_DIR"/solvers/benchmark/"
+
+using namespace libp;
+
+class benchmarkSettings_t: public ellipticSettings_t {
+public:
+  benchmarkSettings_t(const comm_t& _comm);
+  void report();
+};
+
+/*One point of the sweep. Sizes are global, and times are taken on the
+  slowest rank*/
+struct benchmarkResult_t {
+  std::string problem;
+  std::string elementType;
+  int N;
+  int ranks;
+  hlong Nelements;
+  hlong Ndofs;        //unknowns of one application, over all components
+  int Napplications;  //operator applications timed (PCG iterations)
+  int iterations;     //PCG iterations, zero for the operator problems
+  double time;        //seconds
+  double bytes;       //modelled bytes moved by the element kernels
+
+  double dofsPerSecond() const { return time>0.0 ? Ndofs*static_cast<double>(Napplications)/time : 0.0; }
+  double GBPerSecond()   const { return time>0.0 ? bytes/time/1.0e9 : 0.0; }
+};
+
+/*Run one problem at degree N on a BOX mesh of NboxElements elements per
+  rank in each direction. Collective*/
+benchmarkResult_t RunBenchmark(platform_t& platform,
+                               meshSettings_t& meshSettings,
+                               benchmarkSettings_t& settings,
+                               const std::string problem,
+                               const int N, const int NboxElements);
+
+/*Split a comma or space separated setting value*/
+std::vector<std::string> BenchmarkList(const std::string list);
+
+void BenchmarkPrintHeader();
+void BenchmarkPrint(const benchmarkResult_t& result);
+void BenchmarkWriteCSV(const std::string fileName,
+                       const std::vector<benchmarkResult_t>& results);
+void BenchmarkWriteJSON(const std::string fileName,
+                        platform_t& platform,
+                        const std::vector<benchmarkResult_t>& results);
+
+#endif
@@ -0,0 +1,98 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "benchmark.hpp"
+#include <fstream>
+
+void BenchmarkPrintHeader() {
+  printf("%-6s %-7s %3s %6s %12s %14s %6s %11s %14s %10s\n",
+         "prob", "element", "N", "ranks", "elements", "dofs", "iters",
+         "time (s)", "dofs/s", "GB/s");
+}
+
+void BenchmarkPrint(const benchmarkResult_t& result) {
+  printf("%-6s %-7s %3d %6d %12lld %14lld %6d %11.4e %14.6e %10.3f\n",
+         result.problem.c_str(), result.elementType.c_str(),
+         result.N, result.ranks,
+         static_cast<long long int>(result.Nelements),
+         static_cast<long long int>(result.Ndofs),
+         result.iterations, result.time,
+         result.dofsPerSecond(), result.GBPerSecond());
+  fflush(stdout);
+}
+
+void BenchmarkWriteCSV(const std::string fileName,
+                       const std::vector<benchmarkResult_t>& results) {
+
+  std::ofstream file(fileName);
+  LIBP_WARNING("Unable to write benchmark results " << fileName,
+               !file.is_open());
+  if (!file.is_open()) return;
+
+  file << "problem,element,N,ranks,elements,dofs,applications,iterations,"
+       << "time,dofs_per_second,GB_per_second\n";
+  file.precision(8);
+  for (const benchmarkResult_t& r : results) {
+    file << r.problem << "," << r.elementType << "," << r.N << ","
+         << r.ranks << "," << r.Nelements << "," << r.Ndofs << ","
+         << r.Napplications << "," << r.iterations << ","
+         << r.time << "," << r.dofsPerSecond() << "," << r.GBPerSecond() << "\n";
+  }
+  printf("Benchmark results written to %s\n", fileName.c_str());
+}
+
+void BenchmarkWriteJSON(const std::string fileName,
+                        platform_t& platform,
+                        const std::vector<benchmarkResult_t>& results) {
+
+  std::ofstream file(fileName);
+  LIBP_WARNING("Unable to write benchmark results " << fileName,
+               !file.is_open());
+  if (!file.is_open()) return;
+
+  file.precision(8);
+  file << "{\"ranks\": " << platform.size()
+       << ", \"thread model\": \"" << platform.settings().getSetting("THREAD MODEL") << "\""
+       << ", \"dfloat\": \"" << dfloatString << "\""
+       << ", \"results\": [";
+  for (size_t n=0;n<results.size();n++) {
+    const benchmarkResult_t& r = results[n];
+    file << (n ? ",\n" : "\n") << "  {\"problem\": \"" << r.problem << "\""
+         << ", \"element\": \"" << r.elementType << "\""
+         << ", \"N\": " << r.N
+         << ", \"ranks\": " << r.ranks
+         << ", \"elements\": " << r.Nelements
+         << ", \"dofs\": " << r.Ndofs
+         << ", \"applications\": " << r.Napplications
+         << ", \"iterations\": " << r.iterations
+         << ", \"time\": " << r.time
+         << ", \"dofs per second\": " << r.dofsPerSecond()
+         << ", \"GB per second\": " << r.GBPerSecond() << "}";
+  }
+  file << "]}\n";
+  printf("Benchmark results written to %s\n", fileName.c_str());
+}
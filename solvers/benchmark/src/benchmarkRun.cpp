@@ -0,0 +1,235 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "benchmark.hpp"
+#include "timer.hpp"
+
+/* The problems follow the CEED bake-off problems on BOX meshes:
+     BP1, BP2  mass matrix apply with 1 and 3 components
+     BP5, BP6  C0 stiffness (partial Ax, gather, scatter) with 1 and 3
+               components
+     IPDG      the BP5 operator in IPDG form
+     PCG       PCG solve of the BP5 system
+   libParanumal's operators are collocated on the GLL nodes, so the
+   over-integrated BP3 and BP4 are not available. The vector problems
+   apply the scalar operator to each component.
+
+   Bytes are modelled as the minimum traffic of the element kernels
+   (fields, geometric factors, and index maps each moved once), and leave
+   out the gather/scatter and halo exchanges.*/
+
+namespace {
+
+std::string ElementName(const mesh_t& mesh) {
+  switch (mesh.elementType) {
+    case Mesh::TRIANGLES:      return (mesh.dim==2) ? "Tri2D" : "Tri3D";
+    case Mesh::QUADRILATERALS: return (mesh.dim==2) ? "Quad2D" : "Quad3D";
+    case Mesh::TETRAHEDRA:     return "Tet3D";
+    default:                   return "Hex3D";
+  }
+}
+
+/*Geometric factor entries per element*/
+double PerElement(const memory<dfloat>& factors, const mesh_t& mesh) {
+  return mesh.Nelements ? static_cast<double>(factors.length())/mesh.Nelements : 0.0;
+}
+
+/*Sum a per-rank count over all ranks*/
+double GlobalSum(comm_t& comm, const double local) {
+  double global = 0.0;
+  comm.Allreduce(local, global, Comm::Sum);
+  return global;
+}
+
+void RunMass(platform_t& platform, mesh_t& mesh, const int Ncomponents,
+             const int Nreps, benchmarkResult_t& result) {
+
+  mesh.MassMatrixKernelSetup(Ncomponents);
+
+  const dlong Nlocal = mesh.Nelements*mesh.Np*Ncomponents;
+  deviceMemory<dfloat> o_q  = platform.malloc<dfloat>(memory<dfloat>(Nlocal, 1.0));
+  deviceMemory<dfloat> o_Mq = platform.malloc<dfloat>(Nlocal);
+
+  mesh.MassMatrixApply(o_q, o_Mq); //warm up
+
+  timePoint_t start = GlobalPlatformTime(platform);
+  for (int n=0;n<Nreps;n++) mesh.MassMatrixApply(o_q, o_Mq);
+  timePoint_t end = GlobalPlatformTime(platform);
+
+  const double bytesPerElement = (2.0*Ncomponents*mesh.Np + PerElement(mesh.wJ, mesh))*sizeof(dfloat);
+
+  result.Ndofs = mesh.NelementsGlobal*mesh.Np*Ncomponents;
+  result.Napplications = Nreps;
+  result.time = ElapsedTime(start, end);
+  result.bytes = GlobalSum(mesh.comm, bytesPerElement*mesh.Nelements)*Nreps;
+}
+
+void RunStiffness(platform_t& platform, elliptic_t& elliptic, const int Ncomponents,
+                  const int Nreps, benchmarkResult_t& result) {
+
+  mesh_t& mesh = elliptic.mesh;
+
+  const dlong Nall = elliptic.Ndofs + elliptic.Nhalo;
+  std::vector<deviceMemory<dfloat>> o_q(Ncomponents), o_Aq(Ncomponents);
+  for (int c=0;c<Ncomponents;c++) {
+    o_q[c]  = platform.malloc<dfloat>(memory<dfloat>(Nall, 1.0));
+    o_Aq[c] = platform.malloc<dfloat>(Nall);
+  }
+
+  elliptic.Operator(o_q[0], o_Aq[0]); //warm up
+
+  timePoint_t start = GlobalPlatformTime(platform);
+  for (int n=0;n<Nreps;n++) {
+    for (int c=0;c<Ncomponents;c++) elliptic.Operator(o_q[c], o_Aq[c]);
+  }
+  timePoint_t end = GlobalPlatformTime(platform);
+
+  double bytesPerElement;
+  if (elliptic.disc_c0) {
+    //q through GlobalToLocal, Aq, and the geometric factors
+    bytesPerElement = (2.0*mesh.Np + PerElement(mesh.ggeo, mesh) + PerElement(mesh.wJ, mesh))*sizeof(dfloat)
+                     + mesh.Np*sizeof(dlong);
+    result.Ndofs = elliptic.ogsMasked.NgatherGlobal*Ncomponents;
+  } else {
+    //gradient kernel: q in, 4 fields out. Ax kernel: 4 fields in (own
+    // and neighbours'), Aq out. Plus the volume and surface factors
+    bytesPerElement = (10.0*mesh.Np + PerElement(mesh.vgeo, mesh) + PerElement(mesh.sgeo, mesh))*sizeof(dfloat);
+    result.Ndofs = mesh.NelementsGlobal*mesh.Np*Ncomponents;
+  }
+
+  result.Napplications = Nreps;
+  result.time = ElapsedTime(start, end);
+  result.bytes = GlobalSum(mesh.comm, bytesPerElement*mesh.Nelements)*Ncomponents*Nreps;
+}
+
+void RunSolve(platform_t& platform, elliptic_t& elliptic, benchmarkSettings_t& settings,
+              benchmarkResult_t& result) {
+
+  mesh_t& mesh = elliptic.mesh;
+
+  int maxIter = 100;
+  dfloat tol = 1.0e-8;
+  settings.getSetting("BENCHMARK MAX ITERATIONS", maxIter);
+  settings.getSetting("BENCHMARK TOLERANCE", tol);
+
+  linearSolver_t linearSolver;
+  if (settings.compareSetting("LINEAR SOLVER","NBPCG")){
+    linearSolver.Setup<LinearSolver::nbpcg>(elliptic.Ndofs, elliptic.Nhalo, platform, settings, mesh.comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","PIPEPCG")){
+    linearSolver.Setup<LinearSolver::pipepcg>(elliptic.Ndofs, elliptic.Nhalo, platform, settings, mesh.comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+    linearSolver.Setup<LinearSolver::sstepcg>(elliptic.Ndofs, elliptic.Nhalo, platform, settings, mesh.comm);
+  } else {
+    linearSolver.Setup<LinearSolver::pcg>(elliptic.Ndofs, elliptic.Nhalo, platform, settings, mesh.comm);
+  }
+
+  const dlong Nall = elliptic.Ndofs + elliptic.Nhalo;
+  deviceMemory<dfloat> o_r = platform.malloc<dfloat>(memory<dfloat>(Nall, 1.0));
+  deviceMemory<dfloat> o_x = platform.malloc<dfloat>(memory<dfloat>(Nall, 0.0));
+
+  timePoint_t start = GlobalPlatformTime(platform);
+  const int iter = elliptic.Solve(linearSolver, o_x, o_r, tol, maxIter, 0);
+  timePoint_t end = GlobalPlatformTime(platform);
+
+  const double bytesPerElement = (2.0*mesh.Np + PerElement(mesh.ggeo, mesh) + PerElement(mesh.wJ, mesh))*sizeof(dfloat)
+                                + mesh.Np*sizeof(dlong);
+
+  result.Ndofs = elliptic.ogsMasked.NgatherGlobal;
+  result.Napplications = iter;
+  result.iterations = iter;
+  result.time = ElapsedTime(start, end);
+  result.bytes = GlobalSum(mesh.comm, bytesPerElement*mesh.Nelements)*iter;
+}
+
+} //namespace
+
+benchmarkResult_t RunBenchmark(platform_t& platform,
+                               meshSettings_t& meshSettings,
+                               benchmarkSettings_t& settings,
+                               const std::string problem,
+                               const int N, const int NboxElements) {
+
+  LIBP_ABORT("Benchmark problem " << problem << " uses over-integration, which is not available",
+             problem=="BP3" || problem=="BP4");
+  LIBP_ABORT("Unknown benchmark problem " << problem,
+             problem!="BP1" && problem!="BP2" && problem!="BP5" && problem!="BP6"
+             && problem!="IPDG" && problem!="PCG");
+
+  LIBP_ABORT("Benchmarks need a BOX mesh",
+             !meshSettings.compareSetting("MESH FILE", "BOX"));
+
+  meshSettings.changeSetting("POLYNOMIAL DEGREE", std::to_string(N));
+  meshSettings.changeSetting("BOX NX", std::to_string(NboxElements));
+  meshSettings.changeSetting("BOX NY", std::to_string(NboxElements));
+  meshSettings.changeSetting("BOX NZ", std::to_string(NboxElements));
+
+  comm_t comm = platform.comm;
+  mesh_t mesh(platform, meshSettings, comm);
+
+  int Nreps = 50;
+  settings.getSetting("BENCHMARK REPETITIONS", Nreps);
+
+  benchmarkResult_t result;
+  result.problem = problem;
+  result.elementType = ElementName(mesh);
+  result.N = N;
+  result.ranks = comm.size();
+  result.Nelements = mesh.NelementsGlobal;
+  result.iterations = 0;
+
+  if (problem=="BP1" || problem=="BP2") {
+    RunMass(platform, mesh, (problem=="BP1") ? 1 : 3, Nreps, result);
+    return result;
+  }
+
+  //the operator problems skip the preconditioner setup
+  benchmarkSettings_t ellipticSettings = settings;
+  ellipticSettings.changeSetting("DISCRETIZATION", (problem=="IPDG") ? "IPDG" : "CONTINUOUS");
+  if (problem!="PCG")
+    ellipticSettings.changeSetting("PRECONDITIONER", "NONE");
+
+  dfloat lambda = 0.0;
+  settings.getSetting("LAMBDA", lambda);
+
+  // Boundary Type translation. Just defaults.
+  int NBCTypes = 3;
+  memory<int> BCType(3);
+  BCType[0] = 0;
+  BCType[1] = 1;
+  BCType[2] = 2;
+
+  elliptic_t elliptic(platform, mesh, ellipticSettings,
+                      lambda, NBCTypes, BCType);
+
+  if (problem=="PCG") {
+    RunSolve(platform, elliptic, ellipticSettings, result);
+  } else {
+    RunStiffness(platform, elliptic, (problem=="BP6") ? 3 : 1, Nreps, result);
+  }
+
+  return result;
+}
@@ -0,0 +1,101 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "benchmark.hpp"
+
+//settings for the benchmark driver
+benchmarkSettings_t::benchmarkSettings_t(const comm_t& _comm):
+  ellipticSettings_t(_comm) {
+
+  newSetting("LAMBDA",
+             "0.0",
+             "Coefficient in Screened Poisson Equation (zero in the CEED bake-off problems)");
+
+  newSetting("BENCHMARK PROBLEMS",
+             "BP1,BP2,BP5,BP6,IPDG,PCG",
+             "Problems to run: BP1/BP2 scalar/vector mass matrix, BP5/BP6 scalar/vector C0 stiffness, IPDG stiffness, PCG solve of BP5");
+
+  newSetting("BENCHMARK DEGREES",
+             "1,2,3,4,5,6,7,8",
+             "Polynomial degrees to sweep");
+
+  newSetting("BENCHMARK BOX SIZES",
+             "4,8,16",
+             "BOX elements per rank in each dimension to sweep");
+
+  newSetting("BENCHMARK REPETITIONS",
+             "50",
+             "Timed operator applications per point");
+
+  newSetting("BENCHMARK MAX ITERATIONS",
+             "100",
+             "Iteration limit of the PCG problem");
+
+  newSetting("BENCHMARK TOLERANCE",
+             "1.0e-8",
+             "Stopping tolerance of the PCG problem");
+
+  newSetting("BENCHMARK OUTPUT FILE",
+             "benchmark",
+             "Results are written to <name>.csv and <name>.json");
+}
+
+void benchmarkSettings_t::report() {
+
+  if (comm.rank()==0) {
+    std::cout << "Benchmark Settings:\n\n";
+    reportSetting("LAMBDA");
+    reportSetting("BENCHMARK PROBLEMS");
+    reportSetting("BENCHMARK DEGREES");
+    reportSetting("BENCHMARK BOX SIZES");
+    reportSetting("BENCHMARK REPETITIONS");
+
+    if (compareSetting("BENCHMARK PROBLEMS","PCG")) {
+      reportSetting("LINEAR SOLVER");
+      reportSetting("PRECONDITIONER");
+      reportSetting("BENCHMARK MAX ITERATIONS");
+      reportSetting("BENCHMARK TOLERANCE");
+    }
+
+    reportSetting("BENCHMARK OUTPUT FILE");
+  }
+}
+
+std::vector<std::string> BenchmarkList(const std::string list) {
+  std::vector<std::string> entries;
+  std::string entry;
+  for (const char c : list) {
+    if (c==',' || c==' ' || c=='\t') {
+      if (entry.size()) entries.push_back(entry);
+      entry.clear();
+    } else {
+      entry += c;
+    }
+  }
+  if (entry.size()) entries.push_back(entry);
+  return entries;
+}
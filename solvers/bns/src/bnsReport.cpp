@@ -27,20 +27,20 @@ SOFTWARE.
 #include "bns.hpp"
 
 void bns_t::Report(dfloat time, int tstep){
+  LIBP_PROFILE("Report");
 
   static int frame=0;
 
-  //compute vorticity
-  vorticityKernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D, o_q, c, o_Vort);
-
   //compute q.M*q
   mesh.MassMatrixApply(o_q, o_Mq);
 
   dlong Nentries = mesh.Nelements*mesh.Np*Nfields;
-  dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
-  if(mesh.rank==0)
-    printf("%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
+  //the norm's reduction completes behind the output work below
+  linAlgReduction_t normReduction = platform.linAlg().innerProdAsync(Nentries, o_q, o_Mq, mesh.comm);
+
+  //compute vorticity
+  vorticityKernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D, o_q, c, o_Vort);
 
   if (settings.compareSetting("OUTPUT TO FILE","TRUE")) {
 
@@ -57,6 +57,11 @@ void bns_t::Report(dfloat time, int tstep){
     PlotFields(q, Vort, std::string(fname));
   }
 
+  dfloat norm2 = sqrt(normReduction.Wait());
+
+  if(mesh.rank==0)
+    printf("%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
+
   /*
   if(bns->dim==3){
     if(options.compareArgs("OUTPUT FILE FORMAT","ISO")){
@@ -80,6 +80,11 @@ bnsSettings_t::bnsSettings_t(comm_t& _comm):
              "10",
              "End time for time integration");
 
+  newSetting("HALO PRECISION",
+             "DOUBLE",
+             "Precision of the trace halo MPI payloads",
+             {"DOUBLE", "FLOAT", "FLOAT-COMPENSATED"});
+
   newSetting("OUTPUT INTERVAL",
              ".1",
              "Time between printing output data");
@@ -108,6 +113,7 @@ void bnsSettings_t::report() {
     reportSetting("TIME INTEGRATOR");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
+    reportSetting("HALO PRECISION");
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
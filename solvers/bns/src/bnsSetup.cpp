@@ -111,6 +111,15 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
     mesh.MultiRateSetup(EtoDT);
     mesh.MultiRatePmlSetup();
     multirateTraceHalo = mesh.MultiRateHaloTraceSetup(Nfields);
+
+    for (int lev=0;lev<mesh.mrNlevels;lev++) {
+      //FLOAT-COMPENSATED contains FLOAT, so test it first
+      if (settings.compareSetting("HALO PRECISION","FLOAT-COMPENSATED")) {
+        multirateTraceHalo[lev].SetPrecision(ogs::SingleCompensated);
+      } else if (settings.compareSetting("HALO PRECISION","FLOAT")) {
+        multirateTraceHalo[lev].SetPrecision(ogs::Single);
+      }
+    }
   }
 
   if (settings.compareSetting("TIME INTEGRATOR","MRAB3")){
@@ -163,6 +172,13 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   /*setup trace halo exchange */
   traceHalo = mesh.HaloTraceSetup(Nfields);
 
+  //FLOAT-COMPENSATED contains FLOAT, so test it first
+  if (settings.compareSetting("HALO PRECISION","FLOAT-COMPENSATED")) {
+    traceHalo.SetPrecision(ogs::SingleCompensated);
+  } else if (settings.compareSetting("HALO PRECISION","FLOAT")) {
+    traceHalo.SetPrecision(ogs::Single);
+  }
+
   // compute samples of q at interpolation nodes
   q.malloc(Nlocal+Nhalo, 0.0);
   o_q = platform.malloc<dfloat>(q);
@@ -216,11 +232,24 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   std::string fileName, kernelName;
 
+  //scratch rhs and time for timing the tuned kernels
+  deviceMemory<dfloat> o_tuneRHS = platform.malloc<dfloat>(Nlocal);
+  const dfloat tuneT = 0.0;
+
   // kernels from volume file
   fileName   = oklFilePrefix + "bnsVolume" + suffix + oklFileSuffix;
   kernelName = "bnsVolume" + suffix;
-  volumeKernel =  platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+
+  tuningSpace_t volumeSpace;
+  volumeSpace.addBlockDefine("p_NblockV", NblockV, mesh.Np);
+
+  volumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, volumeSpace,
+    [&](kernel_t& kernel) {
+      if (mesh.NnonPmlElements)
+        kernel(mesh.NnonPmlElements, mesh.o_nonPmlElements,
+               mesh.o_vgeo, mesh.o_D, mesh.o_x, mesh.o_y, mesh.o_z,
+               tuneT, c, nu, o_q, o_tuneRHS);
+    }, o_tuneRHS);
 
   if (pmlcubature) {
     kernelName = "bnsPmlVolumeCub" + suffix;
@@ -260,8 +289,17 @@ void bns_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                            kernelInfo);
   } else {
     kernelName = "bnsSurface" + suffix;
-    surfaceKernel = platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+
+    tuningSpace_t surfaceSpace;
+    surfaceSpace.addBlockDefine("p_NblockS", NblockS, maxNodes);
+
+    surfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, surfaceSpace,
+      [&](kernel_t& kernel) {
+        if (mesh.NnonPmlElements)
+          kernel(mesh.NnonPmlElements, mesh.o_nonPmlElements,
+                 mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM, mesh.o_vmapP, mesh.o_EToB,
+                 mesh.o_x, mesh.o_y, mesh.o_z, tuneT, c, nu, o_q, o_tuneRHS);
+      }, o_tuneRHS);
 
     kernelName = "bnsPmlSurface" + suffix;
     pmlSurfaceKernel = platform.buildKernel(fileName, kernelName,
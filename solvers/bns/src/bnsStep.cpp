@@ -34,6 +34,7 @@ dfloat bns_t::MaxWaveSpeed(){
 //evaluate ODE rhs = f(q,t)
 void bns_t::rhsf_pml(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_pmlQ,
                      deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_pmlRHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
 
   // extract q trace halo and start exchange
   traceHalo.ExchangeStart(o_Q, 1);
@@ -62,6 +63,7 @@ void bns_t::rhsf_pml(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_pmlQ,
 void bns_t::rhsf_MR_pml(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_pmlQ,
                         deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_pmlRHS,
                         deviceMemory<dfloat>& o_fQM, const dfloat T, const int lev){
+  LIBP_PROFILE("rhsf");
 
   // extract q trace halo and start exchange
   multirateTraceHalo[lev].ExchangeStart(o_fQM, 1);
@@ -69,6 +69,11 @@ cnsSettings_t::cnsSettings_t(comm_t _comm):
              "10",
              "End time for time integration");
 
+  newSetting("HALO PRECISION",
+             "DOUBLE",
+             "Precision of the trace halo MPI payloads",
+             {"DOUBLE", "FLOAT", "FLOAT-COMPENSATED"});
+
   newSetting("OUTPUT INTERVAL",
              ".1",
              "Time between printing output data");
@@ -95,6 +100,7 @@ void cnsSettings_t::report() {
     reportSetting("TIME INTEGRATOR");
     reportSetting("START TIME");
     reportSetting("FINAL TIME");
+    reportSetting("HALO PRECISION");
     reportSetting("OUTPUT INTERVAL");
     reportSetting("OUTPUT TO FILE");
     reportSetting("OUTPUT FILE NAME");
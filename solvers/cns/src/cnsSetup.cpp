@@ -80,7 +80,16 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   /*setup trace halo exchange */
   fieldTraceHalo = mesh.HaloTraceSetup(Nfields);
-  gradTraceHalo  = mesh.HaloTraceSetup(Ngrads);
+  gradTraceHalo  = mesh.HaloTraceSetup(Ngrads, {1});
+
+  //FLOAT-COMPENSATED contains FLOAT, so test it first
+  if (settings.compareSetting("HALO PRECISION","FLOAT-COMPENSATED")) {
+    fieldTraceHalo.SetPrecision(ogs::SingleCompensated);
+    gradTraceHalo.SetPrecision(ogs::SingleCompensated);
+  } else if (settings.compareSetting("HALO PRECISION","FLOAT")) {
+    fieldTraceHalo.SetPrecision(ogs::Single);
+    gradTraceHalo.SetPrecision(ogs::Single);
+  }
 
   // compute samples of q at interpolation nodes
   q.malloc(NlocalFields+NhaloFields);
@@ -148,6 +157,25 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   std::string fileName, kernelName;
 
+  //scratch rhs and time for timing the tuned kernels
+  deviceMemory<dfloat> o_tuneRHS = platform.malloc<dfloat>(NlocalFields);
+  const dfloat tuneT = 0.0;
+
+  tuningSpace_t volumeSpace, surfaceSpace;
+  volumeSpace.addBlockDefine("p_NblockV", NblockV, mesh.Np);
+  surfaceSpace.addBlockDefine("p_NblockS", NblockS, maxNodes);
+
+  auto volumeLaunch = [&](kernel_t& kernel) {
+    kernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D,
+           mesh.o_x, mesh.o_y, mesh.o_z, tuneT, mu, gamma,
+           o_q, o_gradq, o_tuneRHS);
+  };
+  auto surfaceLaunch = [&](kernel_t& kernel) {
+    kernel(mesh.Nelements, mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM,
+           mesh.o_vmapP, mesh.o_EToB, mesh.o_x, mesh.o_y, mesh.o_z,
+           tuneT, mu, gamma, o_q, o_gradq, o_tuneRHS);
+  };
+
   if (isothermal) {
     if (cubature) {
       // kernels from volume file
@@ -167,14 +195,14 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
       fileName   = oklFilePrefix + "cnsIsothermalVolume" + suffix + oklFileSuffix;
       kernelName = "cnsIsothermalVolume" + suffix;
 
-      volumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      volumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo,
+                                         volumeSpace, volumeLaunch, o_tuneRHS);
       // kernels from surface file
       fileName   = oklFilePrefix + "cnsIsothermalSurface" + suffix + oklFileSuffix;
       kernelName = "cnsIsothermalSurface" + suffix;
 
-      surfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      surfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo,
+                                          surfaceSpace, surfaceLaunch, o_tuneRHS);
     }
   } else {
     if (cubature) {
@@ -195,14 +223,14 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
       fileName   = oklFilePrefix + "cnsVolume" + suffix + oklFileSuffix;
       kernelName = "cnsVolume" + suffix;
 
-      volumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      volumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo,
+                                         volumeSpace, volumeLaunch, o_tuneRHS);
       // kernels from surface file
       fileName   = oklFilePrefix + "cnsSurface" + suffix + oklFileSuffix;
       kernelName = "cnsSurface" + suffix;
 
-      surfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      surfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo,
+                                          surfaceSpace, surfaceLaunch, o_tuneRHS);
     }
   }
 
@@ -210,14 +238,20 @@ void cns_t::Setup(platform_t& _platform, mesh_t& _mesh,
   fileName   = oklFilePrefix + "cnsGradVolume" + suffix + oklFileSuffix;
   kernelName = "cnsGradVolume" + suffix;
 
-  gradVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+  gradVolumeKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, volumeSpace,
+    [&](kernel_t& kernel) {
+      kernel(mesh.Nelements, mesh.o_vgeo, mesh.o_D, o_q, o_gradq);
+    }, o_gradq);
   // kernels from surface file
   fileName   = oklFilePrefix + "cnsGradSurface" + suffix + oklFileSuffix;
   kernelName = "cnsGradSurface" + suffix;
 
-  gradSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+  gradSurfaceKernel = platform.tuneKernel(fileName, kernelName, kernelInfo, surfaceSpace,
+    [&](kernel_t& kernel) {
+      kernel(mesh.Nelements, mesh.o_sgeo, mesh.o_LIFT, mesh.o_vmapM,
+             mesh.o_vmapP, mesh.o_EToB, mesh.o_x, mesh.o_y, mesh.o_z,
+             tuneT, mu, gamma, o_q, o_gradq);
+    }, o_gradq);
 
   // vorticity calculation
   fileName   = oklFilePrefix + "cnsVorticity" + suffix + oklFileSuffix;
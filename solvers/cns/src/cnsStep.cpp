@@ -52,6 +52,7 @@ dfloat cns_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
 
 //evaluate ODE rhs = f(q,t)
 void cns_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
 
   // extract q trace halo and start exchange
   fieldTraceHalo.ExchangeStart(o_Q, 1);
@@ -106,6 +106,11 @@ public:
   kernel_t partialGradientKernel;
   kernel_t partialIpdgKernel;
 
+  //kernels used by the standalone Run
+  kernel_t forcingKernel;
+  kernel_t rhsBCKernel;
+  kernel_t addBCKernel;
+
   elliptic_t() = default;
   elliptic_t(platform_t &_platform, mesh_t &_mesh,
               settings_t& _settings, dfloat _lambda,
@@ -120,8 +125,14 @@ public:
 
   void BoundarySetup();
 
+  kernel_t BuildPartialAxKernel(const std::string fileName,
+                                const std::string kernelName,
+                                properties_t& kernelInfo);
+
   void Run();
 
+  void RunSetup(linearSolver_t& linearSolver);
+
   int Solve(linearSolver_t& linearSolver, deviceMemory<dfloat> &o_x, deviceMemory<dfloat> &o_r,
             const dfloat tol, const int MAXIT, const int verbose);
 
@@ -28,6 +28,7 @@ SOFTWARE.
 
 // interpolate data to plot nodes and save to file (one per process
 void elliptic_t::PlotFields(memory<dfloat>& Q, std::string fileName){
+  LIBP_PROFILE("I/O");
 
   FILE *fp;
 
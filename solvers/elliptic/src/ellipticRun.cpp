@@ -27,21 +27,17 @@ SOFTWARE.
 #include "elliptic.hpp"
 #include "timer.hpp"
 
-void elliptic_t::Run(){
+/*Set up the linear solver and build the kernels used by Run*/
+void elliptic_t::RunSetup(linearSolver_t& linearSolver){
 
-  //setup linear solver
-  hlong NglobalDofs;
-  if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
-    NglobalDofs = ogsMasked.NgatherGlobal*Nfields;
-  } else {
-    NglobalDofs = mesh.NelementsGlobal*mesh.Np*Nfields;
-  }
-
-  linearSolver_t linearSolver;
   if (settings.compareSetting("LINEAR SOLVER","NBPCG")){
     linearSolver.Setup<LinearSolver::nbpcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","NBFPCG")){
     linearSolver.Setup<LinearSolver::nbfpcg>(Ndofs, Nhalo, platform, settings, comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","PIPEPCG")){
+    linearSolver.Setup<LinearSolver::pipepcg>(Ndofs, Nhalo, platform, settings, comm);
+  } else if (settings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+    linearSolver.Setup<LinearSolver::sstepcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PCG")){
     linearSolver.Setup<LinearSolver::pcg>(Ndofs, Nhalo, platform, settings, comm);
   } else if (settings.compareSetting("LINEAR SOLVER","PGMRES")){
@@ -89,29 +85,47 @@ void elliptic_t::Run(){
 
   std::string fileName, kernelName;
 
+  std::vector<kernelBuild_t> kernels;
+
   fileName   = oklFilePrefix + "ellipticRhs" + suffix + oklFileSuffix;
   kernelName = "ellipticRhs" + suffix;
-  kernel_t forcingKernel = platform.buildKernel(fileName, kernelName,
-                                                    kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &forcingKernel});
 
-  kernel_t rhsBCKernel, addBCKernel;
   if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     fileName   = oklFilePrefix + "ellipticRhsBCIpdg" + suffix + oklFileSuffix;
     kernelName = "ellipticRhsBCIpdg" + suffix;
 
-    rhsBCKernel = platform.buildKernel(fileName,kernelName, kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &rhsBCKernel});
   } else if (settings.compareSetting("DISCRETIZATION","CONTINUOUS")) {
     fileName   = oklFilePrefix + "ellipticRhsBC" + suffix + oklFileSuffix;
     kernelName = "ellipticRhsBC" + suffix;
 
-    rhsBCKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &rhsBCKernel});
 
     fileName   = oklFilePrefix + "ellipticAddBC" + suffix + oklFileSuffix;
     kernelName = "ellipticAddBC" + suffix;
 
-    addBCKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &addBCKernel});
+  }
+
+  platform.buildKernels(kernels);
+
+  mesh.MassMatrixKernelSetup(Nfields); // mass matrix operator
+}
+
+void elliptic_t::Run(){
+
+  hlong NglobalDofs;
+  if (settings.compareSetting("DISCRETIZATION", "CONTINUOUS")) {
+    NglobalDofs = ogsMasked.NgatherGlobal*Nfields;
+  } else {
+    NglobalDofs = mesh.NelementsGlobal*mesh.Np*Nfields;
   }
 
+  //setup linear solver and kernels
+  linearSolver_t linearSolver;
+  RunSetup(linearSolver);
+
   //create occa buffers
   dlong Nall = mesh.Np*(mesh.Nelements+mesh.totalHaloPairs);
   memory<dfloat> rL(Nall, 0.0);
@@ -133,7 +147,6 @@ void elliptic_t::Run(){
 
   //storage for M*q during reporting
   deviceMemory<dfloat> o_MxL = platform.malloc<dfloat>(xL);
-  mesh.MassMatrixKernelSetup(Nfields); // mass matrix operator
 
   //populate rhs forcing
   forcingKernel(mesh.Nelements,
@@ -64,7 +64,20 @@ void ellipticAddSettings(settings_t& settings,
   settings.newSetting(prefix+"LINEAR SOLVER",
                       "PCG",
                       "Iterative Linear Solver to use for solve",
-                      {"PCG", "FPCG", "NBPCG", "NBFPCG", "PGMRES", "PMINRES"});
+                      {"PCG", "FPCG", "NBPCG", "NBFPCG", "PIPEPCG", "SSTEPCG", "PGMRES", "PMINRES"});
+
+  settings.newSetting(prefix+"PIPEPCG RESIDUAL REPLACEMENT",
+                      "0",
+                      "Iterations between recomputing the true residual in PIPEPCG (0 to never recompute)");
+
+  settings.newSetting(prefix+"SSTEPCG STEPS",
+                      "4",
+                      "CG iterations per global reduction in SSTEPCG");
+
+  settings.newSetting(prefix+"SSTEPCG BASIS",
+                      "CHEBYSHEV",
+                      "Krylov basis polynomials in SSTEPCG",
+                      {"CHEBYSHEV", "MONOMIAL"});
 
   settings.newSetting(prefix+"LINEAR SOLVER STOPPING CRITERION",
                       "ABS/REL-INITRESID",
@@ -91,6 +104,16 @@ void ellipticAddSettings(settings_t& settings,
                       "2",
                       "Smoothing iterations in Chebyshev smoother");
 
+  settings.newSetting(prefix+"AX KERNEL TUNING",
+                      "FALSE",
+                      "Search the Ax kernel's blocking parameters, or its variant for Hex, at setup (needs KERNEL TUNING)",
+                      {"TRUE", "FALSE"});
+
+  settings.newSetting(prefix+"AX KERNEL VARIANT",
+                      "0",
+                      "Variant of the Hex Ax kernel to build, and the reference for AX KERNEL TUNING (see ellipticAxHex3D.okl)",
+                      {"0", "1", "3", "4", "5", "6"});
+
   settings.newSetting(prefix+"VERBOSE",
                       "FALSE",
                       "Enable verbose output",
@@ -106,7 +129,18 @@ void ellipticSettings_t::report() {
     reportSetting("LAMBDA");
     reportSetting("DISCRETIZATION");
     reportSetting("LINEAR SOLVER");
+    if (compareSetting("LINEAR SOLVER","PIPEPCG"))
+      reportSetting("PIPEPCG RESIDUAL REPLACEMENT");
+    if (compareSetting("LINEAR SOLVER","SSTEPCG")) {
+      reportSetting("SSTEPCG STEPS");
+      reportSetting("SSTEPCG BASIS");
+    }
     reportSetting("PRECONDITIONER");
+    if (compareSetting("DISCRETIZATION","CONTINUOUS")) {
+      reportSetting("AX KERNEL TUNING");
+      if (compareSetting("ELEMENT TYPE","12"))
+        reportSetting("AX KERNEL VARIANT");
+    }
 
     if (compareSetting("PRECONDITIONER","MULTIGRID")) {
       reportSetting("MULTIGRID COARSENING");
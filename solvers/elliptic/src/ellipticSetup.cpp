@@ -52,8 +52,10 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
                                 "adx", "adxpy", "zadxpy",
                                 "innerProd", "norm2"});
 
-  /*setup trace halo exchange */
-  traceHalo = mesh.HaloTraceSetup(Nfields);
+  /*setup trace halo exchange. IPDG exchanges the 4-field gradient, so
+    tune for it there */
+  traceHalo = disc_ipdg ? mesh.HaloTraceSetup(Nfields, {4})
+                        : mesh.HaloTraceSetup(Nfields);
 
   // Boundary Type translation. Just defaults.
   NBCTypes = _NBCTypes;
@@ -136,7 +138,7 @@ void elliptic_t::Setup(platform_t& _platform, mesh_t& _mesh,
       kernelName = "ellipticPartialAx" + suffix;
     }
 
-    partialAxKernel = platform.buildKernel(fileName, kernelName,
+    partialAxKernel = BuildPartialAxKernel(fileName, kernelName,
                                            kernelInfo);
 
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
@@ -38,7 +38,8 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
   elliptic.mesh = meshC;
 
   /*setup trace halo exchange */
-  elliptic.traceHalo = meshC.HaloTraceSetup(Nfields);
+  elliptic.traceHalo = disc_ipdg ? meshC.HaloTraceSetup(Nfields, {4})
+                                 : meshC.HaloTraceSetup(Nfields);
 
   //setup boundary flags and make mask and masked ogs
   elliptic.BoundarySetup();
@@ -110,8 +111,8 @@ elliptic_t elliptic_t::SetupNewDegree(mesh_t& meshC){
       kernelName = "ellipticPartialAx" + suffix;
     }
 
-    elliptic.partialAxKernel = platform.buildKernel(fileName, kernelName,
-                                            kernelInfo);
+    elliptic.partialAxKernel = elliptic.BuildPartialAxKernel(fileName, kernelName,
+                                                             kernelInfo);
 
   } else if (settings.compareSetting("DISCRETIZATION","IPDG")) {
     int Nmax = std::max(meshC.Np, meshC.Nfaces*meshC.Nfp);
@@ -50,7 +50,8 @@ elliptic_t elliptic_t::SetupRingPatch(mesh_t& meshPatch){
   }
 
   /*setup trace halo exchange */
-  elliptic.traceHalo = meshPatch.HaloTraceSetup(Nfields);
+  elliptic.traceHalo = disc_ipdg ? meshPatch.HaloTraceSetup(Nfields, {4})
+                                 : meshPatch.HaloTraceSetup(Nfields);
 
   //setup boundary flags and make mask and masked ogs
   elliptic.BoundarySetup();
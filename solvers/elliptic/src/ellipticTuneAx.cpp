@@ -0,0 +1,127 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+
+#include "elliptic.hpp"
+
+/*Build the partial Ax kernel, searching its blocking defines with
+  platform_t::tuneKernel. Candidates are timed on this level's mesh.*/
+kernel_t elliptic_t::BuildPartialAxKernel(const std::string fileName,
+                                          const std::string kernelName,
+                                          properties_t& kernelInfo) {
+
+  constexpr int maxThreadsPerBlock = 1024;
+  constexpr int maxSharedBytes = 48*1024;
+
+  const int Np = mesh.Np;
+  const int Nggeo = mesh.Nggeo;
+
+  tuningSpace_t space;
+  const bool tune = settings.compareSetting("AX KERNEL TUNING", "TRUE");
+
+  if (kernelName=="ellipticPartialAxTri2D" ||
+      kernelName=="ellipticPartialAxTri3D") {
+    //elements per thread block
+    const int NblockV = kernelInfo.get<int>("defines/p_NblockV", 1);
+    if (tune)
+      space.addBlockDefine("p_NblockV", NblockV, Np, maxThreadsPerBlock);
+    else
+      space.addDefine("p_NblockV", {NblockV});
+
+  } else if (kernelName=="ellipticPartialAxTet3D") {
+    //outputs per thread, and elements per thread block. The defaults
+    // follow the table in the kernel source
+    const int N = mesh.N;
+    const int defaultNe = (N==1) ? 2 : (N<=5) ? 3 : 4;
+    const int defaultNb = (N==1) ? 8 : (N<=3) ? 3 : (N<=5) ? 5 : (N==6) ? 6 : 2;
+
+    std::vector<int> Ne = {defaultNe};
+    std::vector<int> Nb = {defaultNb};
+    if (tune) {
+      Ne.insert(Ne.end(), {1, 2, 3, 4});
+      Nb.insert(Nb.end(), {1, 2, 4, 8});
+    }
+    space.addDefine("p_Ne", Ne);
+    space.addDefine("p_Nb", Nb);
+    space.addConstraint([=](const tuningSpace_t::point_t& p) {
+      const int ne = p.at("p_Ne"), nb = p.at("p_Nb");
+      return nb*Np<=maxThreadsPerBlock
+          && ne*nb*(Np+Nggeo+1)*sizeof(dfloat)<=maxSharedBytes;
+    });
+  } else if (kernelName=="ellipticPartialAxHex3D") {
+    //kernel variant, see ellipticAxHex3D.okl. v2 is not a complete
+    // operator. v4-v6 use an Nq^3 thread block
+    const int Nq = mesh.Nq;
+    auto fits = [=](const int v) {
+      if (v<4) return true;
+      const int Nshared = ((v==6) ? 4 : 3)*Np + Nq*Nq;
+      return Np<=maxThreadsPerBlock
+          && Nshared*sizeof(dfloat)<=maxSharedBytes;
+    };
+
+    int defaultVariant = 0;
+    settings.getSetting("AX KERNEL VARIANT", defaultVariant);
+    LIBP_ABORT("AX KERNEL VARIANT " << defaultVariant
+               << " does not fit a thread block at degree " << mesh.N,
+               !fits(defaultVariant));
+
+    std::vector<int> variant = {defaultVariant};
+    if (tune) {
+      for (int v : {0, 1, 3, 4, 5, 6})
+        if (v!=defaultVariant) variant.push_back(v);
+    }
+    space.addDefine("p_AxVariant", variant);
+    space.addConstraint([=](const tuningSpace_t::point_t& p) {
+      return fits(p.at("p_AxVariant"));
+    });
+  }
+  //the Quad kernel has a single variant with the current argument list
+
+  //apply the operator to every element, reading a masked global vector
+  memory<dlong> elementList(mesh.Nelements);
+  for (dlong e=0;e<mesh.Nelements;e++) elementList[e] = e;
+  deviceMemory<dlong> o_elementList = platform.malloc<dlong>(elementList);
+
+  memory<dfloat> q(ogsMasked.Ngather+gHalo.Nhalo, 1.0);
+  deviceMemory<dfloat> o_q  = platform.malloc<dfloat>(q);
+  deviceMemory<dfloat> o_Aq = platform.malloc<dfloat>(mesh.Nelements*Np);
+
+  kernel_t kernel = platform.tuneKernel(fileName, kernelName, kernelInfo, space,
+    [&](kernel_t& candidate) {
+      if (mesh.Nelements)
+        candidate(mesh.Nelements, o_elementList, o_GlobalToLocal,
+                  mesh.o_wJ, mesh.o_ggeo, mesh.o_D, mesh.o_S, mesh.o_MM,
+                  lambda, o_q, o_Aq);
+    }, o_Aq);
+
+  //modelled bytes and flops per element of the Hex3D kernel, for
+  // "KERNEL STATS"
+  if(kernelName=="ellipticPartialAxHex3D")
+    kernel.setModel((Nggeo+2)*Np*sizeof(dfloat) + (Np+1)*sizeof(dlong),
+                    (12*mesh.Nq+15)*Np);
+
+  return kernel;
+}
@@ -52,7 +52,7 @@ public:
 
 class fpe_t;
 
-class subcycler_t: public solver_t {
+class fpeSubcycler_t: public solver_t {
 public:
   mesh_t mesh;
 
@@ -61,7 +61,7 @@ public:
   kernel_t advectionVolumeKernel;
   kernel_t advectionSurfaceKernel;
 
-  subcycler_t() = default;
+  fpeSubcycler_t() = default;
 
   void Report(dfloat time, int tstep){};
 
@@ -97,7 +97,7 @@ public:
   //subcycling
   int Nsubcycles;
   timeStepper_t subStepper;
-  subcycler_t subcycler;
+  fpeSubcycler_t subcycler;
 
   kernel_t advectionVolumeKernel;
   kernel_t advectionSurfaceKernel;
@@ -113,6 +113,12 @@ void fpe_t::Setup(platform_t& _platform, mesh_t& _mesh,
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","NBFPCG")){
       linearSolver.Setup<LinearSolver::nbfpcg>(elliptic.Ndofs, elliptic.Nhalo,
                                               platform, ellipticSettings, comm);
+    } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PIPEPCG")){
+      linearSolver.Setup<LinearSolver::pipepcg>(elliptic.Ndofs, elliptic.Nhalo,
+                                              platform, ellipticSettings, comm);
+    } else if (ellipticSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+      linearSolver.Setup<LinearSolver::sstepcg>(elliptic.Ndofs, elliptic.Nhalo,
+                                              platform, ellipticSettings, comm);
     } else if (ellipticSettings.compareSetting("LINEAR SOLVER","PCG")){
       linearSolver.Setup<LinearSolver::pcg>(elliptic.Ndofs, elliptic.Nhalo,
                                               platform, ellipticSettings, comm);
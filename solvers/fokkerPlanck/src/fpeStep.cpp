@@ -50,12 +50,16 @@ dfloat fpe_t::MaxWaveSpeed(deviceMemory<dfloat>& o_Q, const dfloat T){
 
 //evaluate ODE rhs = f(q,t)
 void fpe_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
+
   Advection(o_Q, o_RHS, T);
   Diffusion(o_Q, o_RHS, T);
 }
 
 // Evaluation of rhs f function
 void fpe_t::rhs_imex_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
+
   Advection(o_Q, o_RHS, T);
 }
 
@@ -103,6 +107,7 @@ void fpe_t::rhs_imex_invg(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_Q
 void fpe_t::rhs_subcycle_f(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_QHAT,
                            const dfloat T, const dfloat dt, const memory<dfloat> B,
                            const int order, const int shiftIndex, const int maxOrder) {
+  LIBP_PROFILE("rhsf");
 
   //subcycle each Lagrangian state qhat by stepping dqhat/dt = F(qhat,t)
 
@@ -27,7 +27,7 @@ SOFTWARE.
 #include "fpe.hpp"
 
 //evaluate ODE rhs = f(q,t)
-void subcycler_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+void fpeSubcycler_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
   // extract q halo on DEVICE
   traceHalo.ExchangeStart(o_Q, 1);
 
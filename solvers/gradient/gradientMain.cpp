@@ -60,6 +60,10 @@ int main(int argc, char **argv){
 
     // run
     gradient.Run();
+
+    //report the ogs counters, memory pools, kernel stats and profiled
+    // regions, if enabled
+    platform.Report();
   }
 
   // close down MPI
@@ -28,6 +28,7 @@ SOFTWARE.
 
 // interpolate data to plot nodes and save to file (one per process
 void gradient_t::PlotFields(){
+  LIBP_PROFILE("I/O");
 
   FILE *fp;
 
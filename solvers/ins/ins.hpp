@@ -54,7 +54,7 @@ public:
 
 class ins_t;
 
-class subcycler_t: public solver_t {
+class insSubcycler_t: public solver_t {
 public:
   mesh_t mesh;
 
@@ -71,7 +71,7 @@ public:
 
   deviceMemory<dfloat> o_Ue, o_Uh;
 
-  subcycler_t() = default;
+  insSubcycler_t() = default;
 
   void Report(dfloat time, int tstep){};
 
@@ -128,7 +128,7 @@ public:
   //subcycling
   int Nsubcycles;
   timeStepper_t subStepper;
-  subcycler_t subcycler;
+  insSubcycler_t subcycler;
 
   kernel_t advectionVolumeKernel;
   kernel_t advectionSurfaceKernel;
@@ -59,6 +59,10 @@ int main(int argc, char **argv){
 
     // run
     ins.Run();
+
+    //report the ogs counters, memory pools, kernel stats and profiled
+    // regions, if enabled
+    platform.Report();
   }
 
   // close down MPI
@@ -27,6 +27,7 @@ SOFTWARE.
 #include "ins.hpp"
 
 void ins_t::Report(dfloat time, int tstep){
+  LIBP_PROFILE("Report");
 
   static int frame=0;
 
@@ -34,10 +35,9 @@ void ins_t::Report(dfloat time, int tstep){
   mesh.MassMatrixApply(o_u, o_MU);
 
   dlong Nentries = mesh.Nelements*mesh.Np*NVfields;
-  dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_u, o_MU, mesh.comm));
 
-  if(mesh.rank==0)
-    printf("\n%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
+  //the norm's reduction completes behind the output work below
+  linAlgReduction_t normReduction = platform.linAlg().innerProdAsync(Nentries, o_u, o_MU, mesh.comm);
 
   if (settings.compareSetting("OUTPUT TO FILE","TRUE")) {
     //compute vorticity
@@ -56,4 +56,9 @@ void ins_t::Report(dfloat time, int tstep){
 
     PlotFields(u, p, Vort, std::string(fname));
   }
+
+  dfloat norm2 = sqrt(normReduction.Wait());
+
+  if(mesh.rank==0)
+    printf("\n%5.2f (%d), %5.2f (time, timestep, norm)\n", time, tstep, norm2);
 }
@@ -157,6 +157,20 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       if (mesh.dim==3)
         wLinearSolver.Setup<LinearSolver::nbfpcg>(wNlocal, wNhalo, platform, vSettings, comm);
 
+    } else if (vSettings.compareSetting("LINEAR SOLVER","PIPEPCG")){
+
+      uLinearSolver.Setup<LinearSolver::pipepcg>(uNlocal, uNhalo, platform, vSettings, comm);
+      vLinearSolver.Setup<LinearSolver::pipepcg>(vNlocal, vNhalo, platform, vSettings, comm);
+      if (mesh.dim==3)
+        wLinearSolver.Setup<LinearSolver::pipepcg>(wNlocal, wNhalo, platform, vSettings, comm);
+
+    } else if (vSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+
+      uLinearSolver.Setup<LinearSolver::sstepcg>(uNlocal, uNhalo, platform, vSettings, comm);
+      vLinearSolver.Setup<LinearSolver::sstepcg>(vNlocal, vNhalo, platform, vSettings, comm);
+      if (mesh.dim==3)
+        wLinearSolver.Setup<LinearSolver::sstepcg>(wNlocal, wNhalo, platform, vSettings, comm);
+
     } else if (vSettings.compareSetting("LINEAR SOLVER","PCG")){
 
       uLinearSolver.Setup<LinearSolver::pcg>(uNlocal, uNhalo, platform, vSettings, comm);
@@ -262,6 +276,10 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       pLinearSolver.Setup<LinearSolver::nbpcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","NBFPCG")){
       pLinearSolver.Setup<LinearSolver::nbfpcg>(pNlocal, pNhalo, platform, pSettings, comm);
+    } else if (pSettings.compareSetting("LINEAR SOLVER","PIPEPCG")){
+      pLinearSolver.Setup<LinearSolver::pipepcg>(pNlocal, pNhalo, platform, pSettings, comm);
+    } else if (pSettings.compareSetting("LINEAR SOLVER","SSTEPCG")){
+      pLinearSolver.Setup<LinearSolver::sstepcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","PCG")){
       pLinearSolver.Setup<LinearSolver::pcg>(pNlocal, pNhalo, platform, pSettings, comm);
     } else if (pSettings.compareSetting("LINEAR SOLVER","PGMRES")){
@@ -297,7 +315,7 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   /*setup trace halo exchange */
   pTraceHalo = mesh.HaloTraceSetup(1); //one field
-  vTraceHalo = mesh.HaloTraceSetup(NVfields); //one field
+  vTraceHalo = mesh.HaloTraceSetup(NVfields, {1, 4}); //velocity and its gradient
 
   // u and p at interpolation nodes
   u.malloc((Nlocal+Nhalo)*NVfields, 0.0);
@@ -412,25 +430,24 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
   std::string fileName, kernelName;
 
+  //collect the kernels and build them as one batch
+  std::vector<kernelBuild_t> kernels;
+
   // advection kernels
   if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
     //subcycle kernels
     if (cubature) {
       fileName   = oklFilePrefix + "insSubcycleCubatureAdvection" + suffix + oklFileSuffix;
       kernelName = "insSubcycleAdvectionCubatureVolume" + suffix;
-      advectionVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionVolumeKernel});
       kernelName = "insSubcycleAdvectionCubatureSurface" + suffix;
-      advectionSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionSurfaceKernel});
     } else {
       fileName   = oklFilePrefix + "insSubcycleAdvection" + suffix + oklFileSuffix;
       kernelName = "insSubcycleAdvectionVolume" + suffix;
-      advectionVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionVolumeKernel});
       kernelName = "insSubcycleAdvectionSurface" + suffix;
-      advectionSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionSurfaceKernel});
     }
 
     //build subcycler
@@ -443,8 +460,6 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
     subcycler.nu = nu;
     subcycler.cubature = cubature;
     subcycler.vTraceHalo = vTraceHalo;
-    subcycler.advectionVolumeKernel = advectionVolumeKernel;
-    subcycler.advectionSurfaceKernel = advectionSurfaceKernel;
 
     if (settings.compareSetting("SUBCYCLING TIME INTEGRATOR","AB3")){
       subStepper.Setup<TimeStepper::ab3>(mesh.Nelements,
@@ -462,8 +477,7 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
 
     fileName   = oklFilePrefix + "insSubcycleAdvection" + oklFileSuffix;
     kernelName = "insSubcycleAdvectionKernel";
-    subcycler.subCycleAdvectionKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &subcycler.subCycleAdvectionKernel});
 
     subcycler.o_Ue = platform.malloc<dfloat>(u);
 
@@ -472,19 +486,15 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
     if (cubature) {
       fileName   = oklFilePrefix + "insCubatureAdvection" + suffix + oklFileSuffix;
       kernelName = "insAdvectionCubatureVolume" + suffix;
-      advectionVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionVolumeKernel});
       kernelName = "insAdvectionCubatureSurface" + suffix;
-      advectionSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionSurfaceKernel});
     } else {
       fileName   = oklFilePrefix + "insAdvection" + suffix + oklFileSuffix;
       kernelName = "insAdvectionVolume" + suffix;
-      advectionVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionVolumeKernel});
       kernelName = "insAdvectionSurface" + suffix;
-      advectionSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                             kernelInfo);
+      kernels.push_back({fileName, kernelName, kernelInfo, &advectionSurfaceKernel});
     }
   }
 
@@ -497,42 +507,34 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       kernelName = "insVelocityRhs" + suffix;
     else
       kernelName = "insVelocityIpdgRhs" + suffix;
-    velocityRhsKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &velocityRhsKernel});
 
     kernelName = "insVelocityBC" + suffix;
-    velocityBCKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &velocityBCKernel});
   } else {
     // gradient kernel
     fileName   = oklFilePrefix + "insVelocityGradient" + suffix + oklFileSuffix;
     kernelName = "insVelocityGradient" + suffix;
-    velocityGradientKernel =  platform.buildKernel(fileName, kernelName,
-                                               kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &velocityGradientKernel});
 
     fileName   = oklFilePrefix + "insDiffusion" + suffix + oklFileSuffix;
     kernelName = "insDiffusion" + suffix;
-    diffusionKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &diffusionKernel});
   }
 
   //pressure gradient kernels
   fileName   = oklFilePrefix + "insGradient" + suffix + oklFileSuffix;
   kernelName = "insGradientVolume" + suffix;
-  gradientVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &gradientVolumeKernel});
   kernelName = "insGradientSurface" + suffix;
-  gradientSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &gradientSurfaceKernel});
 
   //velocity divergence kernels
   fileName   = oklFilePrefix + "insDivergence" + suffix + oklFileSuffix;
   kernelName = "insDivergenceVolume" + suffix;
-  divergenceVolumeKernel =  platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &divergenceVolumeKernel});
   kernelName = "insDivergenceSurface" + suffix;
-  divergenceSurfaceKernel = platform.buildKernel(fileName, kernelName,
-                                         kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &divergenceSurfaceKernel});
 
   //pressure solver kernels
   if (pressureIncrement) {
@@ -542,30 +544,25 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
       kernelName = "insPressureIncrementRhs" + suffix;
     else
       kernelName = "insPressureIncrementIpdgRhs" + suffix;
-    pressureIncrementRhsKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &pressureIncrementRhsKernel});
 
     kernelName = "insPressureIncrementBC" + suffix;
-    pressureIncrementBCKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &pressureIncrementBCKernel});
   } else {
     fileName   = oklFilePrefix + "insPressureRhs" + suffix + oklFileSuffix;
     if (pDisc_c0)
       kernelName = "insPressureRhs" + suffix;
     else
       kernelName = "insPressureIpdgRhs" + suffix;
-    pressureRhsKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &pressureRhsKernel});
 
     kernelName = "insPressureBC" + suffix;
-    pressureBCKernel =  platform.buildKernel(fileName, kernelName,
-                                           kernelInfo);
+    kernels.push_back({fileName, kernelName, kernelInfo, &pressureBCKernel});
   }
 
   fileName   = oklFilePrefix + "insVorticity" + suffix + oklFileSuffix;
   kernelName = "insVorticity" + suffix;
-  vorticityKernel =  platform.buildKernel(fileName, kernelName,
-                                            kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &vorticityKernel});
 
   if (mesh.dim==2) {
     fileName   = oklFilePrefix + "insInitialCondition2D" + oklFileSuffix;
@@ -575,11 +572,17 @@ void ins_t::Setup(platform_t& _platform, mesh_t& _mesh,
     kernelName = "insInitialCondition3D";
   }
 
-  initialConditionKernel = platform.buildKernel(fileName, kernelName,
-                                                  kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &initialConditionKernel});
 
   fileName   = oklFilePrefix + "insMaxWaveSpeed" + suffix + oklFileSuffix;
   kernelName = "insMaxWaveSpeed" + suffix;
 
-  maxWaveSpeedKernel = platform.buildKernel(fileName, kernelName, kernelInfo);
+  kernels.push_back({fileName, kernelName, kernelInfo, &maxWaveSpeedKernel});
+
+  platform.buildKernels(kernels);
+
+  if (settings.compareSetting("TIME INTEGRATOR","SSBDF3")) {
+    subcycler.advectionVolumeKernel = advectionVolumeKernel;
+    subcycler.advectionSurfaceKernel = advectionSurfaceKernel;
+  }
 }
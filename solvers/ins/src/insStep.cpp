@@ -108,6 +108,8 @@ void ins_t::rhs_imex_invg(deviceMemory<dfloat>& o_RHS, deviceMemory<dfloat>& o_U
 
 // Evaluation of rhs f function
 void ins_t::rhs_imex_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
+
   // RHS = N(U)
   Advection(1.0, o_U, 0.0, o_RHS, T);
 }
@@ -116,6 +118,7 @@ void ins_t::rhs_imex_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, c
 void ins_t::rhs_subcycle_f(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_UHAT,
                            const dfloat T, const dfloat dt, const memory<dfloat> B,
                            const int order, const int shiftIndex, const int maxOrder) {
+  LIBP_PROFILE("rhsf");
 
   //subcycle each Lagrangian state qhat by stepping dqhat/dt = F(qhat,t)
   LIBP_ABORT("Subcycling supports only order 3 interpolation for now.",
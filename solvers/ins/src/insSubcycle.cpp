@@ -27,7 +27,7 @@ SOFTWARE.
 #include "ins.hpp"
 
 //evaluate ODE rhs = f(q,t)
-void subcycler_t::rhsf(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, const dfloat T){
+void insSubcycler_t::rhsf(deviceMemory<dfloat>& o_U, deviceMemory<dfloat>& o_RHS, const dfloat T){
 
   //interpolate velocity history for advective field (halo elements first)
   if(mesh.NhaloElements)
@@ -28,6 +28,7 @@
 
 // interpolate data to plot nodes and save to file (one per process)
 void lbs_t::PlotFields(memory<dfloat>& Q, memory<dfloat>& V, std::string fileName){
+  LIBP_PROFILE("I/O");
 
   FILE *fp;
 
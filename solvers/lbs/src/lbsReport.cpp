@@ -27,6 +27,8 @@
 #include "lbs.hpp"
 
 void lbs_t::Report(dfloat time, int tstep){
+  LIBP_PROFILE("Report");
+
   static int frame=0;
   // Compute velocity and density
   momentsKernel(mesh.Nelements, o_LBM, o_q, o_U); 
@@ -38,10 +40,9 @@ void lbs_t::Report(dfloat time, int tstep){
   mesh.MassMatrixApply(o_U, o_Mq);
 
   dlong Nentries = mesh.Nelements*mesh.Np*Nmacro;
-  dfloat norm2 = sqrt(platform.linAlg().innerProd(Nentries, o_q, o_Mq, mesh.comm));
 
-  if(mesh.rank==0)
-    printf("%5.2f (%d), %5.4f (time, timestep, norm)\n", time, tstep, norm2);
+  //the norm's reduction completes behind the output work below
+  linAlgReduction_t normReduction = platform.linAlg().innerProdAsync(Nentries, o_q, o_Mq, mesh.comm);
 
   if (settings.compareSetting("OUTPUT TO FILE","TRUE")) {
 
@@ -59,4 +60,9 @@ void lbs_t::Report(dfloat time, int tstep){
     // PlotFields(o_q, Vort, fname);
     PlotFields(U, Vort, std::string(fname));
   }
+
+  dfloat norm2 = sqrt(normReduction.Wait());
+
+  if(mesh.rank==0)
+    printf("%5.2f (%d), %5.4f (time, timestep, norm)\n", time, tstep, norm2);
 }
@@ -33,6 +33,7 @@ dfloat lbs_t::MaxWaveSpeed(){
 
 //evaluate ODE rhs = f(q,t)
 void lbs_t::rhsf(deviceMemory<dfloat>& o_Q, deviceMemory<dfloat>& o_RHS, const dfloat T){
+  LIBP_PROFILE("rhsf");
 
   // extract q trace halo and start exchange
   traceHalo.ExchangeStart(o_Q, 1);
@@ -0,0 +1,154 @@
+/*
+
+The MIT License (MIT)
+
+Copyright (c) 2017-2022 Tim Warburton, Noel Chalmers, Jesse Chan, Ali Karakus
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+*/
+
+#include "acoustics.hpp"
+#include "advection.hpp"
+#include "bns.hpp"
+#include "cns.hpp"
+#include "elliptic.hpp"
+#include "fpe.hpp"
+#include "gradient.hpp"
+#include "ins.hpp"
+#include "lbs.hpp"
+
+/*Parse a solver setup file and run the solver's setup, which walks the
+  same kernel builds as a full run and leaves the compiled kernels in the
+  cache directory. Nothing is time stepped or solved.*/
+template<class solverType, class solverSettingsType>
+void WarmCache(comm_t& comm, const char* setupFile) {
+
+  //create default settings
+  platformSettings_t platformSettings(comm);
+  meshSettings_t meshSettings(comm);
+  solverSettingsType solverSettings(comm);
+
+  //load settings from file
+  solverSettings.parseFromFile(platformSettings, meshSettings,
+                               setupFile);
+
+  // set up platform
+  platform_t platform(platformSettings);
+
+  platformSettings.report();
+  meshSettings.report();
+  solverSettings.report();
+
+  // set up mesh
+  mesh_t mesh(platform, meshSettings, comm);
+
+  // set up solver, building its kernels
+  solverType solver(platform, mesh, solverSettings);
+
+  if (comm.rank()==0)
+    std::cout << "Kernel cache warmed in " << platform.getCacheDir() << std::endl;
+}
+
+/*The standalone elliptic driver builds its linear solver and forcing
+  kernels in Run, so set those up as well*/
+void WarmCacheElliptic(comm_t& comm, const char* setupFile) {
+
+  //create default settings
+  platformSettings_t platformSettings(comm);
+  meshSettings_t meshSettings(comm);
+  ellipticSettings_t ellipticSettings(comm);
+  ellipticAddRunSettings(ellipticSettings);
+
+  //load settings from file
+  ellipticSettings.parseFromFile(platformSettings, meshSettings,
+                                 setupFile);
+
+  // set up platform
+  platform_t platform(platformSettings);
+
+  platformSettings.report();
+  meshSettings.report();
+  ellipticSettings.report();
+
+  // set up mesh
+  mesh_t mesh(platform, meshSettings, comm);
+
+  dfloat lambda = 0.0;
+  ellipticSettings.getSetting("LAMBDA", lambda);
+
+  // Boundary Type translation. Just defaults.
+  int NBCTypes = 3;
+  memory<int> BCType(3);
+  BCType[0] = 0;
+  BCType[1] = 1;
+  BCType[2] = 2;
+
+  // set up elliptic solver
+  elliptic_t elliptic(platform, mesh, ellipticSettings,
+                      lambda, NBCTypes, BCType);
+
+  // set up the linear solver and kernels used by Run
+  linearSolver_t linearSolver;
+  elliptic.RunSetup(linearSolver);
+
+  if (comm.rank()==0)
+    std::cout << "Kernel cache warmed in " << platform.getCacheDir() << std::endl;
+}
+
+int main(int argc, char **argv){
+
+  // start up MPI
+  Comm::Init(argc, argv);
+
+  LIBP_ABORT("Usage: ./warmcacheMain solver setupfile", argc!=3);
+
+  { /*Scope so everything is destructed before MPI_Finalize */
+    comm_t comm(Comm::World().Dup());
+
+    std::string solver(argv[1]);
+    const char* setupFile = argv[2];
+
+    if (solver=="acoustics") {
+      WarmCache<acoustics_t, acousticsSettings_t>(comm, setupFile);
+    } else if (solver=="advection") {
+      WarmCache<advection_t, advectionSettings_t>(comm, setupFile);
+    } else if (solver=="bns") {
+      WarmCache<bns_t, bnsSettings_t>(comm, setupFile);
+    } else if (solver=="cns") {
+      WarmCache<cns_t, cnsSettings_t>(comm, setupFile);
+    } else if (solver=="elliptic") {
+      WarmCacheElliptic(comm, setupFile);
+    } else if (solver=="fokkerPlanck") {
+      WarmCache<fpe_t, fpeSettings_t>(comm, setupFile);
+    } else if (solver=="gradient") {
+      WarmCache<gradient_t, gradientSettings_t>(comm, setupFile);
+    } else if (solver=="ins") {
+      WarmCache<ins_t, insSettings_t>(comm, setupFile);
+    } else if (solver=="lbs") {
+      WarmCache<lbs_t, lbsSettings_t>(comm, setupFile);
+    } else {
+      LIBP_FORCE_ABORT("Unknown solver \"" << solver << "\"");
+    }
+  }
+
+  // close down MPI
+  Comm::Finalize();
+  return LIBP_SUCCESS;
+}
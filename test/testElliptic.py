@@ -37,12 +37,15 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
                      Lambda=1.0,
                      discretization="CONTINUOUS",
                      linear_solver="PCG",
+                     pipepcg_residual_replacement=0,
+                     sstepcg_basis="CHEBYSHEV",
                      precon="MULTIGRID",
                      multigrid_smoother="CHEBYSHEV",
                      paralmond_cycle="VCYCLE",
                      paralmond_strength="SYMMETRIC",
                      paralmond_aggregation="UNSMOOTHED",
                      paralmond_smoother="CHEBYSHEV",
+                     ax_variant=0,
                      output_to_file="FALSE"):
   return [setting_t("FORMAT", rcformat),
           setting_t("DATA FILE", data_file),
@@ -62,12 +65,15 @@ def ellipticSettings(rcformat="2.0", data_file=ellipticData2D,
           setting_t("DEVICE NUMBER", device_number),
           setting_t("DISCRETIZATION", discretization),
           setting_t("LINEAR SOLVER", linear_solver),
+          setting_t("PIPEPCG RESIDUAL REPLACEMENT", pipepcg_residual_replacement),
+          setting_t("SSTEPCG BASIS", sstepcg_basis),
           setting_t("PRECONDITIONER", precon),
           setting_t("MULTIGRID SMOOTHER", multigrid_smoother),
           setting_t("PARALMOND CYCLE", paralmond_cycle),
           setting_t("PARALMOND STRENGTH", paralmond_strength),
           setting_t("PARALMOND AGGREGATION", paralmond_aggregation),
           setting_t("PARALMOND SMOOTHER", paralmond_smoother),
+          setting_t("AX KERNEL VARIANT", ax_variant),
           setting_t("OUTPUT TO FILE", "FALSE"),
           setting_t("VERBOSE", output_to_file)]
 
@@ -97,6 +103,14 @@ def main():
                     settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE"),
                     referenceNorm=0.353553390458384)
 
+  #Hex Ax kernel variants
+  for variant in [1, 3, 4, 5, 6]:
+    failCount += test(name="testEllipticHex_C0_AxVariant" + str(variant),
+                      cmd=ellipticBin,
+                      settings=ellipticSettings(element=12,data_file=ellipticData3D,dim=3, precon="NONE",
+                                                ax_variant=variant),
+                      referenceNorm=0.353553390458384)
+
   failCount += test(name="testEllipticQuad3D_C0",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=4,data_file=ellipticData3D,mesh="sphereQuad.msh", dim=3, precon="NONE"),
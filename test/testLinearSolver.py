@@ -56,6 +56,33 @@ def main():
                                               precon="NONE", linear_solver="NBFPCG"),
                     referenceNorm=0.500000001211135)
 
+  failCount += test(name="testLinearSolver_PIPEPCG",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="PIPEPCG"),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testLinearSolver_PIPEPCG_ResidualReplacement",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="PIPEPCG",
+                                              pipepcg_residual_replacement=10),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testLinearSolver_SSTEPCG_Chebyshev",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="SSTEPCG",
+                                              sstepcg_basis="CHEBYSHEV"),
+                    referenceNorm=0.500000001211135)
+
+  failCount += test(name="testLinearSolver_SSTEPCG_Monomial",
+                    cmd=ellipticBin,
+                    settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,
+                                              precon="NONE", linear_solver="SSTEPCG",
+                                              sstepcg_basis="MONOMIAL"),
+                    referenceNorm=0.500000001211135)
+
   failCount += test(name="testLinearSolver_PGMRES",
                     cmd=ellipticBin,
                     settings=ellipticSettings(element=3,data_file=ellipticData2D,dim=2,